@@ -56,4 +56,6 @@ public:
     void swap(Queue &other);
 };
 
+#include "queue.ipp"
+
 #endif
\ No newline at end of file
@@ -1,4 +1,5 @@
-#include "queue.hpp"
+// Определения шаблонных методов Queue. Подключается в конце queue.hpp,
+// отдельно не включать
 
 template <class T>
 Queue<T>::Queue() = default;
@@ -75,5 +76,5 @@ T Queue<T>::pop()
 template <class T>
 void Queue<T>::swap(Queue &other)
 {
-    data_.swap(other.a);
+    data_.swap(other.data_);
 }
\ No newline at end of file
@@ -1,3 +1,8 @@
+#include "queue.hpp"
+
+// Явная инстанциация проверяет, что все методы Queue компилируются
+template class Queue<int>;
+
 int main() {
   return 0;
 }
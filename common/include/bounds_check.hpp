@@ -0,0 +1,39 @@
+#ifndef BOUNDS_CHECK_H
+#define BOUNDS_CHECK_H
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+
+// Политики проверки индекса для operator[] контейнеров (Vector, List).
+// Выбираются параметром шаблона, например для release-сборки:
+// Vector<float, std::allocator<float>, bounds_check::Unchecked> v;
+// at() проверяет индекс всегда, независимо от политики.
+namespace bounds_check {
+
+// Выход за границы бросает std::out_of_range
+struct Checked {
+  static void check(std::size_t index, std::size_t size) {
+    if (index >= size) {
+      throw std::out_of_range("error");
+    }
+  }
+};
+
+// Проверка через assert: только в debug-сборке (без NDEBUG)
+struct DebugAssert {
+  static void check([[maybe_unused]] std::size_t index,
+                    [[maybe_unused]] std::size_t size) {
+    assert(index < size && "index out of range");
+  }
+};
+
+// Без проверки
+struct Unchecked {
+  static void check(std::size_t, std::size_t) {}
+};
+
+} // namespace bounds_check
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// Общие части бинарного формата снимков (save/load) контейнеров.
+//
+// Снимок начинается с заголовка Header: 4 байта сигнатуры контейнера,
+// версия формата и размеры типов элементов. Дальше идут данные в формате,
+// который определяет сам контейнер. Числа пишутся в порядке байтов текущей
+// машины, поэтому снимок переносим только между машинами с одинаковым
+// порядком байтов и одинаковыми типами.
+//
+// Любое несоответствие (чужая сигнатура, другая версия, обрезанный поток)
+// бросает snapshot::Error.
+namespace snapshot {
+
+class Error : public std::runtime_error {
+public:
+  using std::runtime_error::runtime_error;
+};
+
+inline constexpr std::uint32_t version = 1;
+
+struct Header {
+  char magic[4];
+  std::uint32_t version;
+  std::uint32_t key_size;
+  std::uint32_t value_size;
+};
+
+// Пишет size байт из data, бросает snapshot::Error если поток сломался.
+// Работает прямо с буфером потока (sputn/sgetn): os.write на каждое поле
+// каждый раз создает sentry и заметно медленнее на миллионах мелких полей
+inline void write_bytes(std::ostream &os, const void *data, std::size_t size) {
+  auto n = static_cast<std::streamsize>(size);
+  if (!os.good() || os.rdbuf()->sputn(static_cast<const char *>(data), n) != n) {
+    os.setstate(std::ios::badbit);
+    throw Error("snapshot: write failed");
+  }
+}
+
+inline void read_bytes(std::istream &is, void *data, std::size_t size) {
+  auto n = static_cast<std::streamsize>(size);
+  if (!is.good() || is.rdbuf()->sgetn(static_cast<char *>(data), n) != n) {
+    is.setstate(std::ios::eofbit | std::ios::failbit);
+    throw Error("snapshot: unexpected end of stream");
+  }
+}
+
+// Бросает snapshot::Error, если в остатке потока не поместятся count
+// записей хотя бы по min_bytes байт: размеры из испорченного заголовка не
+// должны приводить к огромным выделениям памяти. Если поток не позволяет
+// узнать свою длину (не поддерживает seek), проверки нет
+inline void check_count(std::istream &is, std::uint64_t count, std::uint64_t min_bytes) {
+  std::streambuf *buf = is.rdbuf();
+  const auto pos = buf->pubseekoff(0, std::ios::cur, std::ios::in);
+  if (pos == std::streampos(-1)) {
+    return;
+  }
+  const auto end = buf->pubseekoff(0, std::ios::end, std::ios::in);
+  buf->pubseekpos(pos, std::ios::in);
+  if (end == std::streampos(-1)) {
+    return;
+  }
+  const auto remaining = static_cast<std::uint64_t>(end - pos);
+  if (count > remaining / min_bytes) {
+    throw Error("snapshot: size exceeds stream length");
+  }
+}
+
+// Значение trivially copyable типа пишется как есть, строка - как длина и
+// символы. Для других типов нужна своя перегрузка write/read
+template <class T, class = std::enable_if_t<std::is_trivially_copyable_v<T>>>
+void write(std::ostream &os, const T &value) {
+  write_bytes(os, &value, sizeof(T));
+}
+
+template <class T, class = std::enable_if_t<std::is_trivially_copyable_v<T>>>
+void read(std::istream &is, T &value) {
+  read_bytes(is, &value, sizeof(T));
+}
+
+template <class Char, class Traits, class Allocator>
+void write(std::ostream &os, const std::basic_string<Char, Traits, Allocator> &value) {
+  write(os, static_cast<std::uint64_t>(value.size()));
+  write_bytes(os, value.data(), value.size() * sizeof(Char));
+}
+
+template <class Char, class Traits, class Allocator>
+void read(std::istream &is, std::basic_string<Char, Traits, Allocator> &value) {
+  std::uint64_t size = 0;
+  read(is, size);
+  check_count(is, size, sizeof(Char));
+  value.resize(size);
+  read_bytes(is, value.data(), size * sizeof(Char));
+}
+
+// Пишет заголовок. key_size/value_size - sizeof типов, чтобы не загрузить
+// снимок контейнера с другими типами
+inline void write_header(std::ostream &os, const char (&magic)[5], std::uint32_t key_size,
+                         std::uint32_t value_size) {
+  Header header{};
+  std::memcpy(header.magic, magic, 4);
+  header.version = version;
+  header.key_size = key_size;
+  header.value_size = value_size;
+  write(os, header);
+}
+
+// Читает и проверяет заголовок
+inline void read_header(std::istream &is, const char (&magic)[5], std::uint32_t key_size,
+                        std::uint32_t value_size) {
+  Header header{};
+  read(is, header);
+  if (std::memcmp(header.magic, magic, 4) != 0) {
+    throw Error("snapshot: wrong container signature");
+  }
+  if (header.version != version) {
+    throw Error("snapshot: unsupported version " + std::to_string(header.version));
+  }
+  if (header.key_size != key_size || header.value_size != value_size) {
+    throw Error("snapshot: element types do not match");
+  }
+}
+
+} // namespace snapshot
+
+#endif
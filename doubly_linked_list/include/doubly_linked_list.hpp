@@ -1,34 +1,71 @@
 #ifndef DOUBLY_LINKED_LIST_H
 #define DOUBLY_LINKED_LIST_H
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 
-template <class T> 
+#include "bounds_check.hpp"
+
+// Allocator - аллокатор элементов (по умолчанию std::allocator<T>). Узлы
+// выделяются через него же (rebind на Node).
+// BoundsCheck - проверка индекса в operator[] (см. bounds_check.hpp)
+template <class T, class Allocator = std::allocator<T>,
+          class BoundsCheck = bounds_check::Checked>
 class List {
 
   struct Node {
     Node *prev;
     T value;
     Node *next;
+
+    Node(Node *prev, const T &value, Node *next)
+        : prev{prev}, value{value}, next{next} {}
+    Node(Node *prev, T &&value, Node *next)
+        : prev{prev}, value{std::move(value)}, next{next} {}
   };
 
+  using NodeAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+  NodeAllocator alloc_;
   std::size_t size_{};
   Node *head_ = nullptr;
   Node *tail_ = nullptr;
 
+  // Выделяет и создает узел через аллокатор
+  template <class Value>
+  Node *create_node(Node *prev, Value &&value, Node *next);
+  // Уничтожает узел и возвращает память аллокатору
+  void destroy_node(Node *node);
+  // Добавляет созданный узел в конец списка
+  void link_back(Node *node);
+  // Обменивается с other узлами, но не аллокаторами
+  void swap_nodes(List &other) noexcept;
+
+  Node *node_at(std::size_t index) const;
+
 public:
   class Iterator;
   class ConstIterator;
 
-  List(std::size_t count = 0);
+  using allocator_type = Allocator;
+
+  List(std::size_t count = 0, const Allocator &alloc = Allocator());
+  explicit List(const Allocator &alloc);
 
   List(const List &other);
+  List(const List &other, const Allocator &alloc);
   List(List &&other);
+  List(List &&other, const Allocator &alloc);
 
   List &operator=(const List &other);
   List &operator=(List &&other);
 
   ~List();
 
+  Allocator get_allocator() const;
+
   std::size_t size();
   bool empty();
 
@@ -40,10 +77,13 @@ public:
 
   Iterator end();
 
-  T operator[](std::size_t index) const;
+  const T &operator[](std::size_t index) const;
   T &operator[](std::size_t index);
+  const T &at(std::size_t index) const;
+  T &at(std::size_t index);
 
   void push_back(const T &x);
+  void push_back(T &&x);
   void push_front(const T &x);
   T pop_back();
   T pop_front();
@@ -124,4 +164,6 @@ public:
   };
 };
 
+#include "doubly_linked_list.ipp"
+
 #endif
\ No newline at end of file
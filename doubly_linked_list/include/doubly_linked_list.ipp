@@ -0,0 +1,316 @@
+// Определения шаблонных методов List. Подключается в конце doubly_linked_list.hpp,
+// отдельно не включать
+
+  // Создает список размера count заполненный дефолтными значениями типа T
+template <class T, class Allocator, class BoundsCheck>
+template <class Value>
+typename List<T, Allocator, BoundsCheck>::Node *
+List<T, Allocator, BoundsCheck>::create_node(Node *prev, Value &&value, Node *next) {
+    Node *node = NodeTraits::allocate(alloc_, 1);
+    try {
+      NodeTraits::construct(alloc_, node, prev, std::forward<Value>(value), next);
+    } catch (...) {
+      NodeTraits::deallocate(alloc_, node, 1);
+      throw;
+    }
+    return node;
+  }
+
+template <class T, class Allocator, class BoundsCheck>
+void List<T, Allocator, BoundsCheck>::destroy_node(Node *node) {
+    NodeTraits::destroy(alloc_, node);
+    NodeTraits::deallocate(alloc_, node, 1);
+  }
+
+template <class T, class Allocator, class BoundsCheck>
+void List<T, Allocator, BoundsCheck>::link_back(Node *node) {
+    if (size_ == 0) {
+      head_ = node;
+    } else {
+      node->prev = tail_;
+      tail_->next = node;
+    }
+    tail_ = node;
+    ++size_;
+  }
+
+template <class T, class Allocator, class BoundsCheck>
+void List<T, Allocator, BoundsCheck>::swap_nodes(List &other) noexcept {
+    std::swap(size_, other.size_);
+    std::swap(head_, other.head_);
+    std::swap(tail_, other.tail_);
+  }
+
+template <class T, class Allocator, class BoundsCheck>
+List<T, Allocator, BoundsCheck>::List(std::size_t count, const Allocator &alloc) : alloc_{alloc} {
+    while (count) {
+      push_back(T{});
+      --count;
+    }
+  }
+
+  // Создает пустой список, память которого выделяет alloc
+template <class T, class Allocator, class BoundsCheck>
+List<T, Allocator, BoundsCheck>::List(const Allocator &alloc) : alloc_{alloc} {}
+
+  // Создает новый список, являющийся глубокой копией списка other [O(n)]
+  template <class T, class Allocator, class BoundsCheck>
+List<T, Allocator, BoundsCheck>::List(const List &other)
+    : List(other, Allocator(NodeTraits::select_on_container_copy_construction(other.alloc_))) {}
+
+  // То же, но узлы копии выделяет alloc [O(n)]
+  template <class T, class Allocator, class BoundsCheck>
+List<T, Allocator, BoundsCheck>::List(const List &other, const Allocator &alloc) : List(alloc) {
+    for (const auto &x : other) {
+      push_back(x);
+    }
+  }
+
+template <class T, class Allocator, class BoundsCheck>
+List<T, Allocator, BoundsCheck>::List(List &&other) : alloc_{std::move(other.alloc_)} {
+    swap_nodes(other);
+  }
+
+  // Перемещает other в список с аллокатором alloc. Узлы other можно забрать,
+  // только если alloc равен его аллокатору; иначе элементы по одному
+  // перемещаются в новые узлы от alloc [O(1) или O(n)]
+template <class T, class Allocator, class BoundsCheck>
+List<T, Allocator, BoundsCheck>::List(List &&other, const Allocator &alloc) : List(alloc) {
+    if (NodeTraits::is_always_equal::value || alloc_ == other.alloc_) {
+      swap_nodes(other);
+      return;
+    }
+    for (Node *node = other.head_; node; node = node->next) {
+      push_back(std::move(node->value));
+    }
+  }
+
+  // Перезаписывает текущий список списком other
+  // List l1{5}, l2{10};
+  // l1 = l2;
+  // std::cout << l1.size() == 10 << std::endl // True
+  // Аллокатор other переходит сюда, только если этого требует
+  // propagate_on_container_copy_assignment, иначе остается свой
+  template <class T, class Allocator, class BoundsCheck>
+ inline List<T, Allocator, BoundsCheck> &List<T, Allocator, BoundsCheck>::operator=(const List<T, Allocator, BoundsCheck> &other){
+    constexpr bool propagate = NodeTraits::propagate_on_container_copy_assignment::value;
+    List tmp{other, Allocator(propagate ? other.alloc_ : alloc_)};
+    swap_nodes(tmp);
+    if constexpr (propagate) {
+      std::swap(alloc_, tmp.alloc_);
+    }
+
+    return *this;
+    // tmp.~List() очистит то, что было в текущем списке раньше.
+  }
+
+  // Аллокатор other переходит сюда вместе с узлами, только если этого
+  // требует propagate_on_container_move_assignment. Иначе остается свой, и
+  // при неравных аллокаторах элементы перемещаются по одному
+template <class T, class Allocator, class BoundsCheck>
+List<T, Allocator, BoundsCheck> &List<T, Allocator, BoundsCheck>::operator=(List<T, Allocator, BoundsCheck> &&other) {
+    if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+      List tmp{std::move(other)};
+      swap_nodes(tmp);
+      std::swap(alloc_, tmp.alloc_);
+    } else {
+      List tmp{std::move(other), Allocator(alloc_)};
+      swap_nodes(tmp);
+    }
+
+    return *this;
+  }
+
+  // Очищает память списка [O(n)]
+  template <class T, class Allocator, class BoundsCheck>
+List<T, Allocator, BoundsCheck>::~List() {
+    while (size_) {
+      pop_front();
+    }
+  }
+
+  template <class T, class Allocator, class BoundsCheck>
+  Allocator List<T, Allocator, BoundsCheck>::get_allocator() const { return Allocator(alloc_); }
+
+  // Возвращает размер списка (сколько памяти уже занято)
+  template <class T, class Allocator, class BoundsCheck>
+  std::size_t List<T, Allocator, BoundsCheck>::size() { return size_; }
+
+  // Проверяет является ли контейнер пустым
+  template <class T, class Allocator, class BoundsCheck>
+  bool List<T, Allocator, BoundsCheck>::empty() { return size_; }
+
+  // Возвращает итератор на первый элемент
+template <class T, class Allocator, class BoundsCheck>
+typename List<T, Allocator, BoundsCheck>::ConstIterator List<T, Allocator, BoundsCheck>::begin() const { return ConstIterator{head_}; }
+
+  // Возвращает итератор обозначающий конец контейнера
+  template <class T, class Allocator, class BoundsCheck>
+typename List<T, Allocator, BoundsCheck>::ConstIterator List<T, Allocator, BoundsCheck>::end() const { return ConstIterator{nullptr}; }
+
+template <class T, class Allocator, class BoundsCheck>
+typename List<T, Allocator, BoundsCheck>::Iterator List<T, Allocator, BoundsCheck>::begin() { return Iterator{head_}; }
+
+  // Возвращает итератор обозначающий конец контейнера
+  template <class T, class Allocator, class BoundsCheck>
+  typename List<T, Allocator, BoundsCheck>::Iterator List<T, Allocator, BoundsCheck>::end() { return Iterator{nullptr}; }
+
+  // Возвращает узел с индексом index (index < size_). Идет с того конца
+  // списка, который ближе [O(n)]
+  template <class T, class Allocator, class BoundsCheck>
+  typename List<T, Allocator, BoundsCheck>::Node *
+  List<T, Allocator, BoundsCheck>::node_at(std::size_t index) const {
+    if (index < size_ / 2) {
+      Node *current = head_;
+      for (; index; --index) {
+        current = current->next;
+      }
+      return current;
+    }
+    Node *current = tail_;
+    for (index = size_ - 1 - index; index; --index) {
+      current = current->prev;
+    }
+    return current;
+  }
+
+  // Возвращает ссылку на элемент по индексу. Проверка индекса задается
+  // политикой BoundsCheck (по умолчанию бросает std::out_of_range)
+  template <class T, class Allocator, class BoundsCheck>
+  const T &List<T, Allocator, BoundsCheck>::operator[](std::size_t index) const {
+    BoundsCheck::check(index, size_);
+    return node_at(index)->value;
+  }
+
+  // Возвращает ссылку на элемент по индексу (позволяет менять элемент, типа
+  // v[5] = 42;)
+  template <class T, class Allocator, class BoundsCheck>
+  T &List<T, Allocator, BoundsCheck>::operator[](size_t index){
+    BoundsCheck::check(index, size_);
+    return node_at(index)->value;
+  }
+
+  // Возвращает ссылку на элемент по индексу. Индекс проверяется всегда,
+  // при выходе за границы бросает std::out_of_range
+  template <class T, class Allocator, class BoundsCheck>
+  const T &List<T, Allocator, BoundsCheck>::at(std::size_t index) const {
+    bounds_check::Checked::check(index, size_);
+    return node_at(index)->value;
+  }
+
+  template <class T, class Allocator, class BoundsCheck>
+  T &List<T, Allocator, BoundsCheck>::at(std::size_t index) {
+    bounds_check::Checked::check(index, size_);
+    return node_at(index)->value;
+  }
+
+  // Добавляет элемент в конец списока.
+  template <class T, class Allocator, class BoundsCheck>
+  void List<T, Allocator, BoundsCheck>::push_back(const T &x) {
+    link_back(create_node(nullptr, x, nullptr));
+  }
+
+  // Добавляет элемент в конец списка, перемещая его
+  template <class T, class Allocator, class BoundsCheck>
+  void List<T, Allocator, BoundsCheck>::push_back(T &&x) {
+    link_back(create_node(nullptr, std::move(x), nullptr));
+  }
+
+  // Добавляет элемент в начало списока.
+  template <class T, class Allocator, class BoundsCheck>
+  void List<T, Allocator, BoundsCheck>::push_front(const T &x) {
+
+    Node *tmp = create_node(nullptr, x, nullptr);
+    if (size_ == 0) {
+      tail_ = tmp;
+    } else {
+      tmp->next = head_;
+      head_->prev = tmp;
+    }
+    head_ = tmp;
+    ++size_;
+  }
+
+  // Удаляет последний элемент списка.
+  template <class T, class Allocator, class BoundsCheck>
+  T List<T, Allocator, BoundsCheck>::pop_back() {
+    if (size_ == 0)
+      throw std::runtime_error("you can't pop");
+
+    T poped_value = tail_->value;
+    Node *point = tail_;
+
+    if (size_ == 1) {
+      head_ = nullptr;
+      tail_ = nullptr;
+    } else {
+      tail_ = tail_->prev;
+      tail_->next = nullptr;
+    }
+    destroy_node(point);
+    --size_;
+    return poped_value;
+  }
+
+  // Удаляет первый элемент списока.
+  template <class T, class Allocator, class BoundsCheck>
+  T List<T, Allocator, BoundsCheck>::pop_front() {
+    if (size_ == 0)
+      throw std::runtime_error("you can't pop");
+
+    T poped_value = head_->value;
+    Node *point = head_;
+
+    if (size_ == 1) {
+      head_ = nullptr;
+      tail_ = nullptr;
+    } else {
+      head_ = head_->next;
+      head_->prev = nullptr;
+    }
+    destroy_node(point);
+    --size_;
+    return poped_value;
+  }
+
+  // Вставляет новый элемент value перед элементом, на который указывает it.
+  //     it
+  //     v
+  // [1, 2, 3].insert(it, 42) -> [1, 42, 2, 3]
+  template <class T, class Allocator, class BoundsCheck>
+  void List<T, Allocator, BoundsCheck>::insert(Iterator it, T value) {
+    if (it.ptr == head_) {
+      push_front(value);
+      return;
+    } else if (it.ptr == nullptr) {
+      push_back(value);
+      return;
+    }
+    Node *tmp = create_node(it.ptr->prev, value, it.ptr);
+    it.ptr->prev->next = tmp;
+    it.ptr->prev = tmp;
+    ++size_;
+  }
+
+  //     it
+  //     v
+  // [1, 2, 3].erase(1) -> [1, 3] (return 2)
+  template <class T, class Allocator, class BoundsCheck>
+  T List<T, Allocator, BoundsCheck>::erase(Iterator it) {
+
+    if (it.ptr == head_) {
+      return pop_front();
+    } else if (it.ptr == tail_) {
+      return pop_back();
+    } else if (it.ptr == nullptr) {
+      throw std::out_of_range("cant be erased");
+    }
+
+    T res = it.ptr->value;
+    it.ptr->next->prev = it.ptr->prev;
+    it.ptr->prev->next = it.ptr->next;
+
+    destroy_node(it.ptr);
+    --size_;
+    return res;
+  }
@@ -1 +1,6 @@
+#include "doubly_linked_list.hpp"
+
+// Явная инстанциация проверяет, что все методы List компилируются
+template class List<int>;
+
 int main() { return 0; }
\ No newline at end of file
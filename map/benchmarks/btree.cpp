@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "btree_map.hpp"
+#include "map.hpp"
+
+// BTreeMap против Map (красно-черное дерево) и std::map на count случайных
+// ключах uint64: вставка, поиск всех ключей в другом случайном порядке и
+// полный обход по порядку. BTreeMap - с узлами 256 байт (4 кеш-линии),
+// 1 КБ (по умолчанию) и 4 КБ (страница).
+// ./bench_btree [count]
+namespace {
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+template <class Container>
+void run(const char *name, const std::vector<std::uint64_t> &keys,
+         const std::vector<std::uint64_t> &lookups) {
+  const double count = static_cast<double>(keys.size());
+  Container map;
+  double insert_ms = measure_ms([&] {
+    for (std::uint64_t key : keys) {
+      map[key] = key;
+    }
+  });
+  std::uint64_t found = 0;
+  double lookup_ms = measure_ms([&] {
+    for (std::uint64_t key : lookups) {
+      found += (*map.find(key)).second;
+    }
+  });
+  std::uint64_t scanned = 0;
+  double scan_ms = measure_ms([&] {
+    for (auto it = map.begin(); it != map.end(); ++it) {
+      scanned += (*it).second;
+    }
+  });
+  std::cout << name << ": insert " << insert_ms * 1e6 / count << " ns/key, lookup "
+            << lookup_ms * 1e6 / count << " ns/key, scan " << scan_ms << " ms ("
+            << scan_ms * 1e6 / count << " ns/key) [" << (found == scanned) << "]"
+            << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  std::mt19937_64 random(1);
+  std::vector<std::uint64_t> keys(count);
+  for (auto &key : keys) {
+    key = random();
+  }
+  std::vector<std::uint64_t> lookups = keys;
+  std::shuffle(lookups.begin(), lookups.end(), random);
+  std::cout << count << " random uint64 keys" << std::endl;
+
+  run<BTreeMap<std::uint64_t, std::uint64_t, 256>>("BTreeMap<256>", keys, lookups);
+  run<BTreeMap<std::uint64_t, std::uint64_t>>("BTreeMap<1024>", keys, lookups);
+  run<BTreeMap<std::uint64_t, std::uint64_t, 4096>>("BTreeMap<4096>", keys, lookups);
+  run<Map<std::uint64_t, std::uint64_t>>("Map", keys, lookups);
+  run<std::map<std::uint64_t, std::uint64_t>>("std::map", keys, lookups);
+  return 0;
+}
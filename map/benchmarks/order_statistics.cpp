@@ -0,0 +1,111 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "map.hpp"
+
+// Перцентили по живому Map из count случайных ключей (задержки запросов):
+//  - вставка в Map и в Map с OrderStatistics (цена размеров поддеревьев);
+//  - size() за O(1) против прежнего std::distance(begin(), end());
+//  - queries запросов nth(k) и rank(key) против прохода std::next от
+//    begin() до k-го элемента (его - всего на нескольких перцентилях).
+// ./bench_order_statistics [count] [queries]
+namespace {
+
+using Plain = Map<std::uint64_t, std::uint64_t>;
+using Stat = Map<std::uint64_t, std::uint64_t,
+                 std::allocator<std::pair<const std::uint64_t, std::uint64_t>>, true>;
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+template <class Container>
+double fill(Container &map, const std::vector<std::uint64_t> &keys) {
+  return measure_ms([&] {
+    for (std::uint64_t key : keys) {
+      map[key] = key;
+    }
+  });
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  std::size_t queries = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+  std::mt19937_64 random(1);
+  std::vector<std::uint64_t> keys(count);
+  for (auto &key : keys) {
+    key = random() % 1000000000;
+  }
+  const double n = static_cast<double>(count);
+
+  {
+    Plain plain;
+    double ms = fill(plain, keys);
+    std::cout << "Map insert: " << ms * 1e6 / n << " ns/key" << std::endl;
+  }
+  Stat map;
+  double ms = fill(map, keys);
+  std::cout << "Map<..., true> insert: " << ms * 1e6 / n << " ns/key, " << map.size()
+            << " keys" << std::endl;
+
+  // volatile - чтобы вызов size() не вынесло из цикла
+  volatile std::size_t sink = 0;
+  ms = measure_ms([&] {
+    for (std::size_t i = 0; i < queries; i++) {
+      sink = map.size();
+    }
+  });
+  std::cout << "size(): " << ms * 1e6 / static_cast<double>(queries) << " ns" << std::endl;
+  ms = measure_ms([&] { sink = static_cast<std::size_t>(std::distance(map.begin(), map.end())); });
+  std::cout << "std::distance(begin(), end()): " << ms << " ms" << std::endl;
+
+  std::vector<std::size_t> ranks(queries);
+  for (auto &k : ranks) {
+    k = random() % map.size();
+  }
+  std::uint64_t checksum = 0;
+  ms = measure_ms([&] {
+    for (std::size_t k : ranks) {
+      checksum += (*map.nth(k)).first;
+    }
+  });
+  std::cout << "nth(k): " << ms * 1e6 / static_cast<double>(queries) << " ns/query"
+            << std::endl;
+  ms = measure_ms([&] {
+    for (std::size_t i = 0; i < queries; i++) {
+      checksum += map.rank(keys[i % count]);
+    }
+  });
+  std::cout << "rank(key): " << ms * 1e6 / static_cast<double>(queries) << " ns/query"
+            << std::endl;
+
+  const double percentiles[] = {0.5, 0.9, 0.99, 0.999};
+  ms = measure_ms([&] {
+    for (double p : percentiles) {
+      auto it = map.begin();
+      std::advance(it, static_cast<std::size_t>(p * static_cast<double>(map.size())));
+      checksum += (*it).first;
+    }
+  });
+  std::cout << "std::next from begin() (p50, p90, p99, p99.9): " << ms / 4 << " ms/query ["
+            << checksum << "]" << std::endl;
+
+  for (double p : percentiles) {
+    std::cout << "p" << p * 100 << " = "
+              << (*map.nth(static_cast<std::size_t>(p * static_cast<double>(map.size())))).first
+              << std::endl;
+  }
+  return 0;
+}
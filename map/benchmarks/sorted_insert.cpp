@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "map.hpp"
+
+// Ключи приходят по возрастанию (время, номера): вставка count ключей,
+// высота дерева и поиск всех ключей в случайном порядке для Map
+// (красно-черное дерево) и std::map. Для сравнения - прежняя вставка без
+// балансировки (копия старого Map::push): дерево вырождается в список
+// высоты n, поэтому она меряется на меньшем unbalanced_count ключей.
+// ./bench_sorted_insert [count] [unbalanced_count]
+namespace {
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+// Двоичное дерево поиска без балансировки, как Map до красно-черного
+class UnbalancedTree {
+  struct Node {
+    Node *left{nullptr};
+    Node *right{nullptr};
+    std::uint64_t key;
+    std::uint64_t value;
+  };
+  Node *root{nullptr};
+
+public:
+  ~UnbalancedTree() {
+    std::vector<Node *> pending;
+    if (root) {
+      pending.push_back(root);
+    }
+    while (!pending.empty()) {
+      Node *node = pending.back();
+      pending.pop_back();
+      if (node->left) {
+        pending.push_back(node->left);
+      }
+      if (node->right) {
+        pending.push_back(node->right);
+      }
+      delete node;
+    }
+  }
+
+  void insert(std::uint64_t key, std::uint64_t value) {
+    Node **slot = &root;
+    while (*slot) {
+      slot = key < (*slot)->key ? &(*slot)->left : &(*slot)->right;
+    }
+    *slot = new Node{nullptr, nullptr, key, value};
+  }
+
+  const std::uint64_t *find(std::uint64_t key) const {
+    for (Node *node = root; node;) {
+      if (key == node->key) {
+        return &node->value;
+      }
+      node = key < node->key ? node->left : node->right;
+    }
+    return nullptr;
+  }
+
+  std::size_t height() const {
+    std::size_t result = 0;
+    std::vector<std::pair<Node *, std::size_t>> pending;
+    if (root) {
+      pending.push_back({root, 1});
+    }
+    while (!pending.empty()) {
+      auto [node, depth] = pending.back();
+      pending.pop_back();
+      result = std::max(result, depth);
+      if (node->left) {
+        pending.push_back({node->left, depth + 1});
+      }
+      if (node->right) {
+        pending.push_back({node->right, depth + 1});
+      }
+    }
+    return result;
+  }
+};
+
+void report(const char *name, std::size_t count, double insert_ms, std::size_t height,
+            double lookup_ms, std::uint64_t checksum) {
+  const double n = static_cast<double>(count);
+  std::cout << name << " (" << count << " keys): insert " << insert_ms << " ms ("
+            << insert_ms * 1e6 / n << " ns/key)";
+  // Высоту std::map снаружи не узнать
+  if (height > 0) {
+    std::cout << ", height " << height;
+  }
+  std::cout << ", lookup " << lookup_ms * 1e6 / n << " ns/key [" << checksum << "]" << std::endl;
+}
+
+std::vector<std::uint64_t> shuffled(std::size_t count) {
+  std::vector<std::uint64_t> keys(count);
+  for (std::size_t i = 0; i < count; i++) {
+    keys[i] = i;
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937_64(1));
+  return keys;
+}
+
+void run_map(std::size_t count) {
+  auto lookups = shuffled(count);
+  Map<std::uint64_t, std::uint64_t> map;
+  double insert_ms = measure_ms([&] {
+    for (std::uint64_t i = 0; i < count; i++) {
+      map[i] = i;
+    }
+  });
+  std::uint64_t checksum = 0;
+  double lookup_ms = measure_ms([&] {
+    for (std::uint64_t key : lookups) {
+      checksum += (*map.find(key)).second;
+    }
+  });
+  report("Map", count, insert_ms, map.height(), lookup_ms, checksum);
+}
+
+void run_std_map(std::size_t count) {
+  auto lookups = shuffled(count);
+  std::map<std::uint64_t, std::uint64_t> map;
+  double insert_ms = measure_ms([&] {
+    for (std::uint64_t i = 0; i < count; i++) {
+      map[i] = i;
+    }
+  });
+  std::uint64_t checksum = 0;
+  double lookup_ms = measure_ms([&] {
+    for (std::uint64_t key : lookups) {
+      checksum += map.find(key)->second;
+    }
+  });
+  report("std::map", count, insert_ms, 0, lookup_ms, checksum);
+}
+
+void run_unbalanced(std::size_t count) {
+  auto lookups = shuffled(count);
+  UnbalancedTree tree;
+  double insert_ms = measure_ms([&] {
+    for (std::uint64_t i = 0; i < count; i++) {
+      tree.insert(i, i);
+    }
+  });
+  std::uint64_t checksum = 0;
+  double lookup_ms = measure_ms([&] {
+    for (std::uint64_t key : lookups) {
+      checksum += *tree.find(key);
+    }
+  });
+  report("unbalanced", count, insert_ms, tree.height(), lookup_ms, checksum);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  std::size_t unbalanced_count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000;
+  run_map(count);
+  run_std_map(count);
+  run_map(unbalanced_count);
+  run_unbalanced(unbalanced_count);
+  return 0;
+}
@@ -0,0 +1,88 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "map.hpp"
+
+// Загрузка индекса из отсортированного снимка count пар:
+//  - operator[] на каждую пару (прежний способ);
+//  - Map::from_sorted - сбалансированное дерево снизу вверх за O(n);
+//  - std::map::emplace_hint(end()) для сравнения.
+// После загрузки - queries поисков случайных ключей и высота дерева.
+// Словари строятся по очереди: 50M узлов занимают около 3 ГБ.
+// ./bench_sorted_load [count] [queries]
+namespace {
+
+using Pairs = std::vector<std::pair<std::uint64_t, std::uint64_t>>;
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+template <class Container>
+void report(const char *name, double ms, const Container &map, const Pairs &pairs,
+            const std::vector<std::size_t> &probes) {
+  std::uint64_t checksum = 0;
+  double find_ms = measure_ms([&] {
+    for (std::size_t i : probes) {
+      checksum += (*map.find(pairs[i].first)).second;
+    }
+  });
+  std::cout << name << ": " << ms << " ms (" << ms * 1e6 / static_cast<double>(pairs.size())
+            << " ns/pair), find " << find_ms * 1e6 / static_cast<double>(probes.size())
+            << " ns [" << checksum << "]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50000000;
+  std::size_t queries = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+  Pairs pairs(count);
+  for (std::size_t i = 0; i < count; i++) {
+    pairs[i] = {i * 3, i};
+  }
+  std::mt19937_64 random(1);
+  std::vector<std::size_t> probes(queries);
+  for (auto &i : probes) {
+    i = random() % count;
+  }
+
+  {
+    Map<std::uint64_t, std::uint64_t> map;
+    double ms = measure_ms([&] {
+      for (const auto &[key, value] : pairs) {
+        map[key] = value;
+      }
+    });
+    report("operator[]", ms, map, pairs, probes);
+    std::cout << "  height " << map.height() << std::endl;
+  }
+  {
+    Map<std::uint64_t, std::uint64_t> map;
+    double ms = measure_ms([&] {
+      map = Map<std::uint64_t, std::uint64_t>::from_sorted(pairs.begin(), pairs.end());
+    });
+    report("from_sorted", ms, map, pairs, probes);
+    std::cout << "  height " << map.height() << std::endl;
+  }
+  {
+    std::map<std::uint64_t, std::uint64_t> map;
+    double ms = measure_ms([&] {
+      for (const auto &pair : pairs) {
+        map.emplace_hint(map.end(), pair);
+      }
+    });
+    report("std::map::emplace_hint(end())", ms, map, pairs, probes);
+  }
+  return 0;
+}
@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "map.hpp"
+
+// Истечение TTL: из count записей с ключами-метками времени удаляются
+// expired самых старых (все ключи меньше cutoff):
+//  - прежний способ: erase(key) по одному, пока begin() старше cutoff;
+//  - erase(begin(), lower_bound(cutoff)) и erase_range(0, cutoff) -
+//    разрез дерева и освобождение поддерева целиком;
+//  - std::map::erase(first, last) для сравнения.
+// Затем то же самое частыми мелкими чистками: sweeps раз по expired / sweeps.
+// Каждый вариант работает с копией одного и того же словаря (копия не
+// входит в замер). Узлы копии выделены подряд в порядке обхода дерева,
+// поэтому промахов кэша меньше, чем в словаре, собранном вставками.
+// ./bench_ttl_expiry [count] [expired] [sweeps]
+namespace {
+
+using Timestamps = Map<std::uint64_t, std::uint64_t>;
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+// Прежний способ: удалять самый старый ключ, пока он меньше cutoff
+std::size_t expire_one_by_one(Timestamps &map, std::uint64_t cutoff) {
+  std::size_t removed = 0;
+  while (map.begin() != map.end() && (*map.begin()).first < cutoff) {
+    map.erase((*map.begin()).first);
+    removed++;
+  }
+  return removed;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  std::size_t expired = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+  std::size_t sweeps = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1000;
+  std::mt19937_64 random(1);
+  std::vector<std::uint64_t> keys(count);
+  for (auto &key : keys) {
+    key = random() % 1000000000000;
+  }
+
+  Timestamps base;
+  std::map<std::uint64_t, std::uint64_t> std_base;
+  for (std::uint64_t key : keys) {
+    base[key] = key;
+    std_base[key] = key;
+  }
+  // Метки времени, по которым чистит каждая из sweeps чисток; последняя -
+  // cutoff для разовой чистки
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  expired = std::min(expired, keys.size());
+  std::vector<std::uint64_t> cutoffs;
+  for (std::size_t i = 1; i <= sweeps; i++) {
+    std::size_t index = expired * i / sweeps;
+    cutoffs.push_back(index < keys.size() ? keys[index] : keys.back() + 1);
+  }
+  std::uint64_t cutoff = cutoffs.back();
+  std::cout << base.size() << " keys, expiring " << expired << std::endl;
+
+  {
+    Timestamps map{base};
+    std::size_t removed = 0;
+    double ms = measure_ms([&] { removed = expire_one_by_one(map, cutoff); });
+    std::cout << "erase(key) one by one: " << ms << " ms, " << removed << " removed" << std::endl;
+  }
+  {
+    Timestamps map{base};
+    double ms = measure_ms([&] { map.erase(map.begin(), map.lower_bound(cutoff)); });
+    std::cout << "erase(begin(), lower_bound(cutoff)): " << ms << " ms, " << map.size()
+              << " left" << std::endl;
+  }
+  {
+    Timestamps map{base};
+    std::size_t removed = 0;
+    double ms = measure_ms([&] { removed = map.erase_range(0, cutoff); });
+    std::cout << "erase_range(0, cutoff): " << ms << " ms, " << removed << " removed, height "
+              << map.height() << std::endl;
+  }
+  {
+    auto map = std_base;
+    double ms = measure_ms([&] { map.erase(map.begin(), map.lower_bound(cutoff)); });
+    std::cout << "std::map::erase(first, last): " << ms << " ms" << std::endl;
+  }
+
+  {
+    Timestamps map{base};
+    double ms = measure_ms([&] {
+      for (std::uint64_t sweep_cutoff : cutoffs) {
+        expire_one_by_one(map, sweep_cutoff);
+      }
+    });
+    std::cout << sweeps << " sweeps, erase(key) one by one: " << ms << " ms" << std::endl;
+  }
+  {
+    Timestamps map{base};
+    double ms = measure_ms([&] {
+      for (std::uint64_t sweep_cutoff : cutoffs) {
+        map.erase_range(0, sweep_cutoff);
+      }
+    });
+    std::cout << sweeps << " sweeps, erase_range(0, cutoff): " << ms << " ms, " << map.size()
+              << " left" << std::endl;
+  }
+  {
+    Timestamps map{base};
+    std::uint64_t sum = 0;
+    double ms = measure_ms([&] {
+      map.for_each_in_range(0, cutoff, [&](const auto &pair) { sum += pair.second; });
+    });
+    std::cout << "for_each_in_range over expired: " << ms << " ms [" << sum << "]" << std::endl;
+  }
+  return 0;
+}
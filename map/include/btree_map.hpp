@@ -0,0 +1,749 @@
+#ifndef BTREE_MAP_H
+#define BTREE_MAP_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Упорядоченный словарь на B+-дереве. Узел занимает около NodeSize байт
+// (по умолчанию 1 КБ - 16 кеш-линий) и хранит десятки ключей подряд в
+// отсортированном массиве, поэтому уровней в дереве в несколько раз
+// меньше, чем log2(n) уровней Map, и на каждом - несколько соседних
+// кеш-линий вместо отдельного узла в случайном месте памяти. Пары лежат только в
+// листьях; листья связаны в список, и обход по порядку идет по массивам
+// листьев без подъемов к родителям.
+//
+// В отличие от Map, вставка и удаление сдвигают элементы внутри узлов,
+// поэтому они делают недействительными итераторы и ссылки на элементы.
+// Ключ и значение хранятся в разных массивах, так что итератор
+// разыменовывается в пару ссылок std::pair<const Key &, Value &>.
+// Массивы узла - сырая память: ключи и значения создаются только в занятых
+// позициях, поэтому конструктор по умолчанию у Key не нужен:
+//  BTreeMap<int, std::string> map;
+//  map[1] = "one";
+//  for (auto it = map.begin(); it != map.end(); ++it) {
+//    std::cout << (*it).first << it->second;
+//  }
+template <class Key, class Value, std::size_t NodeSize = 1024,
+          class Allocator = std::allocator<std::pair<const Key, Value>>>
+class BTreeMap {
+public:
+  template <bool Const>
+  class BasicIterator;
+  using Iterator = BasicIterator<false>;
+  using ConstIterator = BasicIterator<true>;
+  using allocator_type = Allocator;
+
+private:
+  struct NodeBase {
+    // Ключей в узле; у внутреннего узла детей на один больше
+    std::uint32_t count{0};
+    bool leaf;
+
+    explicit NodeBase(bool leaf) : leaf{leaf} {}
+  };
+
+  // Сколько элементов по item байт помещается в узел после заголовка
+  // header (но не меньше 4, иначе узлы не делятся пополам)
+  static constexpr std::size_t fit(std::size_t header, std::size_t item) {
+    return NodeSize > header + 4 * item ? (NodeSize - header) / item : 4;
+  }
+
+  static constexpr std::size_t kLeafCapacity =
+      fit(sizeof(NodeBase) + 2 * sizeof(void *), sizeof(Key) + sizeof(Value));
+  static constexpr std::size_t kInnerCapacity =
+      fit(sizeof(NodeBase) + sizeof(void *), sizeof(Key) + sizeof(void *));
+  // Меньше стольких ключей узел (кроме корня) не бывает: удаление занимает
+  // ключ у соседа или сливает узел с ним. Для внутренних узлов минимум
+  // на единицу меньше половины: столько остается после деления полного
+  static constexpr std::size_t kMinLeaf = kLeafCapacity / 2;
+  static constexpr std::size_t kMinInner = (kInnerCapacity - 1) / 2;
+  // В каждом внутреннем узле хотя бы два ребенка, так что глубже не бывает
+  static constexpr std::size_t kMaxDepth = 64;
+
+  // Живы только первые count ключей и значений, остальная память сырая
+  struct Leaf : NodeBase {
+    Leaf *prev{nullptr};
+    Leaf *next{nullptr};
+    alignas(Key) unsigned char key_buffer[kLeafCapacity * sizeof(Key)];
+    alignas(Value) unsigned char value_buffer[kLeafCapacity * sizeof(Value)];
+
+    Leaf() : NodeBase(true) {}
+    Leaf(const Leaf &) = delete;
+    Leaf &operator=(const Leaf &) = delete;
+    ~Leaf() {
+      std::destroy(keys(), keys() + this->count);
+      std::destroy(values(), values() + this->count);
+    }
+
+    Key *keys() { return reinterpret_cast<Key *>(key_buffer); }
+    const Key *keys() const { return reinterpret_cast<const Key *>(key_buffer); }
+    Value *values() { return reinterpret_cast<Value *>(value_buffer); }
+    const Value *values() const { return reinterpret_cast<const Value *>(value_buffer); }
+  };
+
+  // Ключи в children[i] меньше keys()[i] и не меньше keys()[i - 1]
+  struct Inner : NodeBase {
+    alignas(Key) unsigned char key_buffer[kInnerCapacity * sizeof(Key)];
+    NodeBase *children[kInnerCapacity + 1];
+
+    Inner() : NodeBase(false) {}
+    Inner(const Inner &) = delete;
+    Inner &operator=(const Inner &) = delete;
+    ~Inner() { std::destroy(keys(), keys() + this->count); }
+
+    Key *keys() { return reinterpret_cast<Key *>(key_buffer); }
+    const Key *keys() const { return reinterpret_cast<const Key *>(key_buffer); }
+  };
+
+  // Внутренний узел и номер ребенка, в который спустился поиск
+  struct Step {
+    Inner *node;
+    std::size_t index;
+  };
+
+  NodeBase *root{nullptr};
+  Leaf *first{nullptr};
+  Leaf *last{nullptr};
+  std::size_t s{0};
+  Allocator alloc{};
+
+  // Выделяет и создает узел (Leaf или Inner) через аллокатор
+  template <class Node>
+  Node *create() {
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using Traits = std::allocator_traits<NodeAllocator>;
+    NodeAllocator node_alloc(alloc);
+    Node *node = Traits::allocate(node_alloc, 1);
+    try {
+      Traits::construct(node_alloc, node);
+    } catch (...) {
+      Traits::deallocate(node_alloc, node, 1);
+      throw;
+    }
+    return node;
+  }
+
+  template <class Node>
+  void destroy(Node *node) {
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using Traits = std::allocator_traits<NodeAllocator>;
+    NodeAllocator node_alloc(alloc);
+    Traits::destroy(node_alloc, node);
+    Traits::deallocate(node_alloc, node, 1);
+  }
+
+  // Ставит item в позицию pos массива с живыми элементами [0, count):
+  // последний переезжает в сырую позицию count, остальные сдвигаются вправо
+  template <class T>
+  static void insert_at(T *items, std::size_t pos, std::size_t count, T &&item) {
+    if (pos == count) {
+      ::new (static_cast<void *>(items + count)) T(std::move(item));
+      return;
+    }
+    ::new (static_cast<void *>(items + count)) T(std::move(items[count - 1]));
+    std::move_backward(items + pos, items + count - 1, items + count);
+    items[pos] = std::move(item);
+  }
+
+  // Убирает элемент pos из живых [0, count): позиция count - 1 становится сырой
+  template <class T>
+  static void erase_at(T *items, std::size_t pos, std::size_t count) {
+    std::move(items + pos + 1, items + count, items + pos);
+    std::destroy_at(items + count - 1);
+  }
+
+  // Переносит живые элементы [first, last) в сырую память dest; [first, last)
+  // становится сырым
+  template <class T>
+  static void relocate(T *first, T *last, T *dest) {
+    std::uninitialized_move(first, last, dest);
+    std::destroy(first, last);
+  }
+
+  void destroy_tree(NodeBase *node) {
+    if (node->leaf) {
+      destroy(static_cast<Leaf *>(node));
+      return;
+    }
+    Inner *inner = static_cast<Inner *>(node);
+    for (std::size_t i = 0; i <= inner->count; i++) {
+      destroy_tree(inner->children[i]);
+    }
+    destroy(inner);
+  }
+
+  // Копирует поддерево, подцепляя листья копии в список за previous
+  NodeBase *copy_tree(const NodeBase *node, Leaf *&previous) {
+    if (node->leaf) {
+      const Leaf *source = static_cast<const Leaf *>(node);
+      Leaf *copy = create<Leaf>();
+      // count растет по мере создания пар: при исключении destroy уничтожит
+      // только созданные
+      try {
+        for (; copy->count < source->count; ++copy->count) {
+          const std::size_t i = copy->count;
+          ::new (static_cast<void *>(copy->keys() + i)) Key(source->keys()[i]);
+          try {
+            ::new (static_cast<void *>(copy->values() + i)) Value(source->values()[i]);
+          } catch (...) {
+            std::destroy_at(copy->keys() + i);
+            throw;
+          }
+        }
+      } catch (...) {
+        destroy(copy);
+        throw;
+      }
+      copy->prev = previous;
+      if (previous) {
+        previous->next = copy;
+      } else {
+        first = copy;
+      }
+      previous = copy;
+      return copy;
+    }
+    const Inner *source = static_cast<const Inner *>(node);
+    Inner *copy = create<Inner>();
+    try {
+      std::uninitialized_copy(source->keys(), source->keys() + source->count, copy->keys());
+    } catch (...) {
+      destroy(copy);
+      throw;
+    }
+    copy->count = source->count;
+    std::size_t built = 0;
+    try {
+      for (; built <= source->count; built++) {
+        copy->children[built] = copy_tree(source->children[built], previous);
+      }
+    } catch (...) {
+      for (std::size_t i = 0; i < built; i++) {
+        destroy_tree(copy->children[i]);
+      }
+      destroy(copy);
+      throw;
+    }
+    return copy;
+  }
+
+  // Номер ребенка inner, в поддереве которого лежит key
+  static std::size_t child_index(const Inner *inner, const Key &key) {
+    return std::upper_bound(inner->keys(), inner->keys() + inner->count, key) - inner->keys();
+  }
+
+  // Позиция первого ключа листа, не меньшего key
+  static std::size_t leaf_index(const Leaf *leaf, const Key &key) {
+    return std::lower_bound(leaf->keys(), leaf->keys() + leaf->count, key) - leaf->keys();
+  }
+
+  Leaf *find_leaf(const Key &key) const {
+    NodeBase *node = root;
+    while (!node->leaf) {
+      Inner *inner = static_cast<Inner *>(node);
+      node = inner->children[child_index(inner, key)];
+    }
+    return static_cast<Leaf *>(node);
+  }
+
+  // Спускается к листу key, запоминая путь. Возвращает лист и глубину пути
+  Leaf *descend(const Key &key, Step *path, std::size_t &depth) const {
+    NodeBase *node = root;
+    depth = 0;
+    while (!node->leaf) {
+      Inner *inner = static_cast<Inner *>(node);
+      std::size_t index = child_index(inner, key);
+      path[depth++] = {inner, index};
+      node = inner->children[index];
+    }
+    return static_cast<Leaf *>(node);
+  }
+
+  // Лист с ключом key и его позиция или {nullptr, 0}
+  std::pair<Leaf *, std::size_t> locate(const Key &key) const {
+    if (!root) {
+      return {nullptr, 0};
+    }
+    Leaf *leaf = find_leaf(key);
+    std::size_t pos = leaf_index(leaf, key);
+    if (pos < leaf->count && !(key < leaf->keys()[pos])) {
+      return {leaf, pos};
+    }
+    return {nullptr, 0};
+  }
+
+  // Первый элемент с ключом не меньше key или {nullptr, 0}
+  std::pair<Leaf *, std::size_t> lower_bound_position(const Key &key) const {
+    if (!root) {
+      return {nullptr, 0};
+    }
+    Leaf *leaf = find_leaf(key);
+    std::size_t pos = leaf_index(leaf, key);
+    if (pos == leaf->count) {
+      // Все ключи листа меньше key, а в следующем - не меньше разделителя,
+      // который больше key
+      return {leaf->next, 0};
+    }
+    return {leaf, pos};
+  }
+
+  // Сдвигает элементы листа вправо и ставит key со значением по умолчанию.
+  // Копия ключа и значение создаются до сдвига, дальше только перемещения
+  static void insert_into_leaf(Leaf *leaf, std::size_t pos, const Key &key) {
+    Key copy = key;
+    Value value{};
+    insert_at(leaf->keys(), pos, leaf->count, std::move(copy));
+    insert_at(leaf->values(), pos, leaf->count, std::move(value));
+    ++leaf->count;
+  }
+
+  static void erase_from_leaf(Leaf *leaf, std::size_t pos) {
+    erase_at(leaf->keys(), pos, leaf->count);
+    erase_at(leaf->values(), pos, leaf->count);
+    --leaf->count;
+  }
+
+  // Вставляет разделитель keys()[index] и правого от него ребенка
+  static void insert_into_inner(Inner *inner, std::size_t index, Key &&separator,
+                                NodeBase *child) {
+    insert_at(inner->keys(), index, inner->count, std::move(separator));
+    std::move_backward(inner->children + index + 1, inner->children + inner->count + 1,
+                       inner->children + inner->count + 2);
+    inner->children[index + 1] = child;
+    ++inner->count;
+  }
+
+  // Убирает разделитель keys()[index] и правого от него ребенка
+  static void erase_from_inner(Inner *inner, std::size_t index) {
+    erase_at(inner->keys(), index, inner->count);
+    std::move(inner->children + index + 2, inner->children + inner->count + 1,
+              inner->children + index + 1);
+    --inner->count;
+  }
+
+  // Ищет key и, если его нет, вставляет со значением по умолчанию.
+  // Полный лист делится пополам, новый разделитель поднимается по пути
+  // и может делить внутренние узлы вплоть до корня [O(log n)]. Все узлы
+  // для делений выделяются до изменения дерева, поэтому при нехватке
+  // памяти дерево остается прежним
+  std::pair<Iterator, bool> insert_key(const Key &key) {
+    if (!root) {
+      first = last = create<Leaf>();
+      root = first;
+    }
+    Step path[kMaxDepth];
+    std::size_t depth = 0;
+    Leaf *leaf = descend(key, path, depth);
+    std::size_t pos = leaf_index(leaf, key);
+    if (pos < leaf->count && !(key < leaf->keys()[pos])) {
+      return {Iterator{leaf, pos}, false};
+    }
+    if (leaf->count < kLeafCapacity) {
+      insert_into_leaf(leaf, pos, key);
+      ++s;
+      return {Iterator{leaf, pos}, true};
+    }
+
+    // Делятся полные внутренние узлы над листом подряд; если полны все,
+    // нужен еще новый корень
+    std::size_t splits = 0;
+    while (splits < depth && path[depth - 1 - splits].node->count == kInnerCapacity) {
+      ++splits;
+    }
+    const std::size_t inner_needed = splits + (splits == depth ? 1 : 0);
+    Inner *spare[kMaxDepth + 1];
+    std::size_t allocated = 0;
+    Leaf *right = create<Leaf>();
+    try {
+      for (; allocated < inner_needed; ++allocated) {
+        spare[allocated] = create<Inner>();
+      }
+    } catch (...) {
+      while (allocated > 0) {
+        destroy(spare[--allocated]);
+      }
+      destroy(right);
+      throw;
+    }
+    std::size_t used = 0;
+
+    relocate(leaf->keys() + kMinLeaf, leaf->keys() + kLeafCapacity, right->keys());
+    relocate(leaf->values() + kMinLeaf, leaf->values() + kLeafCapacity, right->values());
+    right->count = kLeafCapacity - kMinLeaf;
+    leaf->count = kMinLeaf;
+    right->prev = leaf;
+    right->next = leaf->next;
+    if (leaf->next) {
+      leaf->next->prev = right;
+    } else {
+      last = right;
+    }
+    leaf->next = right;
+    Iterator result;
+    if (pos <= kMinLeaf) {
+      insert_into_leaf(leaf, pos, key);
+      result = Iterator{leaf, pos};
+    } else {
+      insert_into_leaf(right, pos - kMinLeaf, key);
+      result = Iterator{right, pos - kMinLeaf};
+    }
+    ++s;
+
+    Key separator = right->keys()[0];
+    NodeBase *child = right;
+    while (depth > 0) {
+      auto [inner, index] = path[--depth];
+      if (inner->count < kInnerCapacity) {
+        insert_into_inner(inner, index, std::move(separator), child);
+        assert(used == inner_needed);
+        return {result, true};
+      }
+      // Средний ключ полного узла уходит к родителю, правее него - в sibling
+      const std::size_t middle = kInnerCapacity / 2;
+      Inner *sibling = spare[used++];
+      Key up = std::move(inner->keys()[middle]);
+      relocate(inner->keys() + middle + 1, inner->keys() + kInnerCapacity, sibling->keys());
+      std::destroy_at(inner->keys() + middle);
+      std::copy(inner->children + middle + 1, inner->children + kInnerCapacity + 1,
+                sibling->children);
+      sibling->count = kInnerCapacity - middle - 1;
+      inner->count = middle;
+      if (index <= middle) {
+        insert_into_inner(inner, index, std::move(separator), child);
+      } else {
+        insert_into_inner(sibling, index - middle - 1, std::move(separator), child);
+      }
+      separator = std::move(up);
+      child = sibling;
+    }
+    Inner *new_root = spare[used++];
+    insert_at(new_root->keys(), 0, 0, std::move(separator));
+    new_root->children[0] = root;
+    new_root->children[1] = child;
+    new_root->count = 1;
+    root = new_root;
+    assert(used == inner_needed);
+    return {result, true};
+  }
+
+  // Лист parent->children[index] стал меньше минимума: занимает элемент у
+  // соседа или сливается с ним
+  void rebalance_leaf(Leaf *leaf, Inner *parent, std::size_t index) {
+    Leaf *left = index > 0 ? static_cast<Leaf *>(parent->children[index - 1]) : nullptr;
+    Leaf *right =
+        index < parent->count ? static_cast<Leaf *>(parent->children[index + 1]) : nullptr;
+    if (left && left->count > kMinLeaf) {
+      insert_at(leaf->keys(), 0, leaf->count, std::move(left->keys()[left->count - 1]));
+      insert_at(leaf->values(), 0, leaf->count, std::move(left->values()[left->count - 1]));
+      ++leaf->count;
+      erase_from_leaf(left, left->count - 1);
+      parent->keys()[index - 1] = leaf->keys()[0];
+      return;
+    }
+    if (right && right->count > kMinLeaf) {
+      insert_at(leaf->keys(), leaf->count, leaf->count, std::move(right->keys()[0]));
+      insert_at(leaf->values(), leaf->count, leaf->count, std::move(right->values()[0]));
+      ++leaf->count;
+      erase_from_leaf(right, 0);
+      parent->keys()[index] = right->keys()[0];
+      return;
+    }
+    if (right) {
+      merge_leaves(leaf, right);
+      erase_from_inner(parent, index);
+    } else {
+      merge_leaves(left, leaf);
+      erase_from_inner(parent, index - 1);
+    }
+  }
+
+  // Переносит все элементы right в конец left и удаляет right
+  void merge_leaves(Leaf *left, Leaf *right) {
+    relocate(right->keys(), right->keys() + right->count, left->keys() + left->count);
+    relocate(right->values(), right->values() + right->count, left->values() + left->count);
+    left->count += right->count;
+    right->count = 0;
+    left->next = right->next;
+    if (right->next) {
+      right->next->prev = left;
+    } else {
+      last = left;
+    }
+    destroy(right);
+  }
+
+  // То же для внутреннего узла parent->children[index]: разделитель
+  // родителя опускается в узел, а на его место поднимается ключ соседа
+  void rebalance_inner(Inner *node, Inner *parent, std::size_t index) {
+    Inner *left = index > 0 ? static_cast<Inner *>(parent->children[index - 1]) : nullptr;
+    Inner *right =
+        index < parent->count ? static_cast<Inner *>(parent->children[index + 1]) : nullptr;
+    if (left && left->count > kMinInner) {
+      insert_at(node->keys(), 0, node->count, std::move(parent->keys()[index - 1]));
+      std::move_backward(node->children, node->children + node->count + 1,
+                         node->children + node->count + 2);
+      node->children[0] = left->children[left->count];
+      parent->keys()[index - 1] = std::move(left->keys()[left->count - 1]);
+      std::destroy_at(left->keys() + left->count - 1);
+      --left->count;
+      ++node->count;
+      return;
+    }
+    if (right && right->count > kMinInner) {
+      insert_at(node->keys(), node->count, node->count, std::move(parent->keys()[index]));
+      node->children[node->count + 1] = right->children[0];
+      ++node->count;
+      parent->keys()[index] = std::move(right->keys()[0]);
+      erase_at(right->keys(), 0, right->count);
+      std::move(right->children + 1, right->children + right->count + 1, right->children);
+      --right->count;
+      return;
+    }
+    if (right) {
+      merge_inner(node, right, parent, index);
+    } else {
+      merge_inner(left, node, parent, index - 1);
+    }
+  }
+
+  // Сливает right в left вместе с разделителем parent->keys()[index] между
+  // ними и удаляет right
+  void merge_inner(Inner *left, Inner *right, Inner *parent, std::size_t index) {
+    insert_at(left->keys(), left->count, left->count, std::move(parent->keys()[index]));
+    relocate(right->keys(), right->keys() + right->count, left->keys() + left->count + 1);
+    std::copy(right->children, right->children + right->count + 1,
+              left->children + left->count + 1);
+    left->count += right->count + 1;
+    right->count = 0;
+    erase_from_inner(parent, index);
+    destroy(right);
+  }
+
+  static std::size_t height(const NodeBase *node) {
+    std::size_t result = 0;
+    for (; node; ++result) {
+      node = node->leaf ? nullptr : static_cast<const Inner *>(node)->children[0];
+    }
+    return result;
+  }
+
+public:
+  // Создает пустой словарь
+  BTreeMap() = default;
+
+  // Создает пустой словарь, память которого выделяет alloc
+  explicit BTreeMap(const Allocator &alloc) : alloc{alloc} {}
+
+  // Глубокая копия other [O(n)]
+  BTreeMap(const BTreeMap &other)
+      : alloc{std::allocator_traits<Allocator>::select_on_container_copy_construction(
+            other.alloc)} {
+    if (other.root) {
+      Leaf *previous = nullptr;
+      root = copy_tree(other.root, previous);
+      last = previous;
+      s = other.s;
+    }
+  }
+
+  BTreeMap(BTreeMap &&other) : alloc{other.alloc} { swap(other); }
+
+  BTreeMap &operator=(const BTreeMap &other) {
+    BTreeMap tmp{other};
+    swap(tmp);
+    return *this;
+  }
+
+  BTreeMap &operator=(BTreeMap &&other) {
+    BTreeMap tmp{std::move(other)};
+    swap(tmp);
+    return *this;
+  }
+
+  ~BTreeMap() { clear(); }
+
+  Allocator get_allocator() const { return alloc; }
+
+  Iterator begin() { return Iterator{first, 0}; }
+  ConstIterator begin() const { return ConstIterator{first, 0}; }
+
+  Iterator end() { return Iterator{nullptr, 0}; }
+  ConstIterator end() const { return ConstIterator{nullptr, 0}; }
+
+  // Количество элементов [O(1)]
+  std::size_t size() const { return s; }
+
+  bool empty() const { return s == 0; }
+
+  // Количество уровней дерева (0 для пустого, 1 - только лист)
+  std::size_t height() const { return height(root); }
+
+  Iterator find(const Key &key) {
+    auto [leaf, pos] = locate(key);
+    return Iterator{leaf, pos};
+  }
+
+  ConstIterator find(const Key &key) const {
+    auto [leaf, pos] = locate(key);
+    return ConstIterator{leaf, pos};
+  }
+
+  bool contains(const Key &key) const { return locate(key).first != nullptr; }
+
+  // Возвращает значение по ключу или бросает std::out_of_range
+  const Value &operator[](const Key &key) const {
+    auto [leaf, pos] = locate(key);
+    if (!leaf) {
+      throw std::out_of_range("no such key");
+    }
+    return leaf->values()[pos];
+  }
+
+  // Возвращает ссылку на значение ключа, создавая его со значением по
+  // умолчанию, если ключа нет. Ссылка живет до следующей вставки или удаления
+  Value &operator[](const Key &key) {
+    auto it = insert_key(key).first;
+    return it.leaf->values()[it.index];
+  }
+
+  // Удаляет элемент по ключу, возвращает был ли он [O(log n)]
+  bool erase(const Key &key) {
+    if (!root) {
+      return false;
+    }
+    Step path[kMaxDepth];
+    std::size_t depth = 0;
+    Leaf *leaf = descend(key, path, depth);
+    std::size_t pos = leaf_index(leaf, key);
+    if (pos == leaf->count || key < leaf->keys()[pos]) {
+      return false;
+    }
+    erase_from_leaf(leaf, pos);
+    --s;
+    if (depth == 0) {
+      if (leaf->count == 0) {
+        destroy(leaf);
+        root = first = last = nullptr;
+      }
+      return true;
+    }
+    if (leaf->count >= kMinLeaf) {
+      return true;
+    }
+    rebalance_leaf(leaf, path[depth - 1].node, path[depth - 1].index);
+    // Слияние забрало ключ у родителя: нехватка может подняться выше
+    for (--depth; depth > 0; --depth) {
+      Inner *node = path[depth].node;
+      if (node->count >= kMinInner) {
+        return true;
+      }
+      rebalance_inner(node, path[depth - 1].node, path[depth - 1].index);
+    }
+    Inner *top = static_cast<Inner *>(root);
+    if (top->count == 0) {
+      root = top->children[0];
+      destroy(top);
+    }
+    return true;
+  }
+
+  // Первый элемент с ключом не меньше key или end() [O(log n)]
+  Iterator lower_bound(const Key &key) {
+    auto [leaf, pos] = lower_bound_position(key);
+    return Iterator{leaf, pos};
+  }
+
+  ConstIterator lower_bound(const Key &key) const {
+    auto [leaf, pos] = lower_bound_position(key);
+    return ConstIterator{leaf, pos};
+  }
+
+  void swap(BTreeMap &other) {
+    std::swap(root, other.root);
+    std::swap(first, other.first);
+    std::swap(last, other.last);
+    std::swap(s, other.s);
+    std::swap(alloc, other.alloc);
+  }
+
+  // Удаляет все элементы [O(n)]
+  void clear() {
+    if (root) {
+      destroy_tree(root);
+    }
+    root = first = last = nullptr;
+    s = 0;
+  }
+
+  // Двунаправленный итератор: лист и позиция в нем. end() - {nullptr, 0}
+  template <bool Const>
+  class BasicIterator {
+    friend BTreeMap;
+    template <bool>
+    friend class BasicIterator;
+
+    Leaf *leaf{nullptr};
+    std::size_t index{0};
+
+    BasicIterator(Leaf *leaf, std::size_t index) : leaf{leaf}, index{index} {}
+
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::pair<Key, Value>;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::pair<const Key &, std::conditional_t<Const, const Value &, Value &>>;
+
+    // operator-> возвращает пару ссылок по значению
+    struct pointer {
+      reference ref;
+      const reference *operator->() const { return &ref; }
+    };
+
+    BasicIterator() = default;
+
+    // Iterator неявно превращается в ConstIterator
+    template <bool OtherConst, class = std::enable_if_t<Const && !OtherConst>>
+    BasicIterator(const BasicIterator<OtherConst> &other)
+        : leaf{other.leaf}, index{other.index} {}
+
+    BasicIterator &operator++() {
+      if (++index == leaf->count) {
+        leaf = leaf->next;
+        index = 0;
+      }
+      return *this;
+    }
+
+    BasicIterator operator++(int) {
+      BasicIterator old = *this;
+      ++*this;
+      return old;
+    }
+
+    BasicIterator &operator--() {
+      if (index == 0) {
+        leaf = leaf->prev;
+        index = leaf->count;
+      }
+      --index;
+      return *this;
+    }
+
+    bool operator==(const BasicIterator &other) const {
+      return leaf == other.leaf && index == other.index;
+    }
+    bool operator!=(const BasicIterator &other) const { return !(*this == other); }
+
+    reference operator*() const { return {leaf->keys()[index], leaf->values()[index]}; }
+    pointer operator->() const { return pointer{**this}; }
+  };
+};
+
+#endif
@@ -1,11 +1,24 @@
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <iostream>
+#include <iterator>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
-template <class Key, class Value> class Map {
+// Allocator - аллокатор пар ключ-значение (по умолчанию std::allocator).
+// Узлы дерева выделяются через него же (rebind на Node).
+// OrderStatistics - хранить в узле размер его поддерева: тогда доступны
+// nth(k) и rank(key) за O(log n), ценой 8 байт на узел и обновления
+// размеров на пути к корню при вставке и удалении
+template <class Key, class Value,
+          class Allocator = std::allocator<std::pair<const Key, Value>>,
+          bool OrderStatistics = false>
+class Map {
 private:
   using key_type = Key;
   using mapped_type = Value;
@@ -15,64 +28,642 @@ private:
   using reference = ValueType &;
   using const_reference = const ValueType &;
 
-  struct Node {
+  // Узел красно-черного дерева. Свойства: корень черный, у красного узла
+  // нет красных детей, на любом пути от узла вниз до nullptr одинаковое
+  // число черных узлов. Отсюда высота не больше 2 log2(n + 1)
+  struct SizeSlot {
+    std::size_t size{1};
+  };
+  struct NoSizeSlot {};
+
+  struct Node : std::conditional_t<OrderStatistics, SizeSlot, NoSizeSlot> {
     Node *left{nullptr};
     Node *parent{nullptr};
     Node *right{nullptr};
+    bool red{true};
     std::pair<Key, Value> data{};
 
     Node(Node *left, Node *parent, Node *right, ValueType data)
         : left{left}, parent{parent}, right{right}, data{data} {}
   };
+  using NodeAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+  NodeAllocator alloc{};
   Node *root{nullptr};
+  std::size_t s{0};
 
-  void push(const Key &key, const Value &value) {
-    if (!root) {
-      root = new Node{nullptr, nullptr, nullptr, {key, value}};
-      // std::cout<<root<<std::endl;
-      return;
+  // Выделяет и создает узел через аллокатор
+  Node *create_node(Node *left, Node *parent, Node *right, ValueType data) {
+    Node *node = NodeTraits::allocate(alloc, 1);
+    try {
+      NodeTraits::construct(alloc, node, left, parent, right, data);
+    } catch (...) {
+      NodeTraits::deallocate(alloc, node, 1);
+      throw;
     }
+    return node;
+  }
+
+  // Уничтожает узел и возвращает память аллокатору
+  void destroy_node(Node *node) {
+    NodeTraits::destroy(alloc, node);
+    NodeTraits::deallocate(alloc, node, 1);
+  }
+
+  // Ищет место ключа key: возвращает {узел с этим ключом, nullptr}, если он
+  // есть, иначе {nullptr, родитель нового узла} (nullptr для пустого дерева)
+  std::pair<Node *, Node *> find_slot(const Key &key) const {
+    Node *parent = nullptr;
     Node *current = root;
     while (current) {
-      if (current->data.first > key) {
-        if (!current->left) {
-          current->left = new Node{nullptr, current, nullptr, {key, value}};
-          break;
-        } else {
-          current = current->left;
+      if (key < current->data.first) {
+        parent = current;
+        current = current->left;
+      } else if (current->data.first < key) {
+        parent = current;
+        current = current->right;
+      } else {
+        return {current, nullptr};
+      }
+    }
+    return {nullptr, parent};
+  }
+
+  static bool is_red(const Node *node) { return node && node->red; }
+
+  // Ставит поддерево to (может быть nullptr) на место поддерева from
+  void transplant(Node *from, Node *to) {
+    if (!from->parent) {
+      root = to;
+    } else if (from == from->parent->left) {
+      from->parent->left = to;
+    } else {
+      from->parent->right = to;
+    }
+    if (to) {
+      to->parent = from->parent;
+    }
+  }
+
+  // Размер поддерева node (только при OrderStatistics)
+  static std::size_t subtree_size(const Node *node) {
+    if constexpr (OrderStatistics) {
+      return node ? node->size : 0;
+    } else {
+      return 0;
+    }
+  }
+
+  // Пересчитывает размер поддерева node по его детям
+  static void update_size([[maybe_unused]] Node *node) {
+    if constexpr (OrderStatistics) {
+      node->size = subtree_size(node->left) + subtree_size(node->right) + 1;
+    }
+  }
+
+  // Поворот влево: правый потомок right встает на место node, node
+  // становится его левым потомком, а левое поддерево right - правым
+  // поддеревом node. Порядок ключей не меняется
+  void rotate_left(Node *node) {
+    Node *right = node->right;
+    node->right = right->left;
+    if (right->left) {
+      right->left->parent = node;
+    }
+    transplant(node, right);
+    right->left = node;
+    node->parent = right;
+    update_size(node);
+    update_size(right);
+  }
+
+  // Зеркально rotate_left
+  void rotate_right(Node *node) {
+    Node *left = node->left;
+    node->left = left->right;
+    if (left->right) {
+      left->right->parent = node;
+    }
+    transplant(node, left);
+    left->right = node;
+    node->parent = left;
+    update_size(node);
+    update_size(left);
+  }
+
+  // Подвешивает отдельный узел к parent (из find_slot) слева или справа и
+  // восстанавливает свойства дерева: не больше двух поворотов [O(log n)]
+  void attach(Node *node, Node *parent) {
+    node->left = node->right = nullptr;
+    node->parent = parent;
+    node->red = true;
+    update_size(node);
+    if (!parent) {
+      root = node;
+    } else if (node->data.first < parent->data.first) {
+      parent->left = node;
+    } else {
+      parent->right = node;
+    }
+    ++s;
+    if constexpr (OrderStatistics) {
+      for (Node *up = parent; up; up = up->parent) {
+        ++up->size;
+      }
+    }
+    fix_after_insert(node);
+  }
+
+  // Восстанавливает свойства дерева после появления красного узла node:
+  // не больше двух поворотов [O(log n)]
+  void fix_after_insert(Node *node) {
+    // Красный node под красным родителем: если дядя красный, перекрашиваем
+    // и поднимаемся к деду, иначе поворотами делаем родителя вершиной
+    while (is_red(node->parent)) {
+      Node *up = node->parent;
+      Node *grandparent = up->parent;
+      if (up == grandparent->left) {
+        Node *uncle = grandparent->right;
+        if (is_red(uncle)) {
+          up->red = uncle->red = false;
+          grandparent->red = true;
+          node = grandparent;
+          continue;
+        }
+        if (node == up->right) {
+          rotate_left(up);
+          up = node;
+        }
+        up->red = false;
+        grandparent->red = true;
+        rotate_right(grandparent);
+        break;
+      } else {
+        Node *uncle = grandparent->left;
+        if (is_red(uncle)) {
+          up->red = uncle->red = false;
+          grandparent->red = true;
+          node = grandparent;
+          continue;
+        }
+        if (node == up->left) {
+          rotate_right(up);
+          up = node;
+        }
+        up->red = false;
+        grandparent->red = true;
+        rotate_left(grandparent);
+        break;
+      }
+    }
+    root->red = false;
+  }
+
+  // Вынимает узел из дерева, не уничтожая его, и восстанавливает свойства
+  // дерева: не больше трех поворотов [O(log n)]. Узлы перевешиваются, а не
+  // меняются данными, поэтому остальные узлы (и итераторы на них) остаются
+  // на месте
+  void unlink(Node *node) {
+    // child встает на место убранного из его позиции узла, child_parent -
+    // его новый родитель (child может быть nullptr)
+    Node *child;
+    Node *child_parent;
+    bool removed_black = !node->red;
+    if constexpr (OrderStatistics) {
+      // Поддеревья над освобождающейся позицией (node или его преемника)
+      // теряют по узлу
+      Node *removed = node;
+      if (node->left && node->right) {
+        removed = node->right;
+        while (removed->left) {
+          removed = removed->left;
+        }
+      }
+      for (Node *up = removed->parent; up; up = up->parent) {
+        --up->size;
+      }
+    }
+    if (!node->left) {
+      child = node->right;
+      child_parent = node->parent;
+      transplant(node, node->right);
+    } else if (!node->right) {
+      child = node->left;
+      child_parent = node->parent;
+      transplant(node, node->left);
+    } else {
+      // Два потомка: на место node встает его преемник
+      Node *successor = node->right;
+      while (successor->left) {
+        successor = successor->left;
+      }
+      removed_black = !successor->red;
+      child = successor->right;
+      if (successor->parent == node) {
+        child_parent = successor;
+      } else {
+        child_parent = successor->parent;
+        transplant(successor, successor->right);
+        successor->right = node->right;
+        successor->right->parent = successor;
+      }
+      transplant(node, successor);
+      successor->left = node->left;
+      successor->left->parent = successor;
+      successor->red = node->red;
+      update_size(successor);
+    }
+    node->left = node->parent = node->right = nullptr;
+    --s;
+    if (removed_black) {
+      fix_after_unlink(child, child_parent);
+    }
+  }
+
+  // На пути через child стало на один черный узел меньше. Красный child
+  // просто перекрашивается, иначе недостача поднимается вверх или
+  // закрывается поворотами за счет брата
+  void fix_after_unlink(Node *child, Node *parent) {
+    while (child != root && !is_red(child)) {
+      if (child == parent->left) {
+        Node *sibling = parent->right;
+        if (is_red(sibling)) {
+          sibling->red = false;
+          parent->red = true;
+          rotate_left(parent);
+          sibling = parent->right;
+        }
+        if (!is_red(sibling->left) && !is_red(sibling->right)) {
+          sibling->red = true;
+          child = parent;
+          parent = child->parent;
+          continue;
         }
+        if (!is_red(sibling->right)) {
+          sibling->left->red = false;
+          sibling->red = true;
+          rotate_right(sibling);
+          sibling = parent->right;
+        }
+        sibling->red = parent->red;
+        parent->red = false;
+        sibling->right->red = false;
+        rotate_left(parent);
       } else {
-        if (!current->right) {
-          current->right = new Node{nullptr, current, nullptr, {key, value}};
-          break;
-        } else {
-          current = current->right;
+        Node *sibling = parent->left;
+        if (is_red(sibling)) {
+          sibling->red = false;
+          parent->red = true;
+          rotate_right(parent);
+          sibling = parent->left;
+        }
+        if (!is_red(sibling->left) && !is_red(sibling->right)) {
+          sibling->red = true;
+          child = parent;
+          parent = child->parent;
+          continue;
         }
+        if (!is_red(sibling->left)) {
+          sibling->right->red = false;
+          sibling->red = true;
+          rotate_left(sibling);
+          sibling = parent->left;
+        }
+        sibling->red = parent->red;
+        parent->red = false;
+        sibling->left->red = false;
+        rotate_right(parent);
+      }
+      child = root;
+    }
+    if (child) {
+      child->red = false;
+    }
+  }
+
+  // Самый левый узел с ключом не меньше key или nullptr
+  Node *lower_bound_node(const Key &key) const {
+    Node *result = nullptr;
+    for (Node *current = root; current;) {
+      if (current->data.first < key) {
+        current = current->right;
+      } else {
+        result = current;
+        current = current->left;
       }
     }
+    return result;
+  }
+
+  // Самый левый узел с ключом больше key или nullptr
+  Node *upper_bound_node(const Key &key) const {
+    Node *result = nullptr;
+    for (Node *current = root; current;) {
+      if (key < current->data.first) {
+        result = current;
+        current = current->left;
+      } else {
+        current = current->right;
+      }
+    }
+    return result;
+  }
+
+  // Число черных узлов на пути от node вниз до nullptr
+  static std::size_t black_height(const Node *node) {
+    std::size_t height = 0;
+    for (; node; node = node->left) {
+      height += !node->red;
+    }
+    return height;
+  }
+
+  // Делает поддерево node отдельным деревом: без родителя, с черным корнем
+  static Node *detach(Node *node) {
+    if (node) {
+      node->parent = nullptr;
+      node->red = false;
+    }
+    return node;
+  }
+
+  // Склеивает деревья left и right через отдельный узел pivot (все ключи
+  // left < pivot < все ключи right) и возвращает корень. pivot встает на
+  // место поддерева с той же черной высотой на краю более высокого дерева,
+  // дальше как при вставке [O(log n)]. Пользуется root как рабочим деревом
+  Node *join(Node *left, Node *pivot, Node *right) {
+    std::size_t left_height = black_height(left);
+    std::size_t right_height = black_height(right);
+    pivot->parent = nullptr;
+    if (left_height == right_height) {
+      pivot->left = left;
+      pivot->right = right;
+      pivot->red = false;
+      if (left) {
+        left->parent = pivot;
+      }
+      if (right) {
+        right->parent = pivot;
+      }
+      update_size(pivot);
+      return pivot;
+    }
+    bool into_left = left_height > right_height;
+    std::size_t height = into_left ? left_height : right_height;
+    std::size_t target = into_left ? right_height : left_height;
+    Node *up = nullptr;
+    Node *current = into_left ? left : right;
+    while (current && (current->red || height != target)) {
+      height -= !current->red;
+      up = current;
+      current = into_left ? current->right : current->left;
+    }
+    root = into_left ? left : right;
+    pivot->left = into_left ? current : left;
+    pivot->right = into_left ? right : current;
+    if (pivot->left) {
+      pivot->left->parent = pivot;
+    }
+    if (pivot->right) {
+      pivot->right->parent = pivot;
+    }
+    pivot->parent = up;
+    (into_left ? up->right : up->left) = pivot;
+    pivot->red = true;
+    for (Node *node = pivot; node; node = node->parent) {
+      update_size(node);
+    }
+    fix_after_insert(pivot);
+    return root;
+  }
+
+  // Склеивает деревья left и right (все ключи left меньше ключей right):
+  // разделителем служит наименьший узел right
+  Node *join(Node *left, Node *right) {
+    if (!left || !right) {
+      return left ? left : right;
+    }
+    Node *pivot = right;
+    while (pivot->left) {
+      pivot = pivot->left;
+    }
+    root = right;
+    unlink(pivot);
+    ++s; // узел сразу вернется в дерево
+    return join(left, pivot, detach(root));
+  }
+
+  // Разрезает дерево node на ключи меньше key и остальные, перевешивая
+  // узлы: O(log n) склеек по пути поиска key
+  std::pair<Node *, Node *> split(Node *node, const Key &key) {
+    if (!node) {
+      return {nullptr, nullptr};
+    }
+    Node *left = detach(node->left);
+    Node *right = detach(node->right);
+    if (node->data.first < key) {
+      auto [less, rest] = split(right, key);
+      return {join(left, node, less), rest};
+    }
+    auto [less, rest] = split(left, key);
+    return {less, join(rest, node, right)};
+  }
+
+  // Удаляет узлы с ключами от lo (включительно) до *hi (не включительно;
+  // hi == nullptr - до конца): вырезает их поддеревом и склеивает остатки
+  std::size_t cut(const Key &lo, const Key *hi) {
+    auto [left, rest] = split(detach(std::exchange(root, nullptr)), lo);
+    Node *middle = rest;
+    Node *right = nullptr;
+    if (hi) {
+      std::tie(middle, right) = split(rest, *hi);
+    }
+    std::size_t removed = clear(middle);
+    root = detach(join(left, right));
+    s -= removed;
+    return removed;
+  }
+
+  // Строит идеально сбалансированное дерево из count пар, начиная с it
+  // (ключи строго по возрастанию), и сдвигает it за них. Узлы выделяются
+  // по одному в порядке ключей; подряд в памяти они лягут только с
+  // последовательным аллокатором (ArenaAllocator). Пути до nullptr
+  // отличаются по длине не больше чем на 1: узлы самого нижнего уровня
+  // bottom красные, остальные черные [O(count)]
+  template <class ForwardIt>
+  Node *build_sorted(ForwardIt &it, std::size_t count, std::size_t depth,
+                     std::size_t bottom) {
+    if (count == 0) {
+      return nullptr;
+    }
+    Node *left = build_sorted(it, count / 2, depth + 1, bottom);
+    Node *node;
+    try {
+      node = create_node(left, nullptr, nullptr, *it);
+    } catch (...) {
+      clear(left);
+      throw;
+    }
+    ++it;
+    if (left) {
+      left->parent = node;
+    }
+    node->red = depth == bottom && depth > 1;
+    try {
+      node->right = build_sorted(it, count - count / 2 - 1, depth + 1, bottom);
+    } catch (...) {
+      clear(node);
+      throw;
+    }
+    if (node->right) {
+      node->right->parent = node;
+    }
+    update_size(node);
+    return node;
+  }
+
+  // Узел с k-м по возрастанию ключом (с нуля) или nullptr: спуск по
+  // размерам левых поддеревьев
+  Node *nth_node(std::size_t k) const {
+    static_assert(OrderStatistics, "nth requires Map<Key, Value, Allocator, true>");
+    Node *current = root;
+    while (current) {
+      std::size_t left = subtree_size(current->left);
+      if (k < left) {
+        current = current->left;
+      } else if (k == left) {
+        return current;
+      } else {
+        k -= left + 1;
+        current = current->right;
+      }
+    }
+    return nullptr;
+  }
+
+  static std::size_t height(const Node *node) {
+    return node ? 1 + std::max(height(node->left), height(node->right)) : 0;
+  }
+
+  // Следующий и предыдущий узлы при обходе по возрастанию ключей
+  static Node *successor(Node *node) {
+    if (node->right) {
+      node = node->right;
+      while (node->left) {
+        node = node->left;
+      }
+      return node;
+    }
+    while (node->parent && node == node->parent->right) {
+      node = node->parent;
+    }
+    return node->parent;
+  }
+
+  static Node *predecessor(Node *node) {
+    if (node->left) {
+      node = node->left;
+      while (node->right) {
+        node = node->right;
+      }
+      return node;
+    }
+    while (node->parent && node == node->parent->left) {
+      node = node->parent;
+    }
+    return node->parent;
   }
 
 public:
   class Iterator;
   class ConstIterator;
+  using allocator_type = Allocator;
+
+  // Владелец узла, вынутого из словаря (extract). Пустой или хранит одну
+  // пару; при уничтожении освобождает узел через аллокатор словаря
+  class NodeHandle {
+    friend Map;
+
+    Node *node{nullptr};
+    NodeAllocator alloc;
+
+    NodeHandle(Node *node, const NodeAllocator &alloc) : node{node}, alloc{alloc} {}
+
+    void reset() {
+      if (node) {
+        NodeTraits::destroy(alloc, node);
+        NodeTraits::deallocate(alloc, node, 1);
+        node = nullptr;
+      }
+    }
+
+  public:
+    NodeHandle() = default;
+
+    NodeHandle(NodeHandle &&other)
+        : node{std::exchange(other.node, nullptr)}, alloc{other.alloc} {}
+
+    NodeHandle &operator=(NodeHandle &&other) {
+      if (this != &other) {
+        reset();
+        node = std::exchange(other.node, nullptr);
+        alloc = other.alloc;
+      }
+      return *this;
+    }
+
+    ~NodeHandle() { reset(); }
+
+    bool empty() const { return node == nullptr; }
+    explicit operator bool() const { return node != nullptr; }
+
+    // Ключ можно менять, пока узел не в словаре
+    Key &key() const { return node->data.first; }
+    Value &mapped() const { return node->data.second; }
+
+    Allocator get_allocator() const { return Allocator(alloc); }
+  };
+  using node_type = NodeHandle;
+
+  // Результат insert(node_type&&)
+  struct insert_return_type {
+    Iterator position;
+    bool inserted;
+    node_type node;
+  };
+
   // Создает пустой словарь
   Map() : root{nullptr} {};
 
+  // Создает пустой словарь, память которого выделяет alloc
+  explicit Map(const Allocator &alloc) : alloc{alloc}, root{nullptr} {}
+
   // Создает новый словарь, являющийся глубокой копией other [O(n)]
   //  Map<std::string, int> map;
   //  map["something"] = 69;
   //  map["anything"] = 199;
   //  Map<std::string, int> copied{map};
   //  copied["something"] == map["something"] == 69
-  Map(const Map &other) { CopyTree(&root, other.root); }
+  Map(const Map &other)
+      : alloc{NodeTraits::select_on_container_copy_construction(other.alloc)} {
+    root = CopyTree(other.root, nullptr);
+    s = other.s;
+  }
 
   // Move конструктор
-  Map(Map &&other) { std::swap(root, other.root); }
+  Map(Map &&other) : alloc{std::move(other.alloc)} {
+    std::swap(root, other.root);
+    std::swap(s, other.s);
+  }
 
   // Перезаписывает текущий словарь словарем other
   Map &operator=(const Map &other) {
     Map tmp{other};
     std::swap(root, tmp.root);
+    std::swap(s, tmp.s);
+    std::swap(alloc, tmp.alloc);
     return *this;
   }
 
@@ -80,9 +671,45 @@ public:
   Map &operator=(Map &&other) {
     Map tmp{std::move(other)};
     std::swap(root, tmp.root);
+    std::swap(s, tmp.s);
+    std::swap(alloc, tmp.alloc);
     return *this;
   }
 
+  // Создает словарь из пар [first, last) с ключами строго по возрастанию
+  // (например, из отсортированного снимка), без поиска места и
+  // перебалансировки на каждый ключ [O(n)]
+  //  std::vector<std::pair<int, std::string>> snapshot = load();
+  //  auto index = Map<int, std::string>::from_sorted(snapshot.begin(), snapshot.end());
+  template <class ForwardIt>
+  static Map from_sorted(ForwardIt first, ForwardIt last,
+                         const Allocator &alloc = Allocator()) {
+    Map map{alloc};
+    map.assign_sorted(first, last);
+    return map;
+  }
+
+  // Заменяет содержимое словаря парами [first, last) с ключами строго по
+  // возрастанию, как from_sorted [O(n)]
+  template <class ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last) {
+    assert(std::adjacent_find(first, last, [](const auto &a, const auto &b) {
+             return !(a.first < b.first);
+           }) == last);
+    std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+    // Число уровней - число значащих битов count
+    std::size_t bottom = 0;
+    while (count >> bottom) {
+      ++bottom;
+    }
+    Map tmp{Allocator(alloc)};
+    tmp.root = tmp.build_sorted(first, count, 1, bottom);
+    tmp.s = count;
+    swap(tmp);
+  }
+
+  Allocator get_allocator() const { return Allocator(alloc); }
+
   // Очищает память словаря
   ~Map() { clear(); }
 
@@ -116,25 +743,25 @@ public:
   // Возвращает const итератор обозначающий конец контейнера
   ConstIterator end() const { return ConstIterator{nullptr}; }
 
-  // Возвращает размер словаря (сколько есть узлов)
-  std::size_t size() const { return std::distance(begin(), end()); }
-
-  void CopyTree(Node **current, Node *other) {
-    // if (other->right) {
-    //   current->right = new Node{nullptr, current, nullptr, other->data}; 
-    //   CopyTree(current->right, other->right);
-    // }
-    // if (other->left) {
-    //   current->left = new Node{nullptr, current, nullptr, other->data};
-    //   CopyTree(current->left, other->left);
-    // } 
+  // Возвращает размер словаря (сколько есть узлов) [O(1)]
+  std::size_t size() const { return s; }
 
-    if(other) { *current = new Node{nullptr, nullptr, nullptr, other->data}; }
-    if(other->right){
-      // current->right = new Node{nullptr, current, nulltr, other->right->data}; 
-      CopyTree(&((*current)->right), other->right);
+  // Копирует поддерево other, корень копии получает родителя parent
+  Node *CopyTree(Node *other, Node *parent) {
+    if (!other) {
+      return nullptr;
     }
-    if(other->left) { CopyTree(&((*current)->left), other->left); }
+    Node *current = create_node(nullptr, parent, nullptr, other->data);
+    current->red = other->red;
+    try {
+      current->left = CopyTree(other->left, current);
+      current->right = CopyTree(other->right, current);
+    } catch (...) {
+      clear(current);
+      throw;
+    }
+    update_size(current);
+    return current;
   }
 
   Iterator find(const Key &key) {
@@ -161,8 +788,7 @@ public:
       }
       if (key > current->data.first) {
         current = current->right;
-      }
-      if (key < current->data.first) {
+      } else if (key < current->data.first) {
         current = current->left;
       } else {
         break;
@@ -187,13 +813,15 @@ public:
   // словаре нет элемента с таким ключем, то создает его и устанавливает
   // дефолтное значение, после чего возвращает на него ссылку. map["something"]
   // = 75;
+  // Дерево проходится один раз: место нового узла ищется вместе с ключом
   Value &operator[](const Key &key) {
-    if (find(key) == end()) {
-      //   std::cout<<"push"<<std::endl;
-      push(key, {});
+    auto [existing, parent] = find_slot(key);
+    if (existing) {
+      return existing->data.second;
     }
-    // std::cout<<root<<std::endl;
-    return (*find(key)).second;
+    Node *node = create_node(nullptr, parent, nullptr, {key, {}});
+    attach(node, parent);
+    return node->data.second;
   }
 
   // Удаляет элемент по ключу и возвращает значение удаленного элемента
@@ -209,113 +837,185 @@ public:
   //             {5, "five"}, {6,"six"  }
   //   }; результат после erase
   bool erase(const Key &key) {
-    if (!root) {
+    auto [node, parent] = find_slot(key);
+    if (!node) {
       return false;
     }
-    Node *current = root;
-    while (current) {
-      if (key == current->data.first) {
-        // no child nodes
-        if (!current->left && !current->right) {
-          delete current;
-          root = nullptr;
-          break;
-        }
-        // has 1 left node
-        if (current->left && !current->right) {
-          // has parent
-          if (current->parent) {
-            if (current->data.first < current->parent->data.first) {
-              current->parent->left = current->left;
-              current->right->parent = current->parent;
-              delete current;
-              break;
-            } else {
-              current->parent->right = current->left;
-              current->left->parent = current->parent;
-              delete current;
-              break;
-            } // doesn't have parent
-          } else {
-            root = current->left;
-            return true;
-          }
-        }// the same for right
-        if (current->right && !current->left){
-        if (current->parent) {
-          if (current->data.first > current->parent->data.first) {
-            current->parent->right = current->right;
-            current->right->parent = current->parent;
-            delete current;
-            break;
-          } else {
-            current->parent->left = current->right;
-            current->right->parent = current->parent;
-            delete current;
-            break;
-          } // doesn't have parent
-        } else {
-          root = current->right;
-          return true;
-        } }// ends here
-
-        // the case where its needed to find successor
-        if (current->left && current->right) {
-          Node *successor = current;
-          successor = successor->right;
-          while (successor->left) {
-            successor = successor->left;
-          }
-
-          std::swap(current->data, successor->data);
-
-          if (successor->right) {
-            successor->parent->left = successor->right;
-            successor->right->parent = successor->parent;
-          }
-        }
+    unlink(node);
+    destroy_node(node);
+    return true;
+  }
 
-        delete current;
-        return true;
-      } else if (key > current->data.first) { // x on the right side
-        current = root->right;
-      } else { // x on the left side
-        current = root->left;
+  // Вынимает элемент из словаря вместе с его узлом: ни память, ни пара не
+  // копируются и не освобождаются. Узел можно вставить в другой словарь
+  // (insert(node_type&&)) или изменить ключ и вернуть обратно. Если ключа
+  // нет, возвращает пустой node_type
+  //  auto node = active.extract(42);
+  //  if (node) expired.insert(std::move(node));
+  node_type extract(const Key &key) {
+    auto [node, parent] = find_slot(key);
+    if (node) {
+      unlink(node);
+    }
+    return node_type{node, alloc};
+  }
+
+  // То же для элемента под итератором (не end())
+  node_type extract(Iterator pos) {
+    unlink(pos.node);
+    return node_type{pos.node, alloc};
+  }
+
+  // Вставляет узел, вынутый extract, без выделения памяти. Если ключ уже
+  // есть, узел остается в возвращаемом node (его можно вставить еще куда-то)
+  // и position указывает на существующий элемент. Аллокаторы словаря и
+  // узла должны быть равны
+  insert_return_type insert(node_type &&handle) {
+    if (!handle) {
+      return {end(), false, node_type{nullptr, alloc}};
+    }
+    assert(handle.alloc == alloc);
+    auto [existing, parent] = find_slot(handle.key());
+    if (existing) {
+      return {Iterator{existing}, false, std::move(handle)};
+    }
+    Node *node = std::exchange(handle.node, nullptr);
+    attach(node, parent);
+    return {Iterator{node}, true, node_type{nullptr, alloc}};
+  }
+
+  // Переносит из other все элементы, ключей которых здесь нет, перевешивая
+  // их узлы. Элементы с совпадающими ключами остаются в other. Ссылки и
+  // итераторы на перенесенные элементы остаются валидными, но указывают уже
+  // в этот словарь. Аллокаторы должны быть равны [O(m log(n + m))]
+  void merge(Map &other) {
+    if (&other == this) {
+      return;
+    }
+    assert(other.alloc == alloc);
+    // Повороты в other не меняют порядок оставшихся узлов, поэтому
+    // следующий узел можно взять до переноса текущего
+    for (Node *node = other.begin().node; node;) {
+      Node *next = successor(node);
+      auto [existing, parent] = find_slot(node->data.first);
+      if (!existing) {
+        other.unlink(node);
+        attach(node, parent);
       }
+      node = next;
     }
-    return false;
   }
 
+  void merge(Map &&other) { merge(other); }
+
   // Меняет текуший контейнер с контейнером other
-  void swap(Map &other) { std::swap(root, other.root); }
+  void swap(Map &other) {
+    std::swap(root, other.root);
+    std::swap(s, other.s);
+    std::swap(alloc, other.alloc);
+  }
 
   // Возвращает итератор на первый элемент который не меньше чем переданный
-  // ключ. [O(h)]
-  Iterator lower_bound(const Key &key) {
-    if (!root) {
-      return end();
+  // ключ (end(), если такого нет). [O(log n)]
+  Iterator lower_bound(const Key &key) { return Iterator{lower_bound_node(key)}; }
+
+  ConstIterator lower_bound(const Key &key) const {
+    return ConstIterator{lower_bound_node(key)};
+  }
+
+  // Итератор на первый элемент с ключом больше key (end(), если такого
+  // нет) [O(log n)]
+  Iterator upper_bound(const Key &key) { return Iterator{upper_bound_node(key)}; }
+
+  ConstIterator upper_bound(const Key &key) const {
+    return ConstIterator{upper_bound_node(key)};
+  }
+
+  // Диапазон элементов с ключом key: {lower_bound(key), upper_bound(key)}
+  std::pair<Iterator, Iterator> equal_range(const Key &key) {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  std::pair<ConstIterator, ConstIterator> equal_range(const Key &key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  // Вызывает fn(pair) для элементов с ключами из [lo, hi) по возрастанию.
+  // Поддеревья вне диапазона не посещаются [O(log n + k)]
+  //  events.for_each_in_range(from, to, [&](auto &event) { ... });
+  template <class F>
+  void for_each_in_range(const Key &lo, const Key &hi, F &&fn) {
+    for (Node *node = lower_bound_node(lo); node && node->data.first < hi;
+         node = successor(node)) {
+      fn(node->data);
     }
-    auto current = root;
+  }
 
-    while (current) {
-      if (current->right && key > current->data.first) {
-        current = root->right;
-      } else if (current->left && key < current->data.first) {
-        current = root->left;
+  template <class F>
+  void for_each_in_range(const Key &lo, const Key &hi, F &&fn) const {
+    for (Node *node = lower_bound_node(lo); node && node->data.first < hi;
+         node = successor(node)) {
+      fn(std::as_const(node->data));
+    }
+  }
+
+  // Удаляет элементы с ключами из [lo, hi) и возвращает их число. Дерево
+  // разрезается по lo и hi, средняя часть освобождается целиком, остатки
+  // склеиваются - без поиска и перебалансировки на каждый ключ
+  // [O(k + log^2 n)]
+  //  sessions.erase_range(0, now - ttl);  // все, что старше ttl
+  std::size_t erase_range(const Key &lo, const Key &hi) {
+    Node *first = lower_bound_node(lo);
+    if (!first || !(first->data.first < hi)) {
+      return 0;
+    }
+    return cut(lo, &hi);
+  }
+
+  // Удаляет элементы [first, last) так же, как erase_range, и возвращает
+  // last. Итераторы на остальные элементы остаются валидными
+  Iterator erase(Iterator first, Iterator last) {
+    if (first != last) {
+      cut(first.node->data.first, last.node ? &last.node->data.first : nullptr);
+    }
+    return last;
+  }
+
+  // Высота дерева (0 для пустого). Не больше 2 log2(size() + 1) [O(n)]
+  std::size_t height() const { return height(root); }
+
+  // Итератор на k-й по возрастанию элемент (с нуля) или end(), если
+  // k >= size(). Только для Map<..., true> (OrderStatistics) [O(log n)]
+  //  Map<int, int, std::allocator<std::pair<const int, int>>, true> latencies;
+  //  auto p99 = latencies.nth(latencies.size() * 99 / 100);
+  Iterator nth(std::size_t k) { return Iterator{nth_node(k)}; }
+
+  ConstIterator nth(std::size_t k) const { return ConstIterator{nth_node(k)}; }
+
+  // Сколько в словаре ключей меньше key (позиция key, если он есть).
+  // Только для Map<..., true> (OrderStatistics) [O(log n)]
+  std::size_t rank(const Key &key) const {
+    static_assert(OrderStatistics, "rank requires Map<Key, Value, Allocator, true>");
+    std::size_t result = 0;
+    for (Node *current = root; current;) {
+      if (current->data.first < key) {
+        result += subtree_size(current->left) + 1;
+        current = current->right;
       } else {
-        break;
+        current = current->left;
       }
     }
-    return current;
+    return result;
   }
 
-  void clear(Node *node) {
+  // Уничтожает поддерево node, возвращает число удаленных узлов
+  std::size_t clear(Node *node) {
     if (node == nullptr) {
-      return;
+      return 0;
     }
-    clear(node->left);
-    clear(node->right);
-    delete node;
+    std::size_t removed = clear(node->left) + clear(node->right) + 1;
+    destroy_node(node);
+    return removed;
   }
   // Очищает контейнер [O(n)]
   // Map<int, std::string> c =
@@ -328,10 +1028,12 @@ public:
   void clear() {
     clear(root);
     root = nullptr;
+    s = 0;
   }
 
   class Iterator {
   private:
+    friend Map;
     Node *node;
 
   public:
@@ -344,38 +1046,13 @@ public:
     Iterator(Node *node) : node{node} {}
     // Инкремент. Движение к следующему элементу.
     Iterator &operator++() {
-
-      // one to the right child then down to the left bottom
-      if (node->right) {
-        node = node->right;
-        while (node && node->left) {
-          node = node->left;
-        }
-      }
-      // up to parent which was not iterated
-      else {
-        while (node->parent && node->data.first > node->parent->data.first) {
-          node = node->parent;
-        }
-        node = node->parent;
-      }
+      node = successor(node);
       return *this;
     }
 
     // Декремент. Движение к предыдущему элементу.
     Iterator &operator--() {
-      // one to the left parent then to the right
-      if (node->left) {
-        node = node->left;
-        while (node && node->right) {
-          node = node->right;
-        }
-      } else {
-        while (node->data.first < node->parent.data.first) {
-          node = node->parent;
-        }
-        node = node->parent;
-      }
+      node = predecessor(node);
       return *this;
     }
 
@@ -401,37 +1078,12 @@ public:
     ConstIterator(Node *node) : node{node} {}
 
     ConstIterator &operator++() {
-     
-      // one to the right child then down to the left bottom
-      if (node->right) {
-        node = node->right;
-        while (node && node->left) {
-          node = node->left;
-        }
-      }
-      // up to parent which was not iterated
-      else {
-        while (node->parent && node->data.first > node->parent->data.first) {
-          node = node->parent;
-        }
-        node = node->parent;
-      }
+      node = successor(node);
       return *this;
     }
 
     ConstIterator &operator--() {
-      // one to the left parent then to the right
-      if (node->left) {
-        node = node->left;
-        while (node && node->right) {
-          node = node->right;
-        }
-      } else {
-        while (node->data.first < node->parent.data.first) {
-          node = node->parent;
-        }
-        node = node->parent;
-      }
+      node = predecessor(node);
       return *this;
     }
 
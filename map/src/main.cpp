@@ -1,3 +1,4 @@
+#include "btree_map.hpp"
 #include "map.hpp"
 
 int main(){
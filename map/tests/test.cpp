@@ -1,3 +1,11 @@
+#include <cmath>
+#include <map>
+#include <memory>
+#include <new>
+#include <random>
+#include <vector>
+
+#include "btree_map.hpp"
 #include "map.hpp"
 
 
@@ -165,6 +173,594 @@ void test_lower_bound_equal() {
   assert(*map.lower_bound("c") == expected);
 }
 
+void test_erase_inner_nodes() {
+  Map<int, int> map;
+  for (int key : {50, 30, 70, 20, 40, 60, 80, 35, 45, 65}) {
+    map[key] = key * 10;
+  }
+  assert(map.erase(30));  // два потомка, преемник не прямой потомок
+  assert(map.erase(50));  // корень
+  assert(map.erase(20));  // лист
+  assert(map.erase(60));  // один потомок
+  assert(!map.erase(50));
+  assert(map.size() == 6);
+  int previous = 0;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    assert((*it).first > previous);
+    assert((*it).second == (*it).first * 10);
+    previous = (*it).first;
+  }
+}
+
+void test_extract_insert_node() {
+  Map<int, std::string> active;
+  Map<int, std::string> expired;
+  active[1] = "one";
+  active[2] = "two";
+  active[3] = "three";
+  std::string *value = &active[2];
+
+  auto node = active.extract(2);
+  assert(node && node.key() == 2 && node.mapped() == "two");
+  assert(!active.contains(2) && active.size() == 2);
+  assert(!active.extract(10));
+
+  auto result = expired.insert(std::move(node));
+  assert(result.inserted && !result.node);
+  assert((*result.position).first == 2);
+  // узел перевешен, а не скопирован
+  assert(&expired[2] == value);
+}
+
+void test_insert_node_existing_key() {
+  Map<int, std::string> map;
+  map[1] = "old";
+  Map<int, std::string> other;
+  other[1] = "new";
+
+  auto result = map.insert(other.extract(1));
+  assert(!result.inserted);
+  assert(result.node && result.node.mapped() == "new");
+  assert(map[1] == "old");
+
+  result.node.key() = 5;
+  assert(map.insert(std::move(result.node)).inserted);
+  assert(map[5] == "new");
+  assert(!map.insert(Map<int, std::string>::node_type{}).inserted);
+}
+
+void test_merge() {
+  Map<int, int> map;
+  Map<int, int> other;
+  for (int i = 0; i < 10; i += 2) {
+    map[i] = i;
+  }
+  for (int i = 0; i < 10; i++) {
+    other[i] = -i;
+  }
+  int *moved = &other[3];
+  map.merge(other);
+
+  assert(map.size() == 10);
+  assert(other.size() == 5);
+  assert(&map[3] == moved);
+  for (int i = 0; i < 10; i++) {
+    assert(map[i] == (i % 2 == 0 ? i : -i));
+    assert(other.contains(i) == (i % 2 == 0));
+  }
+}
+
+// Высота красно-черного дерева не больше 2 log2(n + 1)
+bool balanced(const Map<int, int> &map, std::size_t size) {
+  return static_cast<double>(map.height()) <= 2 * std::log2(static_cast<double>(size) + 1);
+}
+
+void test_sorted_inserts_balanced() {
+  const int count = 100000;
+  Map<int, int> ascending;
+  Map<int, int> descending;
+  for (int i = 0; i < count; i++) {
+    ascending[i] = i;
+    descending[count - i] = i;
+  }
+  assert(balanced(ascending, count));
+  assert(balanced(descending, count));
+  for (int i = 0; i < count; i++) {
+    assert(ascending[i] == i);
+  }
+  for (int i = 0; i < count; i += 2) {
+    assert(ascending.erase(i));
+  }
+  assert(balanced(ascending, count / 2));
+  assert(ascending.size() == count / 2);
+}
+
+void test_random_operations_match_std_map() {
+  Map<int, int> map;
+  std::map<int, int> expected;
+  std::mt19937 random(42);
+  for (int i = 0; i < 20000; i++) {
+    int key = static_cast<int>(random() % 2000);
+    switch (random() % 3) {
+    case 0:
+      map[key] = i;
+      expected[key] = i;
+      break;
+    case 1:
+      assert(map.erase(key) == (expected.erase(key) == 1));
+      break;
+    default: {
+      auto node = map.extract(key);
+      assert(static_cast<bool>(node) == (expected.count(key) == 1));
+      if (node) {
+        node.key() = 2000 + i;
+        expected.erase(key);
+        expected[node.key()] = node.mapped();
+        assert(map.insert(std::move(node)).inserted);
+      }
+    }
+    }
+    if (i % 1000 == 0) {
+      auto it = map.begin();
+      for (const auto &[k, v] : expected) {
+        assert(it != map.end() && (*it).first == k && (*it).second == v);
+        ++it;
+      }
+      assert(it == map.end());
+      assert(balanced(map, expected.size()));
+    }
+  }
+}
+
+void test_lower_bound_missing() {
+  Map<int, int> map;
+  assert(map.lower_bound(1) == map.end());
+  for (int i = 0; i < 100; i += 10) {
+    map[i] = i;
+  }
+  assert((*map.lower_bound(-5)).first == 0);
+  assert((*map.lower_bound(40)).first == 40);
+  assert((*map.lower_bound(41)).first == 50);
+  assert(map.lower_bound(91) == map.end());
+  const Map<int, int> &const_map = map;
+  assert((*const_map.lower_bound(55)).first == 60);
+}
+
+void test_iterator_decrement() {
+  Map<int, int> map;
+  for (int i = 1; i <= 50; i++) {
+    map[i] = i;
+  }
+  auto it = map.find(50);
+  for (int i = 50; i > 1; i--) {
+    assert((*it).first == i);
+    --it;
+  }
+  assert(it == map.begin());
+}
+
+void test_btree_operator_brackets() {
+  BTreeMap<std::string, std::string> map;
+  map["Nikolay"] = "teacher";
+  assert(map["Nikolay"] == "teacher");
+  assert(map["missing"] == "");
+  assert(map.size() == 2);
+
+  const BTreeMap<std::string, std::string> &const_map = map;
+  bool exception_thrown{};
+  try {
+    const_map["other"];
+  } catch (const std::out_of_range &) {
+    exception_thrown = true;
+  }
+  assert(exception_thrown);
+}
+
+void test_btree_iteration_order() {
+  // Маленькие узлы, чтобы дерево было многоуровневым
+  BTreeMap<int, int, 64> map;
+  const int count = 5000;
+  for (int i = 0; i < count; i++) {
+    map[(i * 7919) % count] = i;
+  }
+  assert(map.size() == count);
+  assert(map.height() > 2);
+  int expected = 0;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    assert((*it).first == expected++);
+  }
+  assert(expected == count);
+  auto it = map.find(count - 1);
+  for (int key = count - 1; key > 0; key--) {
+    assert(it->first == key);
+    --it;
+  }
+  assert(it == map.begin());
+}
+
+void test_btree_random_operations_match_std_map() {
+  BTreeMap<int, std::string, 128> map;
+  std::map<int, std::string> expected;
+  std::mt19937 random(7);
+  for (int i = 0; i < 50000; i++) {
+    int key = static_cast<int>(random() % 3000);
+    if (random() % 2 == 0) {
+      map[key] = std::to_string(i);
+      expected[key] = std::to_string(i);
+    } else {
+      assert(map.erase(key) == (expected.erase(key) == 1));
+    }
+    assert(map.size() == expected.size());
+    if (i % 2500 == 0) {
+      auto it = map.begin();
+      for (const auto &[k, v] : expected) {
+        assert(it != map.end() && it->first == k && it->second == v);
+        ++it;
+      }
+      assert(it == map.end());
+    }
+  }
+  for (const auto &[k, v] : expected) {
+    assert(map.erase(k));
+  }
+  assert(map.empty() && map.height() == 0 && map.begin() == map.end());
+}
+
+// Ключ без конструктора по умолчанию; считает живые объекты, чтобы
+// проверить, что каждый созданный в узлах ключ ровно один раз уничтожается
+struct BTreeKey {
+  static inline int alive = 0;
+  int value;
+
+  explicit BTreeKey(int value) : value{value} { ++alive; }
+  BTreeKey(const BTreeKey &other) : value{other.value} { ++alive; }
+  BTreeKey &operator=(const BTreeKey &) = default;
+  ~BTreeKey() { --alive; }
+
+  bool operator<(const BTreeKey &other) const { return value < other.value; }
+};
+
+void test_btree_key_without_default_constructor() {
+  {
+    BTreeMap<BTreeKey, std::string, 128> map;
+    std::map<int, std::string> expected;
+    std::mt19937 random(11);
+    for (int i = 0; i < 20000; i++) {
+      int key = static_cast<int>(random() % 1000);
+      if (random() % 2 == 0) {
+        map[BTreeKey{key}] = std::to_string(i);
+        expected[key] = std::to_string(i);
+      } else {
+        assert(map.erase(BTreeKey{key}) == (expected.erase(key) == 1));
+      }
+    }
+    BTreeMap<BTreeKey, std::string, 128> copied{map};
+    auto it = copied.begin();
+    for (const auto &[k, v] : expected) {
+      assert(it != copied.end() && it->first.value == k && it->second == v);
+      ++it;
+    }
+    assert(it == copied.end());
+  }
+  assert(BTreeKey::alive == 0);
+}
+
+void test_btree_lower_bound() {
+  BTreeMap<int, int, 64> map;
+  assert(map.lower_bound(0) == map.end());
+  for (int i = 0; i < 1000; i += 10) {
+    map[i] = i;
+  }
+  for (int key = -5; key < 1000; key++) {
+    auto it = map.lower_bound(key);
+    int expected = key <= 0 ? 0 : (key + 9) / 10 * 10;
+    if (expected >= 1000) {
+      assert(it == map.end());
+    } else {
+      assert(it->first == expected);
+    }
+  }
+}
+
+// Аллокатор с общим лимитом выделений: когда лимит кончается, бросает
+// std::bad_alloc (-1 - без лимита)
+long allocation_budget = -1;
+
+template <class T>
+struct LimitedAllocator {
+  using value_type = T;
+
+  LimitedAllocator() = default;
+  template <class U>
+  LimitedAllocator(const LimitedAllocator<U> &) {}
+
+  T *allocate(std::size_t n) {
+    if (allocation_budget == 0) {
+      throw std::bad_alloc();
+    }
+    if (allocation_budget > 0) {
+      --allocation_budget;
+    }
+    return std::allocator<T>{}.allocate(n);
+  }
+
+  void deallocate(T *p, std::size_t n) { std::allocator<T>{}.deallocate(p, n); }
+
+  template <class U>
+  bool operator==(const LimitedAllocator<U> &) const { return true; }
+  template <class U>
+  bool operator!=(const LimitedAllocator<U> &) const { return false; }
+};
+
+void test_btree_insert_out_of_memory() {
+  using LimitedMap = BTreeMap<int, int, 64, LimitedAllocator<std::pair<const int, int>>>;
+  std::mt19937 random(5);
+  for (long budget = 0; budget < 60; budget++) {
+    LimitedMap map;
+    std::map<int, int> expected;
+    allocation_budget = budget;
+    bool thrown = false;
+    try {
+      for (int i = 0; i < 5000; i++) {
+        int key = static_cast<int>(random() % 100000);
+        map[key] = i;
+        expected[key] = i;
+      }
+    } catch (const std::bad_alloc &) {
+      thrown = true;
+    }
+    allocation_budget = -1;
+    assert(thrown);
+    // Неудачная вставка не оставила ни полуразделенных листов, ни лишнего size()
+    assert(map.size() == expected.size());
+    auto it = map.begin();
+    for (auto [key, value] : expected) {
+      assert(it != map.end() && it->first == key && it->second == value);
+      assert(map.find(key) == it);
+      ++it;
+    }
+    assert(it == map.end());
+    for (int i = 0; i < 2000; i++) {
+      map[i] = i;
+      expected[i] = i;
+    }
+    assert(map.size() == expected.size() && map.find(1999)->second == 1999);
+  }
+}
+
+void test_btree_copy_and_move() {
+  BTreeMap<int, std::string, 64> map;
+  for (int i = 0; i < 500; i++) {
+    map[i] = std::to_string(i);
+  }
+  BTreeMap<int, std::string, 64> copied{map};
+  map[0] = "changed";
+  assert(copied[0] == "0" && copied.size() == 500);
+  int expected = 0;
+  for (auto it = copied.begin(); it != copied.end(); ++it) {
+    assert(it->first == expected && it->second == std::to_string(expected));
+    ++expected;
+  }
+
+  BTreeMap<int, std::string, 64> moved{std::move(copied)};
+  assert(copied.empty() && copied.begin() == copied.end());
+  assert(moved.size() == 500 && moved.contains(499));
+  copied = moved;
+  assert(copied.size() == 500);
+  moved.clear();
+  assert(moved.empty() && !moved.contains(1) && copied.contains(1));
+}
+
+void test_size_tracks_every_change() {
+  Map<int, int> map;
+  Map<int, int> other;
+  for (int i = 0; i < 10; i++) {
+    map[i] = i;
+    other[i + 5] = i;
+  }
+  assert(map.size() == 10 && other.size() == 10);
+  map.erase(0);
+  auto node = map.extract(1);
+  assert(map.size() == 8);
+  other.insert(std::move(node));
+  assert(other.size() == 11);
+  map.merge(other);  // 10..14 и 1 переезжают, 5..9 остаются
+  assert(map.size() == 14 && other.size() == 5);
+  Map<int, int> copied{map};
+  assert(copied.size() == 14);
+  copied.swap(other);
+  assert(copied.size() == 5 && other.size() == 14);
+  other.clear();
+  assert(other.size() == 0);
+}
+
+void test_nth_and_rank() {
+  using StatMap = Map<int, int, std::allocator<std::pair<const int, int>>, true>;
+  StatMap map;
+  std::vector<int> keys;
+  std::mt19937 random(3);
+  for (int i = 0; i < 20000; i++) {
+    int key = static_cast<int>(random() % 5000) * 2;
+    if (random() % 3 == 0) {
+      map.erase(key);
+    } else {
+      map[key] = i;
+    }
+    if (i % 1000 == 0) {
+      keys.clear();
+      for (auto it = map.begin(); it != map.end(); ++it) {
+        keys.push_back((*it).first);
+      }
+      assert(keys.size() == map.size());
+      for (std::size_t k = 0; k < keys.size(); k++) {
+        assert((*map.nth(k)).first == keys[k]);
+        assert(map.rank(keys[k]) == k);
+        // нечетных ключей нет: rank считает меньшие
+        assert(map.rank(keys[k] + 1) == k + 1);
+      }
+      assert(map.nth(keys.size()) == map.end());
+      assert(map.rank(-1) == 0);
+    }
+  }
+
+  StatMap moved;
+  moved.merge(map);
+  assert(map.size() == 0 && map.nth(0) == map.end());
+  const StatMap copied{moved};
+  assert((*copied.nth(copied.size() / 2)).first == (*moved.nth(moved.size() / 2)).first);
+  assert(copied.rank(10000) == copied.size());
+}
+
+void test_upper_bound_and_equal_range() {
+  Map<int, int> map;
+  for (int i = 0; i < 100; i += 10) {
+    map[i] = i;
+  }
+  assert((*map.upper_bound(20)).first == 30);
+  assert((*map.upper_bound(25)).first == 30);
+  assert((*map.upper_bound(-5)).first == 0);
+  assert(map.upper_bound(90) == map.end());
+
+  auto [first, last] = map.equal_range(40);
+  assert((*first).first == 40 && (*last).first == 50);
+  auto [missing_first, missing_last] = map.equal_range(45);
+  assert(missing_first == missing_last && (*missing_first).first == 50);
+
+  const Map<int, int> &view = map;
+  assert((*view.upper_bound(0)).first == 10);
+  assert(view.equal_range(100).first == view.end());
+}
+
+void test_for_each_in_range() {
+  Map<int, int> map;
+  for (int i = 0; i < 1000; i++) {
+    map[i * 3] = i;
+  }
+  std::vector<int> seen;
+  map.for_each_in_range(100, 200, [&](auto &pair) {
+    seen.push_back(pair.first);
+    pair.second = -1;
+  });
+  assert(seen.size() == 33 && seen.front() == 102 && seen.back() == 198);
+  assert(map[102] == -1 && map[99] == 33 && map[201] == 67);
+
+  int count = 0;
+  const Map<int, int> &view = map;
+  view.for_each_in_range(5000, 6000, [&](const auto &) { count++; });
+  view.for_each_in_range(200, 100, [&](const auto &) { count++; });
+  assert(count == 0);
+}
+
+// Сверяет словарь с эталоном: ключи, size, nth и высоту
+template <class StatMap>
+void check_same(StatMap &map, const std::map<int, int> &expected) {
+  assert(map.size() == expected.size());
+  std::size_t k = 0;
+  for (auto [key, value] : expected) {
+    assert((*map.nth(k)).first == key && (*map.nth(k)).second == value);
+    k++;
+  }
+  assert(map.nth(k) == map.end());
+  assert(map.height() <= 2 * std::log2(map.size() + 1));
+}
+
+void test_erase_range_matches_std_map() {
+  using StatMap = Map<int, int, std::allocator<std::pair<const int, int>>, true>;
+  std::mt19937 random(11);
+  for (int round = 0; round < 200; round++) {
+    StatMap map;
+    std::map<int, int> expected;
+    int n = static_cast<int>(random() % 500);
+    for (int i = 0; i < n; i++) {
+      int key = static_cast<int>(random() % 1000);
+      map[key] = i;
+      expected[key] = i;
+    }
+    for (int step = 0; step < 5; step++) {
+      int lo = static_cast<int>(random() % 1100) - 50;
+      int hi = lo + static_cast<int>(random() % 300);
+      std::size_t removed = map.erase_range(lo, hi);
+      auto first = expected.lower_bound(lo);
+      auto last = expected.lower_bound(hi);
+      assert(removed == static_cast<std::size_t>(std::distance(first, last)));
+      expected.erase(first, last);
+      check_same(map, expected);
+      // после склейки дерево снова растет как обычно
+      int key = static_cast<int>(random() % 1000);
+      map[key] = step;
+      expected[key] = step;
+      check_same(map, expected);
+    }
+  }
+}
+
+void test_erase_iterator_range() {
+  Map<int, int> map;
+  for (int i = 0; i < 1000; i++) {
+    map[i] = i;
+  }
+  auto kept = map.find(700);
+  auto next = map.erase(map.find(100), map.find(700));
+  assert(next == kept && (*next).first == 700);
+  assert(map.size() == 400 && !map.contains(100) && !map.contains(699));
+  assert(map.contains(99) && (*kept).second == 700);
+
+  assert(map.erase(map.find(50), map.find(50)) == map.find(50));
+  assert(map.size() == 400);
+
+  assert(map.erase(map.find(900), map.end()) == map.end());
+  assert(map.size() == 300 && map.contains(899) && !map.contains(900));
+
+  map.erase(map.begin(), map.end());
+  assert(map.size() == 0 && map.begin() == map.end());
+  map[5] = 5;
+  assert(map.size() == 1 && map[5] == 5);
+  assert(map.erase_range(10, 0) == 0 && map.erase_range(6, 10) == 0);
+  assert(map.erase_range(0, 10) == 1 && map.size() == 0);
+}
+
+void test_from_sorted() {
+  using StatMap = Map<int, int, std::allocator<std::pair<const int, int>>, true>;
+  for (int n : {0, 1, 2, 3, 7, 8, 100, 1000, 4095, 4096}) {
+    std::vector<std::pair<int, int>> pairs;
+    std::map<int, int> expected;
+    for (int i = 0; i < n; i++) {
+      pairs.push_back({i * 2, i});
+      expected[i * 2] = i;
+    }
+    auto map = StatMap::from_sorted(pairs.begin(), pairs.end());
+    check_same(map, expected);
+    // идеально сбалансировано: высота минимально возможная
+    assert(map.height() == static_cast<std::size_t>(std::ceil(std::log2(n + 1))));
+    // дальше словарь ведет себя как обычный
+    for (int i = 0; i < n; i += 3) {
+      map.erase(i * 2);
+      expected.erase(i * 2);
+      map[i * 2 + 1] = -i;
+      expected[i * 2 + 1] = -i;
+    }
+    check_same(map, expected);
+  }
+}
+
+void test_assign_sorted() {
+  Map<std::string, int> map;
+  map["old"] = 1;
+  std::map<std::string, int> snapshot{{"a", 1}, {"b", 2}, {"c", 3}};
+  map.assign_sorted(snapshot.begin(), snapshot.end());
+  assert(map.size() == 3 && !map.contains("old"));
+  assert(map["a"] == 1 && map["c"] == 3);
+  map["d"] = 4;
+  std::vector<std::string> keys;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    keys.push_back((*it).first);
+  }
+  assert((keys == std::vector<std::string>{"a", "b", "c", "d"}));
+
+  map.assign_sorted(snapshot.end(), snapshot.end());
+  assert(map.size() == 0 && map.begin() == map.end());
+}
+
 int main() {
 
   test_operator_brackets_simple();
@@ -188,7 +784,36 @@ int main() {
 
   test_erase_simple();
    test_erase_returned_value();
+  test_erase_inner_nodes();
+
+  test_extract_insert_node();
+  test_insert_node_existing_key();
+  test_merge();
 
    test_lower_bound();
    test_lower_bound_equal();
+  test_lower_bound_missing();
+  test_iterator_decrement();
+
+  test_sorted_inserts_balanced();
+  test_random_operations_match_std_map();
+
+  test_size_tracks_every_change();
+  test_nth_and_rank();
+
+  test_upper_bound_and_equal_range();
+  test_for_each_in_range();
+  test_erase_range_matches_std_map();
+  test_erase_iterator_range();
+
+  test_from_sorted();
+  test_assign_sorted();
+
+  test_btree_operator_brackets();
+  test_btree_iteration_order();
+  test_btree_random_operations_match_std_map();
+  test_btree_key_without_default_constructor();
+  test_btree_lower_bound();
+  test_btree_copy_and_move();
+  test_btree_insert_out_of_memory();
 }
\ No newline at end of file
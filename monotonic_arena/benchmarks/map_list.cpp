@@ -0,0 +1,82 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "monotonic_arena.hpp"
+
+#include "doubly_linked_list.hpp"
+#include "map.hpp"
+
+// Сравнивает вставку в Map и List с узлами из new/delete (std::allocator)
+// и из MonotonicArena. Время включает уничтожение контейнера.
+// ./bench_map_list [count]
+namespace {
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+template <class MapType>
+void fill_map(MapType &map, const std::vector<int> &keys) {
+  for (int key : keys) {
+    map[key] = key;
+  }
+  if (map.size() == 0) {
+    std::abort();
+  }
+}
+
+template <class ListType>
+void fill_list(ListType &list, std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) {
+    list.push_back(static_cast<int>(i));
+  }
+  if (list.size() != count) {
+    std::abort();
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+  // Случайные ключи: Map пока не балансируется
+  std::vector<int> keys(count);
+  std::mt19937 gen{42};
+  for (auto &key : keys) {
+    key = static_cast<int>(gen());
+  }
+
+  using MapAllocator = ArenaAllocator<std::pair<const int, int>>;
+
+  double map_new = measure_ms([&] {
+    Map<int, int> map;
+    fill_map(map, keys);
+  });
+  double map_arena = measure_ms([&] {
+    MonotonicArena arena{1 << 16};
+    Map<int, int, MapAllocator> map{MapAllocator{arena}};
+    fill_map(map, keys);
+  });
+  std::cout << "Map insert " << count << ": new " << map_new << " ms, arena "
+            << map_arena << " ms" << std::endl;
+
+  double list_new = measure_ms([&] {
+    List<int> list;
+    fill_list(list, count);
+  });
+  double list_arena = measure_ms([&] {
+    MonotonicArena arena{1 << 16};
+    List<int, ArenaAllocator<int>> list{ArenaAllocator<int>{arena}};
+    fill_list(list, count);
+  });
+  std::cout << "List push_back " << count << ": new " << list_new
+            << " ms, arena " << list_arena << " ms" << std::endl;
+}
@@ -0,0 +1,149 @@
+#ifndef MONOTONIC_ARENA_H
+#define MONOTONIC_ARENA_H
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+// Арена с монотонным ростом: память раздается последовательно из больших
+// блоков, deallocate ничего не делает, вся память освобождается разом в
+// release() или в деструкторе арены. Подходит для данных, которые живут
+// ровно столько же, сколько запрос/задача.
+class MonotonicArena {
+private:
+  struct Block {
+    Block *next;
+    std::size_t size;
+  };
+
+  Block *blocks{nullptr};
+  // Внешний буфер (если арена создана поверх него). Арена его не освобождает
+  void *initial_buffer{nullptr};
+  std::size_t initial_size{0};
+
+  char *current{nullptr};
+  std::size_t left{0};
+  std::size_t first_block_size;
+  std::size_t next_block_size;
+  std::size_t reserved{0};
+
+  // Выделяет новый блок, в котором точно поместятся bytes с выравниванием
+  // alignment. Размеры блоков растут геометрически
+  void grow(std::size_t bytes, std::size_t alignment) {
+    std::size_t size = next_block_size;
+    if (size < bytes + alignment) {
+      size = bytes + alignment;
+    }
+    void *memory = ::operator new(sizeof(Block) + size);
+    Block *block = static_cast<Block *>(memory);
+    block->next = blocks;
+    block->size = size;
+    blocks = block;
+
+    current = reinterpret_cast<char *>(block + 1);
+    left = size;
+    reserved += size;
+    next_block_size *= 2;
+  }
+
+public:
+  // Создает пустую арену, первый блок будет размера block_size байт
+  explicit MonotonicArena(std::size_t block_size = 4096)
+      : first_block_size{block_size ? block_size : 1},
+        next_block_size{first_block_size} {}
+
+  // Создает арену поверх внешнего буфера (например, на стеке). Когда буфер
+  // закончится, арена начнет выделять блоки в куче
+  MonotonicArena(void *buffer, std::size_t size)
+      : initial_buffer{buffer}, initial_size{size},
+        current{static_cast<char *>(buffer)}, left{size},
+        first_block_size{size ? size : 4096},
+        next_block_size{first_block_size} {}
+
+  MonotonicArena(const MonotonicArena &) = delete;
+  MonotonicArena &operator=(const MonotonicArena &) = delete;
+
+  ~MonotonicArena() { release(); }
+
+  // Возвращает bytes байт, выровненных по alignment
+  void *allocate(std::size_t bytes, std::size_t alignment) {
+    void *ptr = current;
+    if (!std::align(alignment, bytes, ptr, left)) {
+      grow(bytes, alignment);
+      ptr = current;
+      std::align(alignment, bytes, ptr, left);
+    }
+    current = static_cast<char *>(ptr) + bytes;
+    left -= bytes;
+    return ptr;
+  }
+
+  // Память отдельных объектов не освобождается
+  void deallocate(void *, std::size_t) noexcept {}
+
+  // Освобождает все блоки. Все указатели, полученные из арены, становятся
+  // недействительными
+  void release() noexcept {
+    while (blocks) {
+      Block *next = blocks->next;
+      ::operator delete(blocks);
+      blocks = next;
+    }
+    current = static_cast<char *>(initial_buffer);
+    left = initial_size;
+    next_block_size = first_block_size;
+    reserved = 0;
+  }
+
+  // Сколько байт арена выделила в куче
+  std::size_t bytes_reserved() const { return reserved; }
+};
+
+// Аллокатор для контейнеров (Vector, List, Map, UnorderedMap, std::...),
+// который берет память из MonotonicArena. Копии аллокатора ссылаются на ту
+// же арену, арена должна жить дольше контейнеров.
+// MonotonicArena arena;
+// Map<int, int, ArenaAllocator<std::pair<const int, int>>> map{arena};
+template <class T> class ArenaAllocator {
+private:
+  MonotonicArena *arena_;
+
+  template <class U> friend class ArenaAllocator;
+
+public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  ArenaAllocator(MonotonicArena &arena) noexcept : arena_{&arena} {}
+
+  template <class U>
+  ArenaAllocator(const ArenaAllocator<U> &other) noexcept
+      : arena_{other.arena_} {}
+
+  T *allocate(std::size_t n) {
+    if (n > static_cast<std::size_t>(-1) / sizeof(T)) {
+      throw std::bad_array_new_length{};
+    }
+    return static_cast<T *>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *ptr, std::size_t n) noexcept {
+    arena_->deallocate(ptr, n * sizeof(T));
+  }
+
+  MonotonicArena *arena() const noexcept { return arena_; }
+
+  template <class U> bool operator==(const ArenaAllocator<U> &other) const {
+    return arena_ == other.arena_;
+  }
+
+  template <class U> bool operator!=(const ArenaAllocator<U> &other) const {
+    return arena_ != other.arena_;
+  }
+};
+
+#endif
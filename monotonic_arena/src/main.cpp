@@ -0,0 +1,5 @@
+#include "monotonic_arena.hpp"
+
+int main() {
+    return 0;
+}
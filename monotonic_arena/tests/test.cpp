@@ -0,0 +1,112 @@
+#include <cassert>
+#include <cstdint>
+#include <string>
+
+#include "monotonic_arena.hpp"
+
+#include "doubly_linked_list.hpp"
+#include "map.hpp"
+#include "unordered_map.hpp"
+#include "vector.hpp"
+
+void test_alignment() {
+  MonotonicArena arena{64};
+  for (std::size_t alignment : {1, 2, 4, 8, 16, 32, 64, 128}) {
+    void *ptr = arena.allocate(3, alignment);
+    assert(reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0);
+  }
+}
+
+void test_grows_past_block() {
+  MonotonicArena arena{16};
+  char *first = static_cast<char *>(arena.allocate(8, 1));
+  char *big = static_cast<char *>(arena.allocate(1000, 1));
+  big[999] = 'x';
+  first[7] = 'y';
+  assert(arena.bytes_reserved() >= 1016);
+}
+
+void test_initial_buffer() {
+  alignas(std::max_align_t) char buffer[256];
+  MonotonicArena arena{buffer, sizeof(buffer)};
+  char *ptr = static_cast<char *>(arena.allocate(100, 8));
+  assert(ptr >= buffer && ptr < buffer + sizeof(buffer));
+  assert(arena.bytes_reserved() == 0);
+  arena.allocate(200, 8);
+  assert(arena.bytes_reserved() > 0);
+  arena.release();
+  assert(arena.allocate(16, 8) == buffer);
+}
+
+void test_allocator_equality() {
+  MonotonicArena first, second;
+  ArenaAllocator<int> a{first}, b{first}, c{second};
+  ArenaAllocator<double> rebound{a};
+  assert(a == b);
+  assert(a != c);
+  assert(rebound == a);
+}
+
+void test_vector_with_arena() {
+  MonotonicArena arena;
+  Vector<std::string, ArenaAllocator<std::string>> v{ArenaAllocator<std::string>{arena}};
+  for (int i = 0; i < 100; i++) {
+    v.push_back(std::to_string(i));
+  }
+  assert(v.size() == 100 && v[99] == "99");
+  assert(v.get_allocator().arena() == &arena);
+  assert(arena.bytes_reserved() > 0);
+}
+
+void test_list_with_arena() {
+  MonotonicArena arena;
+  List<int, ArenaAllocator<int>> list{ArenaAllocator<int>{arena}};
+  for (int i = 0; i < 100; i++) {
+    list.push_back(i);
+  }
+  assert(list.size() == 100 && list[42] == 42);
+  assert(list.pop_front() == 0);
+  List<int, ArenaAllocator<int>> copied{list};
+  assert(copied.size() == 99 && copied[0] == 1);
+  assert(copied.get_allocator() == list.get_allocator());
+}
+
+void test_map_with_arena() {
+  using Allocator = ArenaAllocator<std::pair<const int, std::string>>;
+  MonotonicArena arena;
+  Map<int, std::string, Allocator> map{Allocator{arena}};
+  map[2] = "two";
+  map[1] = "one";
+  map[3] = "three";
+  assert(map.size() == 3 && map[1] == "one");
+  Map<int, std::string, Allocator> copied{map};
+  assert(copied[3] == "three");
+  assert(copied.get_allocator().arena() == &arena);
+}
+
+void test_unordered_map_with_arena() {
+  using Allocator = ArenaAllocator<std::pair<const std::string, int>>;
+  MonotonicArena arena;
+  UnorderedMap<std::string, int, DefaultHash<std::string>, DefaultKeyEqual<std::string>,
+               Allocator>
+      map{Allocator{arena}};
+  for (int i = 0; i < 100; i++) {
+    map[std::to_string(i)] = i;
+  }
+  assert(map.size() == 100 && map["42"] == 42);
+  assert(map.erase("42"));
+  assert(!map.contains("42"));
+  assert(map.get_allocator().arena() == &arena);
+}
+
+int main() {
+  test_alignment();
+  test_grows_past_block();
+  test_initial_buffer();
+  test_allocator_equality();
+
+  test_vector_with_arena();
+  test_list_with_arena();
+  test_map_with_arena();
+  test_unordered_map_with_arena();
+}
@@ -1,4 +1,8 @@
+#ifndef STACK_H
+#define STACK_H
+
 #include <iostream>
+#include <stdexcept>
 #include <vector>
 
 template <class T>
@@ -36,3 +40,7 @@ public:
   // Меняет содержимое с другим стэком. s1.swap(s2);
   void swap(Stack& other);
 };
+
+#include "stack.ipp"
+
+#endif
@@ -1,4 +1,5 @@
-#include "stack.hpp"
+// Определения шаблонных методов Stack. Подключается в конце stack.hpp,
+// отдельно не включать
 
 template <class T>
 Stack<T>::Stack() = default;
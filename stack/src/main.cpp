@@ -1,3 +1,7 @@
+#include "stack.hpp"
+
+// Явная инстанциация проверяет, что все методы Stack компилируются
+template class Stack<int>;
 
 int main() {
   return 0;
@@ -0,0 +1,106 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "unordered_map.hpp"
+
+// Поиск в словаре, который намного больше кеша последнего уровня: по
+// одному ключу (find в цикле) против find_batch/contains_batch пакетами
+// разного размера. При поиске по одному каждый ключ ждет свои промахи
+// кеша (корзина, затем узел) по очереди, пакетный поиск запрашивает память
+// для многих ключей сразу.
+// ./bench_batch [count] [lookups] [batch...]
+namespace {
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+std::uint64_t splitmix(std::uint64_t &state) {
+  std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  std::size_t lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10000000;
+  std::vector<std::size_t> batches;
+  for (int i = 3; i < argc; i++) {
+    batches.push_back(std::strtoull(argv[i], nullptr, 10));
+  }
+  if (batches.empty()) {
+    batches = {64, 256, 1024};
+  }
+
+  using Map = UnorderedMap<std::uint64_t, std::uint64_t>;
+  Map map;
+  std::vector<std::uint64_t> keys;
+  keys.reserve(count);
+  std::uint64_t state = 1;
+  for (std::size_t i = 0; i < count; i++) {
+    keys.push_back(splitmix(state));
+    map[keys.back()] = i;
+  }
+  // Половина запросов - существующие ключи, половина - отсутствующие
+  std::vector<std::uint64_t> queries;
+  queries.reserve(lookups);
+  std::uint64_t query_state = 2;
+  for (std::size_t i = 0; i < lookups; i++) {
+    std::uint64_t r = splitmix(query_state);
+    queries.push_back(r & 1 ? keys[r % count] : r);
+  }
+  std::cout << count << " keys, " << lookups << " lookups" << std::endl;
+  const double ops = static_cast<double>(lookups);
+
+  std::uint64_t sum = 0;
+  double ms = measure_ms([&] {
+    for (auto key : queries) {
+      auto it = map.find(key);
+      if (it != map.end()) {
+        sum += it->second;
+      }
+    }
+  });
+  std::cout << "find one at a time: " << ms * 1e6 / ops << " ns/key" << std::endl;
+
+  for (std::size_t batch : batches) {
+    std::vector<Map::Iterator> found(batch);
+    ms = measure_ms([&] {
+      for (std::size_t start = 0; start < lookups; start += batch) {
+        std::size_t n = std::min(batch, lookups - start);
+        map.find_batch(queries.data() + start, n, found.data());
+        for (std::size_t i = 0; i < n; i++) {
+          if (found[i] != map.end()) {
+            sum += found[i]->second;
+          }
+        }
+      }
+    });
+    std::cout << "find_batch(" << batch << "): " << ms * 1e6 / ops << " ns/key" << std::endl;
+
+    std::unique_ptr<bool[]> present(new bool[batch]);
+    ms = measure_ms([&] {
+      for (std::size_t start = 0; start < lookups; start += batch) {
+        std::size_t n = std::min(batch, lookups - start);
+        map.contains_batch(queries.data() + start, n, present.get());
+        for (std::size_t i = 0; i < n; i++) {
+          sum += present[i];
+        }
+      }
+    });
+    std::cout << "contains_batch(" << batch << "): " << ms * 1e6 / ops << " ns/key"
+              << std::endl;
+  }
+  std::cout << "(checksum " << sum << ")" << std::endl;
+}
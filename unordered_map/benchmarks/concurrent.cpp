@@ -0,0 +1,125 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "concurrent_unordered_map.hpp"
+#include "unordered_map.hpp"
+
+// Пропускная способность (операций в секунду) от числа потоков: один
+// UnorderedMap под глобальным мьютексом против ConcurrentUnorderedMap.
+// Две смеси операций над ключами [0, keys):
+//  - read-heavy: 90% find, 5% insert, 5% erase;
+//  - write-heavy: 20% find, 40% insert, 40% erase.
+// Масштабирование видно только на машине с несколькими ядрами.
+// ./bench_concurrent [ops_per_thread] [keys] [threads...]
+namespace {
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+// Словарь под одним мьютексом - то, что заменяет ConcurrentUnorderedMap
+class LockedMap {
+  mutable std::mutex mutex;
+  UnorderedMap<std::uint64_t, std::uint64_t> map;
+
+public:
+  bool find(std::uint64_t key) const {
+    std::lock_guard lock(mutex);
+    return map.find(key) != map.end();
+  }
+  void insert(std::uint64_t key, std::uint64_t value) {
+    std::lock_guard lock(mutex);
+    map.insert(key, value);
+  }
+  void erase(std::uint64_t key) {
+    std::lock_guard lock(mutex);
+    map.erase(key);
+  }
+};
+
+class ShardedMap {
+  ConcurrentUnorderedMap<std::uint64_t, std::uint64_t> map{256};
+
+public:
+  bool find(std::uint64_t key) const { return map.find(key).has_value(); }
+  void insert(std::uint64_t key, std::uint64_t value) { map.insert(key, value); }
+  void erase(std::uint64_t key) { map.erase(key); }
+};
+
+std::uint64_t xorshift(std::uint64_t &state) {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+// read_percent - доля find, остальное поровну insert и erase
+template <class Map>
+double ops_per_second(std::size_t threads, std::size_t ops, std::uint64_t keys,
+                      std::uint64_t read_percent) {
+  Map map;
+  for (std::uint64_t key = 0; key < keys; key += 2) {
+    map.insert(key, key);
+  }
+  std::vector<std::uint64_t> hits(threads);
+  double ms = measure_ms([&] {
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; t++) {
+      workers.emplace_back([&, t] {
+        std::uint64_t state = 0x9e3779b97f4a7c15ull * (t + 1);
+        std::uint64_t local = 0;
+        for (std::size_t i = 0; i < ops; i++) {
+          std::uint64_t r = xorshift(state);
+          std::uint64_t key = (r >> 8) % keys;
+          std::uint64_t op = r % 100;
+          if (op < read_percent) {
+            local += map.find(key);
+          } else if (op % 2 == 0) {
+            map.insert(key, key);
+          } else {
+            map.erase(key);
+          }
+        }
+        hits[t] = local;
+      });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  });
+  return static_cast<double>(threads * ops) / ms * 1e3;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t ops = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  std::uint64_t keys = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100000;
+  std::vector<std::size_t> thread_counts;
+  for (int i = 3; i < argc; i++) {
+    thread_counts.push_back(std::strtoull(argv[i], nullptr, 10));
+  }
+  if (thread_counts.empty()) {
+    thread_counts = {1, 2, 4, 8, 16, 32, 64};
+  }
+  std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+  for (auto [name, read_percent] : {std::pair{"read-heavy", 90}, std::pair{"write-heavy", 20}}) {
+    std::cout << name << std::endl;
+    for (std::size_t threads : thread_counts) {
+      double locked = ops_per_second<LockedMap>(threads, ops, keys, read_percent);
+      double sharded = ops_per_second<ShardedMap>(threads, ops, keys, read_percent);
+      std::cout << "  " << threads << " threads: global mutex " << locked / 1e6
+                << " Mops/s, sharded " << sharded / 1e6 << " Mops/s" << std::endl;
+    }
+  }
+}
@@ -0,0 +1,121 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+#include "flat_unordered_map.hpp"
+#include "unordered_map.hpp"
+
+// FlatUnorderedMap против UnorderedMap и std::unordered_map: вставка,
+// поиск существующих (hit) и отсутствующих (miss) ключей, удаление, в
+// наносекундах на операцию для каждого размера из аргументов. Маленькие
+// размеры повторяются, чтобы всего было около 4M операций.
+// ./bench_flat [count...]     # по умолчанию 1000 10000 100000 1000000 10000000
+namespace {
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+std::uint64_t splitmix(std::uint64_t &state) {
+  std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+// Одинаковый интерфейс для трех словарей
+struct FlatOps {
+  using Map = FlatUnorderedMap<std::uint64_t, std::uint64_t>;
+  static Map make(std::size_t) { return Map{}; }
+  static void insert(Map &map, std::uint64_t key) { map.insert(key, key); }
+  static bool contains(const Map &map, std::uint64_t key) { return map.contains(key); }
+  static void erase(Map &map, std::uint64_t key) { map.erase(key); }
+};
+
+struct ChainedOps {
+  using Map = UnorderedMap<std::uint64_t, std::uint64_t>;
+  static Map make(std::size_t) { return Map{}; }
+  static void insert(Map &map, std::uint64_t key) { map.insert(key, key); }
+  static bool contains(const Map &map, std::uint64_t key) { return map.contains(key); }
+  static void erase(Map &map, std::uint64_t key) { map.erase(key); }
+};
+
+struct StdOps {
+  using Map = std::unordered_map<std::uint64_t, std::uint64_t>;
+  static Map make(std::size_t) { return Map{}; }
+  static void insert(Map &map, std::uint64_t key) { map.emplace(key, key); }
+  static bool contains(const Map &map, std::uint64_t key) { return map.count(key) != 0; }
+  static void erase(Map &map, std::uint64_t key) { map.erase(key); }
+};
+
+template <class Ops>
+void run(const char *name, const std::vector<std::uint64_t> &keys,
+         const std::vector<std::uint64_t> &missing) {
+  const std::size_t count = keys.size();
+  const std::size_t rounds = count >= 4000000 ? 1 : 4000000 / count;
+  const double ops = static_cast<double>(count * rounds);
+  double insert_ms = 0, hit_ms = 0, miss_ms = 0, erase_ms = 0;
+  std::size_t found = 0;
+
+  for (std::size_t round = 0; round < rounds; round++) {
+    auto map = Ops::make(count);
+    insert_ms += measure_ms([&] {
+      for (std::uint64_t key : keys) {
+        Ops::insert(map, key);
+      }
+    });
+    hit_ms += measure_ms([&] {
+      // Ищем в обратном порядке, чтобы не идти за вставкой по памяти
+      for (std::size_t i = count; i-- > 0;) {
+        found += Ops::contains(map, keys[i]);
+      }
+    });
+    miss_ms += measure_ms([&] {
+      for (std::uint64_t key : missing) {
+        found += Ops::contains(map, key);
+      }
+    });
+    erase_ms += measure_ms([&] {
+      for (std::uint64_t key : keys) {
+        Ops::erase(map, key);
+      }
+    });
+  }
+  std::cout << name << " n=" << count << ": insert " << insert_ms * 1e6 / ops
+            << " ns, hit " << hit_ms * 1e6 / ops << " ns, miss " << miss_ms * 1e6 / ops
+            << " ns, erase " << erase_ms * 1e6 / ops << " ns (found " << found << ")"
+            << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::vector<std::size_t> counts;
+  for (int i = 1; i < argc; i++) {
+    counts.push_back(std::strtoull(argv[i], nullptr, 10));
+  }
+  if (counts.empty()) {
+    counts = {1000, 10000, 100000, 1000000, 10000000};
+  }
+
+  for (std::size_t count : counts) {
+    std::uint64_t state = count;
+    std::vector<std::uint64_t> keys(count), missing(count);
+    for (auto &key : keys) {
+      key = splitmix(state);
+    }
+    for (auto &key : missing) {
+      key = splitmix(state);
+    }
+    run<FlatOps>("FlatUnorderedMap", keys, missing);
+    run<ChainedOps>("UnorderedMap", keys, missing);
+    run<StdOps>("std::unordered_map", keys, missing);
+  }
+}
@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "unordered_map.hpp"
+
+// Задержка отдельных вставок при росте словаря от пустого до count ключей:
+// перехеширование целиком (rehash_step 0) против инкрементального. При
+// полном перехешировании вставка, на которой таблица удваивается, ждет
+// перенос всех элементов; инкрементальное размазывает его по вставкам.
+// Каждая вставка замеряется отдельно (в числа входит ~20 нс steady_clock).
+// ./bench_incremental_rehash [count] [step...]
+namespace {
+
+std::uint64_t splitmix(std::uint64_t &state) {
+  std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+void run(std::size_t count, std::size_t step) {
+  std::vector<std::uint32_t> latencies;
+  latencies.reserve(count);
+  UnorderedMap<std::uint64_t, std::uint64_t> map;
+  map.rehash_step(step);
+  std::uint64_t state = 1;
+  auto begin = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < count; i++) {
+    std::uint64_t key = splitmix(state);
+    auto start = std::chrono::steady_clock::now();
+    map[key] = i;
+    auto finish = std::chrono::steady_clock::now();
+    latencies.push_back(static_cast<std::uint32_t>(std::min<std::int64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count(),
+        UINT32_MAX)));
+  }
+  double total_ms =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&](double p) {
+    return latencies[std::min(count - 1, static_cast<std::size_t>(p * count))];
+  };
+  std::cout << "rehash_step " << step << ": p50 " << percentile(0.5) << " ns, p99 "
+            << percentile(0.99) << " ns, p99.9 " << percentile(0.999) << " ns, p99.99 "
+            << percentile(0.9999) << " ns, max " << latencies.back() / 1000 << " us, total "
+            << total_ms << " ms" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50000000;
+  std::vector<std::size_t> steps;
+  for (int i = 2; i < argc; i++) {
+    steps.push_back(std::strtoull(argv[i], nullptr, 10));
+  }
+  if (steps.empty()) {
+    steps = {0, 4, 16};
+  }
+  std::cout << count << " inserts" << std::endl;
+  for (std::size_t step : steps) {
+    run(count, step);
+  }
+}
@@ -0,0 +1,123 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "flat_unordered_map.hpp"
+#include "int_hash_map.hpp"
+#include "unordered_map.hpp"
+
+// Словари uint64_t -> uint32_t: память на элемент и скорость поиска
+// IntHashMap против UnorderedMap и FlatUnorderedMap. Память считает
+// аллокатор-счетчик (байты, запрошенные контейнером; заголовки malloc,
+// ~16 байт на каждое выделение, сюда не входят - для узлов UnorderedMap
+// это еще 16 байт на элемент).
+// ./bench_int_keys [count...]
+namespace {
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+std::uint64_t splitmix(std::uint64_t &state) {
+  std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+std::size_t allocated = 0;
+
+template <class T>
+struct CountingAllocator {
+  using value_type = T;
+  CountingAllocator() = default;
+  template <class U>
+  CountingAllocator(const CountingAllocator<U> &) {}
+  T *allocate(std::size_t n) {
+    allocated += n * sizeof(T);
+    return std::allocator<T>{}.allocate(n);
+  }
+  void deallocate(T *p, std::size_t n) {
+    allocated -= n * sizeof(T);
+    std::allocator<T>{}.deallocate(p, n);
+  }
+  template <class U>
+  bool operator==(const CountingAllocator<U> &) const { return true; }
+  template <class U>
+  bool operator!=(const CountingAllocator<U> &) const { return false; }
+};
+
+using Pair = std::pair<const std::uint64_t, std::uint32_t>;
+
+template <class Map, class Find>
+void run(const char *name, const std::vector<std::uint64_t> &keys,
+         const std::vector<std::uint64_t> &queries, Find find) {
+  const std::size_t before = allocated;
+  Map map;
+  double insert_ms = measure_ms([&] {
+    for (std::size_t i = 0; i < keys.size(); i++) {
+      map[keys[i]] = static_cast<std::uint32_t>(i);
+    }
+  });
+  const double bytes = static_cast<double>(allocated - before) / static_cast<double>(keys.size());
+  std::uint64_t sum = 0;
+  double find_ms = measure_ms([&] {
+    for (auto key : queries) {
+      sum += find(map, key);
+    }
+  });
+  std::cout << "  " << name << ": " << bytes << " bytes/entry, insert "
+            << insert_ms * 1e6 / static_cast<double>(keys.size()) << " ns/op, find "
+            << static_cast<double>(queries.size()) / find_ms / 1e3 << " Mops/s (checksum " << sum
+            << ")" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::vector<std::size_t> counts;
+  for (int i = 1; i < argc; i++) {
+    counts.push_back(std::strtoull(argv[i], nullptr, 10));
+  }
+  if (counts.empty()) {
+    counts = {1000, 100000, 10000000};
+  }
+  for (std::size_t count : counts) {
+    std::vector<std::uint64_t> keys;
+    std::uint64_t state = 1;
+    for (std::size_t i = 0; i < count; i++) {
+      keys.push_back(splitmix(state));
+    }
+    // Половина запросов - существующие ключи, половина - отсутствующие
+    std::vector<std::uint64_t> queries;
+    const std::size_t lookups = std::max<std::size_t>(count, 1000000);
+    for (std::size_t i = 0; i < lookups; i++) {
+      std::uint64_t r = splitmix(state);
+      queries.push_back(r & 1 ? keys[r % count] : r);
+    }
+    std::cout << count << " keys" << std::endl;
+    run<UnorderedMap<std::uint64_t, std::uint32_t, DefaultHash<std::uint64_t>,
+                     DefaultKeyEqual<std::uint64_t>, CountingAllocator<Pair>>>(
+        "UnorderedMap", keys, queries, [](const auto &map, std::uint64_t key) {
+          auto it = map.find(key);
+          return it == map.end() ? 0u : it->second;
+        });
+    run<FlatUnorderedMap<std::uint64_t, std::uint32_t, CountingAllocator<Pair>>>(
+        "FlatUnorderedMap", keys, queries, [](const auto &map, std::uint64_t key) {
+          auto it = map.find(key);
+          return it == map.end() ? 0u : it->second;
+        });
+    run<IntHashMap<std::uint64_t, std::uint32_t, UINT64_MAX, CountingAllocator<Pair>>>(
+        "IntHashMap", keys, queries, [](const auto &map, std::uint64_t key) {
+          const auto *value = map.find(key);
+          return value == nullptr ? 0u : *value;
+        });
+  }
+}
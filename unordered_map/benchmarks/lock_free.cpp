@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "concurrent_unordered_map.hpp"
+#include "lock_free_unordered_map.hpp"
+
+// Задержка поиска (перцентили) у читателей, пока один писатель непрерывно
+// заменяет и удаляет ключи: LockFreeUnorderedMap против
+// ConcurrentUnorderedMap (шарды с shared_mutex). Каждый поиск замеряется
+// отдельно, поэтому в числа входит и стоимость steady_clock::now (~20 нс).
+// ./bench_lock_free [keys] [readers] [lookups_per_reader]
+namespace {
+
+std::uint64_t xorshift(std::uint64_t &state) {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+struct LockFree {
+  LockFreeUnorderedMap<std::uint64_t, std::uint64_t> map;
+  explicit LockFree(std::size_t keys) : map(keys) {}
+  bool find(std::uint64_t key) const { return map.find(key).has_value(); }
+  void assign(std::uint64_t key, std::uint64_t value) { map.insert_or_assign(key, value); }
+  void erase(std::uint64_t key) { map.erase(key); }
+};
+
+struct Sharded {
+  ConcurrentUnorderedMap<std::uint64_t, std::uint64_t> map{256};
+  explicit Sharded(std::size_t) {}
+  bool find(std::uint64_t key) const { return map.find(key).has_value(); }
+  void assign(std::uint64_t key, std::uint64_t value) {
+    if (!map.update(key, [&](std::uint64_t &old) { old = value; })) {
+      map.insert(key, value);
+    }
+  }
+  void erase(std::uint64_t key) { map.erase(key); }
+};
+
+template <class Map>
+void run(const char *name, std::uint64_t keys, std::size_t readers, std::size_t lookups) {
+  Map map(keys);
+  for (std::uint64_t key = 0; key < keys; key++) {
+    map.assign(key, key);
+  }
+  std::atomic<bool> done{false};
+  std::atomic<std::uint64_t> writes{0};
+  std::thread writer([&] {
+    std::uint64_t state = 0x2545f4914f6cdd1dull;
+    std::uint64_t local = 0;
+    while (!done.load(std::memory_order_relaxed)) {
+      std::uint64_t key = xorshift(state) % keys;
+      if (state & 1) {
+        map.erase(key);
+      } else {
+        map.assign(key, state);
+      }
+      ++local;
+    }
+    writes = local;
+  });
+
+  std::vector<std::vector<std::uint32_t>> latencies(readers);
+  std::vector<std::thread> threads;
+  std::vector<std::uint64_t> hits(readers);
+  for (std::size_t r = 0; r < readers; r++) {
+    threads.emplace_back([&, r] {
+      auto &result = latencies[r];
+      result.reserve(lookups);
+      std::uint64_t state = 0x9e3779b97f4a7c15ull * (r + 1);
+      for (std::size_t i = 0; i < lookups; i++) {
+        std::uint64_t key = xorshift(state) % keys;
+        auto start = std::chrono::steady_clock::now();
+        hits[r] += map.find(key);
+        auto finish = std::chrono::steady_clock::now();
+        result.push_back(static_cast<std::uint32_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count()));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  done = true;
+  writer.join();
+
+  std::vector<std::uint32_t> all;
+  for (auto &part : latencies) {
+    all.insert(all.end(), part.begin(), part.end());
+  }
+  std::sort(all.begin(), all.end());
+  auto percentile = [&](double p) {
+    return all[std::min(all.size() - 1, static_cast<std::size_t>(p * all.size()))];
+  };
+  std::cout << name << ": p50 " << percentile(0.5) << " ns, p90 " << percentile(0.9)
+            << " ns, p99 " << percentile(0.99) << " ns, p99.9 " << percentile(0.999)
+            << " ns, max " << all.back() << " ns (writer ops " << writes << ")" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::uint64_t keys = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+  std::size_t readers = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4;
+  std::size_t lookups = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1000000;
+  std::cout << keys << " keys, " << readers << " readers, 1 writer" << std::endl;
+  run<LockFree>("lock-free", keys, readers, lookups);
+  run<Sharded>("sharded shared_mutex", keys, readers, lookups);
+}
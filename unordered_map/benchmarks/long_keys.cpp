@@ -0,0 +1,77 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fast_hash.hpp"
+#include "unordered_map.hpp"
+
+// Длинные строковые ключи с общим префиксом (пути, URL): хеш ключа здесь
+// дороже всего остального. Сравниваются std::hash и FastHash, с кешем хеша
+// в узле и без:
+//  - вставка count ключей (с ростом таблицы);
+//  - поиск всех ключей passes раз;
+//  - rehash в 4 раза больше корзин (без кеша каждый ключ хешируется заново).
+// ./bench_long_keys [count] [key_length] [passes]
+namespace {
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+template <class Hash, bool CacheHash>
+void run(const char *name, const std::vector<std::string> &keys, std::size_t passes) {
+  using Map = UnorderedMap<std::string, std::uint64_t, Hash, DefaultKeyEqual<std::string>,
+                           std::allocator<std::pair<const std::string, std::uint64_t>>,
+                           CacheHash>;
+  const double count = static_cast<double>(keys.size());
+  Map map;
+  double insert_ms = measure_ms([&] {
+    for (std::size_t i = 0; i < keys.size(); i++) {
+      map[keys[i]] = i;
+    }
+  });
+  std::uint64_t sum = 0;
+  double find_ms = measure_ms([&] {
+    for (std::size_t pass = 0; pass < passes; pass++) {
+      for (const auto &key : keys) {
+        sum += map.find(key)->second;
+      }
+    }
+  });
+  double rehash_ms = measure_ms([&] { map.rehash(map.bucket_count() * 4); });
+  std::cout << name << ": insert " << insert_ms * 1e6 / count << " ns/op, find "
+            << find_ms * 1e6 / (count * static_cast<double>(passes)) << " ns/op, rehash "
+            << rehash_ms << " ms (checksum " << sum << ")" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  std::size_t length = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 128;
+  std::size_t passes = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 5;
+
+  std::vector<std::string> keys;
+  const std::string prefix = "https://example.com/api/v2/storage/buckets/objects/";
+  for (std::size_t i = 0; i < count; i++) {
+    std::string key = prefix + std::to_string(i * 7919);
+    if (key.size() < length) {
+      key.append(length - key.size(), '/');
+    }
+    keys.push_back(std::move(key));
+  }
+  std::cout << count << " keys of " << keys.front().size() << " bytes" << std::endl;
+
+  run<DefaultHash<std::string>, false>("std::hash", keys, passes);
+  run<DefaultHash<std::string>, true>("std::hash + cache", keys, passes);
+  run<FastHash<std::string>, false>("FastHash", keys, passes);
+  run<FastHash<std::string>, true>("FastHash + cache", keys, passes);
+}
@@ -0,0 +1,80 @@
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "unordered_map.hpp"
+
+// Перенос всех count элементов со значениями по value_size байт из одного
+// словаря в другой (active -> expired) тремя способами:
+//  - копия: insert(key, value) в приемник и erase в источнике - новый узел
+//    и копирование значения на каждый элемент;
+//  - extract + insert(node_type&&) - узел перевешивается через splice;
+//  - merge - то же для всего словаря разом.
+// Элементы каждый раз переезжают в другой словарь, так что источник
+// следующего способа - приемник предыдущего.
+// ./bench_node_handle [count]
+namespace {
+
+constexpr std::size_t kValueSize = 1024;
+using Value = std::array<char, kValueSize>;
+using Map = UnorderedMap<std::uint64_t, Value>;
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+void report(const char *name, double ms, std::size_t count) {
+  std::cout << name << ": " << ms << " ms, " << ms * 1e6 / static_cast<double>(count)
+            << " ns/element" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  std::vector<std::uint64_t> keys(count);
+  for (std::size_t i = 0; i < count; i++) {
+    keys[i] = i * 0x9E3779B97F4A7C15ull;
+  }
+  std::cout << count << " elements, values " << kValueSize << " bytes" << std::endl;
+
+  Map first;
+  Map second;
+  first.reserve(count);
+  second.reserve(count);
+  Value value{};
+  for (std::size_t i = 0; i < count; i++) {
+    value[i % kValueSize] = static_cast<char>(i);
+    first.insert(keys[i], value);
+  }
+
+  report("copy + erase", measure_ms([&] {
+           for (std::uint64_t key : keys) {
+             second.insert(key, first[key]);
+             first.erase(key);
+           }
+         }),
+         count);
+
+  report("extract + insert", measure_ms([&] {
+           for (std::uint64_t key : keys) {
+             first.insert(second.extract(key));
+           }
+         }),
+         count);
+
+  report("merge", measure_ms([&] { second.merge(first); }), count);
+
+  if (second.size() != count || !first.empty()) {
+    std::cerr << "size mismatch" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,66 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "unordered_map.hpp"
+
+// Время поиска существующего ключа по мере роста словаря от 10 до count
+// элементов (на каждой степени десяти). С перехешированием длина цепочки
+// остается около 1 (время растет только из-за промахов кеша на больших
+// размерах); для сравнения тот же рост без перехеширования (max_load_factor
+// огромный, 8 корзин, как было раньше) - только до 10K, дальше он слишком
+// медленный.
+// ./bench_rehash [count]
+namespace {
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+std::uint64_t splitmix(std::uint64_t &state) {
+  std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+void run(const char *name, std::size_t count, float max_load_factor) {
+  UnorderedMap<std::uint64_t, std::uint64_t> map;
+  map.max_load_factor(max_load_factor);
+  std::vector<std::uint64_t> keys;
+  keys.reserve(count);
+  std::uint64_t state = 1;
+  std::uint64_t lookup_state = 2;
+  std::uint64_t found = 0;
+  for (std::size_t checkpoint = 10; checkpoint <= count; checkpoint *= 10) {
+    while (keys.size() < checkpoint) {
+      keys.push_back(splitmix(state));
+      map.insert(keys.back(), keys.size());
+    }
+    const std::size_t lookups = 200000;
+    double ms = measure_ms([&] {
+      for (std::size_t i = 0; i < lookups; i++) {
+        found += map.contains(keys[splitmix(lookup_state) % keys.size()]);
+      }
+    });
+    std::cout << name << " n=" << checkpoint << ": " << ms * 1e6 / lookups
+              << " ns/lookup, buckets " << map.bucket_count() << ", load factor "
+              << map.load_factor() << std::endl;
+  }
+  std::cout << "(found " << found << ")" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+  run("rehash", count, 1.0f);
+  run("no rehash", count < 10000 ? count : 10000, 1e9f);
+}
@@ -0,0 +1,83 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "unordered_map.hpp"
+
+// Время "перезапуска" словаря из n элементов: load() из снимка (корзины
+// создаются сразу нужного размера) против поэлементного восстановления
+// (пары читаются из файла и вставляются через insert в пустой словарь,
+// который по дороге перехешируется). Одновременно в памяти живет только
+// один словарь.
+// ./bench_snapshot [count] [directory]
+namespace {
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+using Map = UnorderedMap<std::uint64_t, std::uint64_t>;
+
+std::uint64_t key_at(std::uint64_t i) { return i * 0x9E3779B97F4A7C15ull; }
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50000000;
+  std::filesystem::path directory =
+      argc > 2 ? std::filesystem::path(argv[2]) : std::filesystem::temp_directory_path();
+  const std::string snapshot_path = (directory / "bench_snapshot.bin").string();
+  const std::string pairs_path = (directory / "bench_snapshot_pairs.bin").string();
+
+  {
+    Map map(count);
+    for (std::size_t i = 0; i < count; i++) {
+      map.insert(key_at(i), i);
+    }
+    double ms = measure_ms([&] {
+      std::ofstream file(snapshot_path, std::ios::binary);
+      map.save(file);
+    });
+    std::cout << "save: " << ms << " ms" << std::endl;
+
+    ms = measure_ms([&] {
+      std::ofstream file(pairs_path, std::ios::binary);
+      for (std::size_t i = 0; i < count; i++) {
+        std::uint64_t pair[2] = {key_at(i), i};
+        file.write(reinterpret_cast<const char *>(pair), sizeof(pair));
+      }
+    });
+    std::cout << "write pairs one by one: " << ms << " ms" << std::endl;
+  }
+
+  std::uint64_t checksum = 0;
+  double ms = measure_ms([&] {
+    std::ifstream file(snapshot_path, std::ios::binary);
+    Map map;
+    map.load(file);
+    checksum = map.size() + map[key_at(count / 2)];
+  });
+  std::cout << "restart via load: " << ms << " ms (checksum " << checksum << ")" << std::endl;
+
+  ms = measure_ms([&] {
+    std::ifstream file(pairs_path, std::ios::binary);
+    Map map;
+    std::uint64_t pair[2];
+    while (file.read(reinterpret_cast<char *>(pair), sizeof(pair))) {
+      map.insert(pair[0], pair[1]);
+    }
+    checksum = map.size() + map[key_at(count / 2)];
+  });
+  std::cout << "restart via insert: " << ms << " ms (checksum " << checksum << ")" << std::endl;
+
+  std::filesystem::remove(snapshot_path);
+  std::filesystem::remove(pairs_path);
+}
@@ -0,0 +1,98 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "unordered_map.hpp"
+
+// Строковые ключи длиннее SSO-буфера (каждая временная std::string - это
+// выделение памяти):
+//  - поиск по std::string_view: find(std::string(view)) с временной строкой
+//    против прозрачного find(view);
+//  - подсчет слов: operator[] (один хеш и один проход по корзине) против
+//    прежней схемы contains + insert + find (три хеша и три прохода).
+// ./bench_string_keys [count] [passes]
+namespace {
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+std::string make_key(std::size_t i) { return "session-" + std::to_string(i * 7919) + "-token"; }
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+  std::size_t passes = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20;
+
+  std::vector<std::string> keys;
+  for (std::size_t i = 0; i < count; i++) {
+    keys.push_back(make_key(i));
+  }
+  // Ключи для поиска приходят как string_view на чужой буфер
+  std::string buffer;
+  std::vector<std::pair<std::size_t, std::size_t>> spans;
+  for (const auto &key : keys) {
+    spans.emplace_back(buffer.size(), key.size());
+    buffer += key;
+  }
+  const double ops = static_cast<double>(count * passes);
+
+  UnorderedMap<std::string, std::uint64_t> map;
+  for (std::size_t i = 0; i < count; i++) {
+    map[keys[i]] = i;
+  }
+  std::uint64_t sum = 0;
+  double ms = measure_ms([&] {
+    for (std::size_t pass = 0; pass < passes; pass++) {
+      for (auto [offset, size] : spans) {
+        std::string_view view{buffer.data() + offset, size};
+        sum += map.find(std::string(view))->second;
+      }
+    }
+  });
+  std::cout << "find(std::string(view)): " << ms * 1e6 / ops << " ns/op" << std::endl;
+  ms = measure_ms([&] {
+    for (std::size_t pass = 0; pass < passes; pass++) {
+      for (auto [offset, size] : spans) {
+        std::string_view view{buffer.data() + offset, size};
+        sum += map.find(view)->second;
+      }
+    }
+  });
+  std::cout << "find(view): " << ms * 1e6 / ops << " ns/op" << std::endl;
+
+  ms = measure_ms([&] {
+    for (std::size_t pass = 0; pass < passes; pass++) {
+      UnorderedMap<std::string, std::uint64_t> counts;
+      for (const auto &key : keys) {
+        if (!counts.contains(key)) {
+          counts.insert(key, 0);
+        }
+        ++counts.find(key)->second;
+      }
+      sum += counts.size();
+    }
+  });
+  std::cout << "count via contains + insert + find: " << ms * 1e6 / ops << " ns/op"
+            << std::endl;
+  ms = measure_ms([&] {
+    for (std::size_t pass = 0; pass < passes; pass++) {
+      UnorderedMap<std::string, std::uint64_t> counts;
+      for (const auto &key : keys) {
+        ++counts[key];
+      }
+      sum += counts.size();
+    }
+  });
+  std::cout << "count via operator[]: " << ms * 1e6 / ops << " ns/op" << std::endl;
+  std::cout << "(checksum " << sum << ")" << std::endl;
+}
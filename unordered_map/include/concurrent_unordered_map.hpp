@@ -0,0 +1,187 @@
+#ifndef CONCURRENT_UNORDERED_MAP_H
+#define CONCURRENT_UNORDERED_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "fast_hash.hpp"
+#include "unordered_map.hpp"
+
+// Словарь для нескольких потоков. Ключи разбиты на шарды - независимые
+// UnorderedMap, у каждого своя блокировка читатель-писатель (shared_mutex):
+// потоки, попавшие в разные шарды, не мешают друг другу, а чтения одного
+// шарда идут параллельно. Шард лежит в своей кеш-линии, чтобы блокировки
+// соседних шардов не делили линию (false sharing).
+//
+// Ссылки и итераторы наружу не отдаются - после снятия блокировки их мог бы
+// испортить другой поток. find возвращает копию значения, а изменить значение
+// на месте можно через update(key, fn), где fn выполняется под блокировкой.
+//
+// Параметры шаблона - те же и в том же порядке, что у UnorderedMap. Ключ
+// хешируется один раз: хеш выбирает шард и передается в шард готовым.
+template <class Key, class Value, class Hash = DefaultHash<Key>,
+          class KeyEqual = DefaultKeyEqual<Key>,
+          class Allocator = std::allocator<std::pair<const Key, Value>>,
+          bool CacheHash = false>
+class ConcurrentUnorderedMap {
+public:
+  using Map = UnorderedMap<Key, Value, Hash, KeyEqual, Allocator, CacheHash>;
+
+private:
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    Map map;
+  };
+
+  std::unique_ptr<Shard[]> shards;
+  std::size_t count;
+  Hash hasher;
+
+  static std::size_t round_up_to_power_of_two(std::size_t n) {
+    if (n > (std::numeric_limits<std::size_t>::max() >> 1) + 1) {
+      throw std::length_error{"too many shards"};
+    }
+    std::size_t result = 1;
+    while (result < n) {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  // Шард выбирается по старшим битам перемешанного хеша: младшие биты
+  // хеша выбирают корзину внутри шарда, и с ними шарды бы коррелировали
+  // (для std::hash<int> все ключи шарда попали бы в одну долю его корзин)
+  Shard &shard_for(std::size_t hashed) const {
+    std::uint64_t mixed = fast_hash::hash_integer(hashed);
+    return shards[static_cast<std::size_t>(mixed >> 32) & (count - 1)];
+  }
+
+public:
+  // shard_count округляется вверх до степени двойки. Шардов стоит брать
+  // в несколько раз больше, чем потоков
+  explicit ConcurrentUnorderedMap(std::size_t shard_count = 64)
+      : shards(new Shard[round_up_to_power_of_two(shard_count)]),
+        count(round_up_to_power_of_two(shard_count)) {}
+
+  ConcurrentUnorderedMap(const ConcurrentUnorderedMap &) = delete;
+  ConcurrentUnorderedMap &operator=(const ConcurrentUnorderedMap &) = delete;
+
+  std::size_t shard_count() const { return count; }
+
+  // Возвращает копию значения или nullopt, если ключа нет
+  std::optional<Value> find(const Key &key) const {
+    const std::size_t hashed = hasher(key);
+    Shard &shard = shard_for(hashed);
+    std::shared_lock lock(shard.mutex);
+    auto it = shard.map.find(key, hashed);
+    if (it == shard.map.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  template <class K, class H = Hash, class E = KeyEqual, class = typename H::is_transparent,
+            class = typename E::is_transparent>
+  std::optional<Value> find(const K &key) const {
+    const std::size_t hashed = hasher(key);
+    Shard &shard = shard_for(hashed);
+    std::shared_lock lock(shard.mutex);
+    auto it = shard.map.find(key, hashed);
+    if (it == shard.map.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  bool contains(const Key &key) const {
+    const std::size_t hashed = hasher(key);
+    Shard &shard = shard_for(hashed);
+    std::shared_lock lock(shard.mutex);
+    return shard.map.contains(key, hashed);
+  }
+
+  template <class K, class H = Hash, class E = KeyEqual, class = typename H::is_transparent,
+            class = typename E::is_transparent>
+  bool contains(const K &key) const {
+    const std::size_t hashed = hasher(key);
+    Shard &shard = shard_for(hashed);
+    std::shared_lock lock(shard.mutex);
+    return shard.map.contains(key, hashed);
+  }
+
+  // Вставляет пару, если ключа еще нет. Возвращает true, если вставил
+  bool insert(const Key &key, const Value &value) {
+    const std::size_t hashed = hasher(key);
+    Shard &shard = shard_for(hashed);
+    std::unique_lock lock(shard.mutex);
+    return shard.map.try_emplace_hashed(hashed, key, value).second;
+  }
+
+  bool insert(Key &&key, Value &&value) {
+    const std::size_t hashed = hasher(key);
+    Shard &shard = shard_for(hashed);
+    std::unique_lock lock(shard.mutex);
+    return shard.map.try_emplace_hashed(hashed, std::move(key), std::move(value)).second;
+  }
+
+  // Удаляет ключ. Возвращает true, если он был
+  bool erase(const Key &key) {
+    const std::size_t hashed = hasher(key);
+    Shard &shard = shard_for(hashed);
+    std::unique_lock lock(shard.mutex);
+    return shard.map.erase(key, hashed);
+  }
+
+  // Вызывает fn(value) для значения ключа под блокировкой шарда, так что
+  // чтение-изменение-запись атомарно. Возвращает false, если ключа нет.
+  // fn не должна обращаться к этому же словарю (взаимоблокировка)
+  template <class F>
+  bool update(const Key &key, F &&fn) {
+    const std::size_t hashed = hasher(key);
+    Shard &shard = shard_for(hashed);
+    std::unique_lock lock(shard.mutex);
+    auto it = shard.map.find(key, hashed);
+    if (it == shard.map.end()) {
+      return false;
+    }
+    fn(it->second);
+    return true;
+  }
+
+  // Вызывает fn(map) для каждого шарда по очереди, держа его блокировку:
+  // для константного словаря - разделяемую, иначе - исключительную.
+  // Шарды обходятся не одновременно, поэтому это не снимок всего словаря
+  template <class F>
+  void for_each_shard(F &&fn) const {
+    for (std::size_t i = 0; i < count; i++) {
+      std::shared_lock lock(shards[i].mutex);
+      fn(static_cast<const Map &>(shards[i].map));
+    }
+  }
+
+  template <class F>
+  void for_each_shard(F &&fn) {
+    for (std::size_t i = 0; i < count; i++) {
+      std::unique_lock lock(shards[i].mutex);
+      fn(shards[i].map);
+    }
+  }
+
+  // Сумма размеров шардов; при параллельных изменениях - приблизительная
+  std::size_t size() const {
+    std::size_t result = 0;
+    for_each_shard([&](const Map &map) { result += map.size(); });
+    return result;
+  }
+
+  bool empty() const { return size() == 0; }
+};
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef FAST_HASH_H
+#define FAST_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Быстрый некриптографический хеш в духе wyhash для целых чисел и строк.
+// Основа - умножение 64x64 -> 128 бит и xor половин результата (mum): одно
+// умножение хорошо перемешивает все биты. Строки читаются по 8 байт, а не
+// по одному символу, как в std::hash (FNV/murmur в libstdc++ тоже читает по
+// 8, но делает больше операций на блок).
+//
+// UnorderedMap<std::string, int, FastHash<std::string>> map;
+//
+// Результат зависит только от значения (не от запуска), поэтому годится для
+// снимков. Не защищает от специально подобранных ключей (hash flooding).
+namespace fast_hash {
+
+inline constexpr std::uint64_t kSecret0 = 0xa0761d6478bd642full;
+inline constexpr std::uint64_t kSecret1 = 0xe7037ed1a0b428dbull;
+inline constexpr std::uint64_t kSecret2 = 0x8ebc6af09c88c6e3ull;
+
+inline std::uint64_t mum(std::uint64_t a, std::uint64_t b) {
+#ifdef __SIZEOF_INT128__
+  __uint128_t r = static_cast<__uint128_t>(a) * b;
+  return static_cast<std::uint64_t>(r) ^ static_cast<std::uint64_t>(r >> 64);
+#else
+  // Без 128-битного типа произведение собирается из 32-битных половин
+  std::uint64_t ha = a >> 32, la = a & 0xffffffffu, hb = b >> 32, lb = b & 0xffffffffu;
+  std::uint64_t hh = ha * hb, hl = ha * lb, lh = la * hb, ll = la * lb;
+  std::uint64_t mid = (ll >> 32) + (hl & 0xffffffffu) + (lh & 0xffffffffu);
+  std::uint64_t lo = (mid << 32) | (ll & 0xffffffffu);
+  std::uint64_t hi = hh + (hl >> 32) + (lh >> 32) + (mid >> 32);
+  return lo ^ hi;
+#endif
+}
+
+inline std::uint64_t read64(const unsigned char *p) {
+  std::uint64_t v;
+  std::memcpy(&v, p, 8);
+  return v;
+}
+
+inline std::uint64_t read32(const unsigned char *p) {
+  std::uint32_t v;
+  std::memcpy(&v, p, 4);
+  return v;
+}
+
+inline std::uint64_t hash_bytes(const void *data, std::size_t size) {
+  const auto *p = static_cast<const unsigned char *>(data);
+  std::uint64_t seed = kSecret0 ^ mum(size ^ kSecret1, kSecret2);
+  std::size_t left = size;
+  while (left > 16) {
+    seed = mum(read64(p) ^ kSecret1, read64(p + 8) ^ seed);
+    p += 16;
+    left -= 16;
+  }
+  std::uint64_t a = 0, b = 0;
+  if (left >= 8) {
+    // Последние 8 байт могут перекрываться с первыми - это нормально
+    a = read64(p);
+    b = read64(p + left - 8);
+  } else if (left >= 4) {
+    a = read32(p);
+    b = read32(p + left - 4);
+  } else if (left > 0) {
+    a = (std::uint64_t{p[0]} << 16) | (std::uint64_t{p[left >> 1]} << 8) | p[left - 1];
+  }
+  return mum(kSecret1 ^ size, mum(a ^ kSecret1, b ^ seed));
+}
+
+inline std::uint64_t hash_integer(std::uint64_t value) {
+  return mum(value ^ kSecret0, kSecret1);
+}
+
+} // namespace fast_hash
+
+// Для целых (и перечислений) - одно умножение, для строк - fast_hash::hash_bytes.
+// Для других типов - std::hash
+template <class Key, class = void>
+struct FastHash {
+  std::size_t operator()(const Key &key) const { return std::hash<Key>{}(key); }
+};
+
+template <class Key>
+struct FastHash<Key, std::enable_if_t<std::is_integral_v<Key> || std::is_enum_v<Key>>> {
+  std::size_t operator()(Key key) const {
+    return static_cast<std::size_t>(fast_hash::hash_integer(static_cast<std::uint64_t>(key)));
+  }
+};
+
+// Прозрачный: std::string, std::string_view и const char* дают один хеш
+template <class Char, class Traits, class Alloc>
+struct FastHash<std::basic_string<Char, Traits, Alloc>> {
+  using is_transparent = void;
+  std::size_t operator()(std::basic_string_view<Char, Traits> key) const {
+    return static_cast<std::size_t>(fast_hash::hash_bytes(key.data(), key.size() * sizeof(Char)));
+  }
+};
+
+template <class Char, class Traits>
+struct FastHash<std::basic_string_view<Char, Traits>>
+    : FastHash<std::basic_string<Char, Traits>> {};
+
+#endif
@@ -0,0 +1,465 @@
+#ifndef FLAT_UNORDERED_MAP_H
+#define FLAT_UNORDERED_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLAT_UNORDERED_MAP_SSE2 1
+#include <emmintrin.h>
+#else
+#define FLAT_UNORDERED_MAP_SSE2 0
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Хеш-таблица с открытой адресацией в стиле Swiss table. Пары ключ-значение
+// лежат в одном массиве слотов без отдельных узлов, а рядом хранится массив
+// управляющих байтов: для каждого слота - пуст, удален, или 7 младших бит
+// хеша ключа. Поиск сравнивает сразу группу из 16 управляющих байтов (одна
+// SSE2-инструкция) и заглядывает в слот только при совпадении этих 7 бит,
+// поэтому на промах обычно хватает одного чтения кеш-линии.
+//
+// API как у UnorderedMap: operator[], find, insert, erase, contains.
+// В отличие от UnorderedMap, вставка может перенести все элементы (при росте
+// таблицы), поэтому итераторы и ссылки на элементы после insert/operator[]
+// недействительны.
+template <class Key, class Value,
+          class Allocator = std::allocator<std::pair<const Key, Value>>>
+class FlatUnorderedMap {
+private:
+  using ValueType = std::pair<Key, Value>;
+  using AllocTraits = std::allocator_traits<Allocator>;
+  using SlotAllocator = typename AllocTraits::template rebind_alloc<ValueType>;
+  using SlotTraits = std::allocator_traits<SlotAllocator>;
+  using CtrlAllocator = typename AllocTraits::template rebind_alloc<std::int8_t>;
+  using CtrlTraits = std::allocator_traits<CtrlAllocator>;
+
+  // Управляющий байт: отрицательный - слот свободен, иначе 7 бит хеша
+  static constexpr std::int8_t kEmpty = -128;
+  static constexpr std::int8_t kDeleted = -2;
+  static constexpr std::size_t kGroupWidth = 16;
+
+  // Маска совпадений в группе: бит i установлен, если подходит слот i
+  class BitMask {
+    std::uint32_t mask;
+
+  public:
+    explicit BitMask(std::uint32_t mask) : mask{mask} {}
+    explicit operator bool() const { return mask != 0; }
+    std::size_t lowest() const {
+#ifdef _MSC_VER
+      unsigned long index;
+      _BitScanForward(&index, mask);
+      return static_cast<std::size_t>(index);
+#else
+      return static_cast<std::size_t>(__builtin_ctz(mask));
+#endif
+    }
+    void clear_lowest() { mask &= mask - 1; }
+  };
+
+  // 16 управляющих байтов, которые проверяются разом
+  class Group {
+#if FLAT_UNORDERED_MAP_SSE2
+    __m128i ctrl;
+
+  public:
+    explicit Group(const std::int8_t *p)
+        : ctrl{_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))} {}
+
+    BitMask match(std::int8_t h2) const {
+      return BitMask{static_cast<std::uint32_t>(
+          _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)))};
+    }
+    BitMask match_empty() const { return match(kEmpty); }
+    // У пустых и удаленных слотов старший бит установлен
+    BitMask match_empty_or_deleted() const {
+      return BitMask{static_cast<std::uint32_t>(_mm_movemask_epi8(ctrl))};
+    }
+#else
+    const std::int8_t *ctrl;
+
+  public:
+    explicit Group(const std::int8_t *p) : ctrl{p} {}
+
+    BitMask match(std::int8_t h2) const {
+      std::uint32_t mask = 0;
+      for (std::size_t i = 0; i < kGroupWidth; i++) {
+        mask |= static_cast<std::uint32_t>(ctrl[i] == h2) << i;
+      }
+      return BitMask{mask};
+    }
+    BitMask match_empty() const { return match(kEmpty); }
+    BitMask match_empty_or_deleted() const {
+      std::uint32_t mask = 0;
+      for (std::size_t i = 0; i < kGroupWidth; i++) {
+        mask |= static_cast<std::uint32_t>(ctrl[i] < 0) << i;
+      }
+      return BitMask{mask};
+    }
+#endif
+  };
+
+  SlotAllocator alloc;
+  std::int8_t *ctrl = nullptr;
+  ValueType *slots = nullptr;
+  // Количество слотов: 0 или степень двойки, кратная kGroupWidth
+  std::size_t capacity = 0;
+  std::size_t s = 0;
+  // Сколько еще пустых слотов можно занять до роста (держит заполнение
+  // вместе с удаленными слотами не выше 7/8)
+  std::size_t growth_left = 0;
+
+  // std::hash для целых в libstdc++ - тождественная функция, а группа и 7 бит
+  // берутся из разных частей хеша, поэтому биты перемешиваются
+  static std::size_t hash_of(const Key &key) {
+    std::uint64_t h = std::hash<Key>{}(key);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return static_cast<std::size_t>(h);
+  }
+  static std::size_t h1(std::size_t hash) { return hash >> 7; }
+  static std::int8_t h2(std::size_t hash) { return static_cast<std::int8_t>(hash & 0x7f); }
+
+  static std::size_t max_size_for(std::size_t capacity) { return capacity - capacity / 8; }
+
+  // Возвращает индекс слота с ключом key или capacity, если ключа нет.
+  // Группы перебираются с шагами 1, 2, 3, ... (по модулю числа групп), такая
+  // последовательность при числе групп - степени двойки обходит все группы
+  std::size_t find_index(const Key &key, std::size_t hash) const {
+    if (capacity == 0) {
+      return capacity;
+    }
+    const std::size_t group_mask = capacity / kGroupWidth - 1;
+    std::size_t group = h1(hash) & group_mask;
+    for (std::size_t step = 1;; step++) {
+      const std::size_t offset = group * kGroupWidth;
+      Group g{ctrl + offset};
+      for (BitMask match = g.match(h2(hash)); match; match.clear_lowest()) {
+        const std::size_t index = offset + match.lowest();
+        if (slots[index].first == key) {
+          return index;
+        }
+      }
+      if (g.match_empty()) {
+        return capacity;
+      }
+      group = (group + step) & group_mask;
+    }
+  }
+
+  // Возвращает первый пустой или удаленный слот на пути поиска hash
+  std::size_t find_free_index(std::size_t hash) const {
+    const std::size_t group_mask = capacity / kGroupWidth - 1;
+    std::size_t group = h1(hash) & group_mask;
+    for (std::size_t step = 1;; step++) {
+      const std::size_t offset = group * kGroupWidth;
+      if (BitMask free = Group{ctrl + offset}.match_empty_or_deleted()) {
+        return offset + free.lowest();
+      }
+      group = (group + step) & group_mask;
+    }
+  }
+
+  // Занимает слот для нового ключа (ключа в таблице нет) и возвращает его
+  // индекс. Слот еще не создан: это делает вызывающий, затем commit_slot.
+  // Если место кончилось в основном из-за удаленных слотов, таблица
+  // перестраивается в том же размере, иначе растет вдвое
+  std::size_t prepare_insert(std::size_t hash) {
+    std::size_t index = capacity ? find_free_index(hash) : 0;
+    if (capacity == 0 || (growth_left == 0 && ctrl[index] == kEmpty)) {
+      if (capacity == 0) {
+        rehash_to(kGroupWidth);
+      } else if (s * 2 <= max_size_for(capacity)) {
+        rehash_to(capacity);
+      } else {
+        rehash_to(capacity * 2);
+      }
+      index = find_free_index(hash);
+    }
+    return index;
+  }
+
+  void commit_slot(std::size_t index, std::size_t hash) {
+    if (ctrl[index] == kEmpty) {
+      --growth_left;
+    }
+    ctrl[index] = h2(hash);
+    ++s;
+  }
+
+  // Переносит все элементы в новую таблицу из new_capacity слотов
+  void rehash_to(std::size_t new_capacity) {
+    CtrlAllocator ctrl_alloc(alloc);
+    std::int8_t *new_ctrl = CtrlTraits::allocate(ctrl_alloc, new_capacity);
+    ValueType *new_slots;
+    try {
+      new_slots = SlotTraits::allocate(alloc, new_capacity);
+    } catch (...) {
+      CtrlTraits::deallocate(ctrl_alloc, new_ctrl, new_capacity);
+      throw;
+    }
+    std::memset(new_ctrl, static_cast<unsigned char>(kEmpty), new_capacity);
+
+    std::int8_t *old_ctrl = std::exchange(ctrl, new_ctrl);
+    ValueType *old_slots = std::exchange(slots, new_slots);
+    const std::size_t old_capacity = std::exchange(capacity, new_capacity);
+    growth_left = max_size_for(new_capacity) - s;
+
+    for (std::size_t i = 0; i < old_capacity; i++) {
+      if (old_ctrl[i] >= 0) {
+        const std::size_t hash = hash_of(old_slots[i].first);
+        const std::size_t index = find_free_index(hash);
+        SlotTraits::construct(alloc, slots + index, std::move(old_slots[i]));
+        SlotTraits::destroy(alloc, old_slots + i);
+        ctrl[index] = h2(hash);
+      }
+    }
+    if (old_capacity) {
+      CtrlTraits::deallocate(ctrl_alloc, old_ctrl, old_capacity);
+      SlotTraits::deallocate(alloc, old_slots, old_capacity);
+    }
+  }
+
+  void destroy_all() {
+    if (capacity == 0) {
+      return;
+    }
+    for (std::size_t i = 0; i < capacity; i++) {
+      if (ctrl[i] >= 0) {
+        SlotTraits::destroy(alloc, slots + i);
+      }
+    }
+    CtrlAllocator ctrl_alloc(alloc);
+    CtrlTraits::deallocate(ctrl_alloc, ctrl, capacity);
+    SlotTraits::deallocate(alloc, slots, capacity);
+    ctrl = nullptr;
+    slots = nullptr;
+    capacity = 0;
+    s = 0;
+    growth_left = 0;
+  }
+
+  void swap(FlatUnorderedMap &other) noexcept {
+    std::swap(alloc, other.alloc);
+    std::swap(ctrl, other.ctrl);
+    std::swap(slots, other.slots);
+    std::swap(capacity, other.capacity);
+    std::swap(s, other.s);
+    std::swap(growth_left, other.growth_left);
+  }
+
+public:
+  template <class Pair>
+  class BasicIterator;
+  using Iterator = BasicIterator<ValueType>;
+  using ConstIterator = BasicIterator<const ValueType>;
+  using allocator_type = Allocator;
+
+  // Создает пустой словарь. Память не выделяется до первой вставки
+  FlatUnorderedMap() : FlatUnorderedMap(Allocator()) {}
+
+  explicit FlatUnorderedMap(const Allocator &alloc) : alloc(alloc) {}
+
+  // Глубокая копия other [O(n)]
+  FlatUnorderedMap(const FlatUnorderedMap &other)
+      : alloc(SlotTraits::select_on_container_copy_construction(other.alloc)) {
+    reserve(other.s);
+    for (const auto &pair : other) {
+      insert(pair.first, pair.second);
+    }
+  }
+
+  // Таблица передается целиком, other остается пустым
+  FlatUnorderedMap(FlatUnorderedMap &&other) noexcept : alloc(other.alloc) { swap(other); }
+
+  FlatUnorderedMap &operator=(const FlatUnorderedMap &other) {
+    FlatUnorderedMap tmp{other};
+    swap(tmp);
+    return *this;
+  }
+
+  FlatUnorderedMap &operator=(FlatUnorderedMap &&other) noexcept {
+    FlatUnorderedMap tmp{std::move(other)};
+    swap(tmp);
+    return *this;
+  }
+
+  ~FlatUnorderedMap() { destroy_all(); }
+
+  Allocator get_allocator() const { return Allocator(alloc); }
+
+  Iterator begin() { return Iterator{ctrl, slots, ctrl + capacity}; }
+  Iterator end() { return Iterator{ctrl + capacity, slots + capacity, ctrl + capacity}; }
+  ConstIterator begin() const { return ConstIterator{ctrl, slots, ctrl + capacity}; }
+  ConstIterator end() const {
+    return ConstIterator{ctrl + capacity, slots + capacity, ctrl + capacity};
+  }
+
+  // Возвращает количество элементов
+  std::size_t size() const { return s; }
+
+  // Проверяет является ли словарь пустым
+  bool empty() const { return !s; }
+
+  // Возвращает количество слотов
+  std::size_t bucket_count() const { return capacity; }
+
+  // Готовит таблицу к n элементам без роста при вставке
+  void reserve(std::size_t n) {
+    std::size_t new_capacity = capacity ? capacity : kGroupWidth;
+    while (max_size_for(new_capacity) < n) {
+      new_capacity *= 2;
+    }
+    if (new_capacity > capacity) {
+      rehash_to(new_capacity);
+    }
+  }
+
+  // Удаляет все элементы и освобождает память
+  void clear() { destroy_all(); }
+
+  // Возвращает элемент по ключу. Если отсутсвует, выбрасывает исключение
+  const Value &operator[](const Key &key) const {
+    const std::size_t index = find_index(key, hash_of(key));
+    if (index == capacity) {
+      throw std::out_of_range{"No such a key here"};
+    }
+    return slots[index].second;
+  }
+
+  // Возвращает ссылку на элемент по ключу. Если элемента нет, создает его с
+  // дефолтным значением. Ключ хешируется и ищется один раз
+  Value &operator[](const Key &key) {
+    const std::size_t hash = hash_of(key);
+    std::size_t index = find_index(key, hash);
+    if (index == capacity) {
+      index = prepare_insert(hash);
+      SlotTraits::construct(alloc, slots + index, std::piecewise_construct,
+                            std::forward_as_tuple(key), std::forward_as_tuple());
+      commit_slot(index, hash);
+    }
+    return slots[index].second;
+  }
+
+  // Проверяет есть ли в контейнере элемент с таким ключом
+  bool contains(const Key &key) const { return find_index(key, hash_of(key)) != capacity; }
+
+  // Возвращает итератор на элемент с ключом key или end()
+  Iterator find(const Key &key) {
+    const std::size_t index = find_index(key, hash_of(key));
+    return Iterator{ctrl + index, slots + index, ctrl + capacity};
+  }
+
+  ConstIterator find(const Key &key) const {
+    const std::size_t index = find_index(key, hash_of(key));
+    return ConstIterator{ctrl + index, slots + index, ctrl + capacity};
+  }
+
+  // Добавляет элемент, если элемента с таким ключом еще нет. Возвращает,
+  // был ли он добавлен
+  bool insert(const Key &k, const Value &v) {
+    const std::size_t hash = hash_of(k);
+    if (find_index(k, hash) != capacity) {
+      return false;
+    }
+    const std::size_t index = prepare_insert(hash);
+    SlotTraits::construct(alloc, slots + index, k, v);
+    commit_slot(index, hash);
+    return true;
+  }
+
+  // Удаляет элемент по ключу и возвращает результат операции. Если в группе
+  // слота есть пустые, поиск других ключей на ней и так останавливается, и
+  // слот снова становится пустым; иначе он помечается удаленным
+  bool erase(const Key &key) {
+    const std::size_t index = find_index(key, hash_of(key));
+    if (index == capacity) {
+      return false;
+    }
+    SlotTraits::destroy(alloc, slots + index);
+    const std::size_t offset = index & ~(kGroupWidth - 1);
+    if (Group{ctrl + offset}.match_empty()) {
+      ctrl[index] = kEmpty;
+      ++growth_left;
+    } else {
+      ctrl[index] = kDeleted;
+    }
+    --s;
+    return true;
+  }
+
+  // Однонаправленный итератор по занятым слотам. Pair - ValueType для
+  // Iterator и const ValueType для ConstIterator
+  template <class Pair>
+  class BasicIterator {
+    friend FlatUnorderedMap;
+    template <class Other>
+    friend class BasicIterator;
+
+    const std::int8_t *ctrl{};
+    Pair *slot{};
+    const std::int8_t *ctrl_end{};
+
+    BasicIterator(const std::int8_t *ctrl, Pair *slot, const std::int8_t *ctrl_end)
+        : ctrl{ctrl}, slot{slot}, ctrl_end{ctrl_end} {
+      skip_free();
+    }
+
+    void skip_free() {
+      while (ctrl != ctrl_end && *ctrl < 0) {
+        ++ctrl;
+        ++slot;
+      }
+    }
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ValueType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Pair *;
+    using reference = Pair &;
+
+    BasicIterator() = default;
+
+    // Iterator неявно превращается в ConstIterator
+    template <class Other,
+              class = std::enable_if_t<std::is_convertible_v<Other *, Pair *>>>
+    BasicIterator(const BasicIterator<Other> &other)
+        : ctrl{other.ctrl}, slot{other.slot}, ctrl_end{other.ctrl_end} {}
+
+    BasicIterator &operator++() {
+      ++ctrl;
+      ++slot;
+      skip_free();
+      return *this;
+    }
+
+    BasicIterator operator++(int) {
+      BasicIterator old = *this;
+      ++*this;
+      return old;
+    }
+
+    bool operator==(const BasicIterator &other) const { return ctrl == other.ctrl; }
+    bool operator!=(const BasicIterator &other) const { return ctrl != other.ctrl; }
+
+    // Разыменовывает итератор: std::cout << it->second;
+    pointer operator->() const { return slot; }
+    reference operator*() const { return *slot; }
+  };
+};
+
+#endif
@@ -0,0 +1,519 @@
+#ifndef INT_HASH_MAP_H
+#define INT_HASH_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "fast_hash.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define INT_HASH_MAP_SSE2 1
+#include <emmintrin.h>
+#else
+#define INT_HASH_MAP_SSE2 0
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Хеш-таблицы для целых ключей: IntHashMap<Key, Value> и IntHashSet<Key>.
+//
+// Ключи и значения лежат в двух плотных массивах без узлов и без
+// отдельного байта состояния: свободный слот - это слот с ключом EmptyKey
+// (по умолчанию максимальное значение типа), поэтому сам этот ключ хранить
+// нельзя. UnorderedMap<uint64_t, uint32_t> тратит на элемент узел списка
+// (два указателя, пара и заголовок malloc), здесь - 12 байт на слот при
+// заполнении от 3/8 до 3/4 (выше линейное пробирование резко удлиняет
+// поиск отсутствующих ключей).
+//
+// Открытая адресация с линейным пробированием: поиск сравнивает с ключом
+// сразу 16 байт соседних ключей (одна SSE2-инструкция, 2 ключа uint64_t
+// или 4 uint32_t) и останавливается на первом свободном слоте. Удаление
+// сдвигает следующие элементы цепочки назад (без удаленных слотов), так что
+// поиск не замедляется от удалений.
+//
+// Вставка может перенести все элементы, поэтому указатели на значения после
+// insert/operator[] недействительны.
+namespace int_hash {
+
+// Сравнивает 16 байт ключей, начиная с keys, со значением key. Возвращает
+// маску по байтам: для совпавшего ключа установлены все sizeof(Key) его бит
+template <class Key>
+std::uint32_t match(const Key *keys, Key key) {
+#if INT_HASH_MAP_SSE2
+  __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys));
+  __m128i eq;
+  if constexpr (sizeof(Key) == 1) {
+    eq = _mm_cmpeq_epi8(block, _mm_set1_epi8(static_cast<char>(key)));
+  } else if constexpr (sizeof(Key) == 2) {
+    eq = _mm_cmpeq_epi16(block, _mm_set1_epi16(static_cast<short>(key)));
+  } else if constexpr (sizeof(Key) == 4) {
+    eq = _mm_cmpeq_epi32(block, _mm_set1_epi32(static_cast<int>(key)));
+  } else {
+    // В SSE2 нет сравнения 64-битных чисел: сравниваются половины, и ключ
+    // совпал, если совпали обе
+    eq = _mm_cmpeq_epi32(block, _mm_set1_epi64x(static_cast<long long>(key)));
+    eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+  }
+  return static_cast<std::uint32_t>(_mm_movemask_epi8(eq));
+#else
+  constexpr std::uint32_t lane = (1u << sizeof(Key)) - 1;
+  std::uint32_t mask = 0;
+  for (std::size_t i = 0; i < 16 / sizeof(Key); i++) {
+    if (keys[i] == key) {
+      mask |= lane << (i * sizeof(Key));
+    }
+  }
+  return mask;
+#endif
+}
+
+inline void prefetch([[maybe_unused]] const void *addr) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(addr);
+#endif
+}
+
+inline std::size_t lowest_bit(std::uint32_t mask) {
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return static_cast<std::size_t>(index);
+#else
+  return static_cast<std::size_t>(__builtin_ctz(mask));
+#endif
+}
+
+// Общая часть IntHashMap и IntHashSet. Value = void - без значений
+template <class Key, class Value, Key EmptyKey, class Allocator>
+class Table {
+  static_assert(std::is_integral_v<Key>, "Table requires an integral key");
+  static_assert(sizeof(Key) <= 8, "Table supports keys up to 64 bits");
+
+  static constexpr bool kHasValues = !std::is_void_v<Value>;
+  using StoredValue = std::conditional_t<kHasValues, Value, char>;
+  using AllocTraits = std::allocator_traits<Allocator>;
+  using KeyAllocator = typename AllocTraits::template rebind_alloc<Key>;
+  using KeyTraits = std::allocator_traits<KeyAllocator>;
+  using ValueAllocator = typename AllocTraits::template rebind_alloc<StoredValue>;
+  using ValueTraits = std::allocator_traits<ValueAllocator>;
+
+public:
+  // Ключей в одной проверке; столько же свободных ключей лежит за концом
+  // массива, чтобы проверка у конца не читала чужую память
+  static constexpr std::size_t kLanes = 16 / sizeof(Key);
+  // Заполнение ограничено 3/4 слотов (max_size_for). При емкости меньше 4
+  // это округлялось бы до всех слотов, и поиск не нашел бы свободного;
+  // 16 - с запасом и не меньше kLanes
+  static constexpr std::size_t kMinCapacity = 16;
+
+  ValueAllocator alloc;
+  Key *keys = nullptr;
+  StoredValue *values = nullptr;
+  // Количество слотов: 0 или степень двойки не меньше kMinCapacity
+  std::size_t capacity = 0;
+  std::size_t s = 0;
+
+  explicit Table(const Allocator &alloc) : alloc(alloc) {}
+
+  Table(const Table &other)
+      : alloc(ValueTraits::select_on_container_copy_construction(other.alloc)) {
+    reserve(other.s);
+    other.for_each_index([&](std::size_t i) {
+      if constexpr (kHasValues) {
+        insert_new(other.keys[i], other.values[i]);
+      } else {
+        insert_new(other.keys[i]);
+      }
+    });
+  }
+
+  ~Table() { destroy_all(); }
+
+  void swap(Table &other) noexcept {
+    std::swap(alloc, other.alloc);
+    std::swap(keys, other.keys);
+    std::swap(values, other.values);
+    std::swap(capacity, other.capacity);
+    std::swap(s, other.s);
+  }
+
+  static std::size_t max_size_for(std::size_t capacity) { return capacity - capacity / 4; }
+
+  std::size_t home(Key key) const {
+    return static_cast<std::size_t>(
+               fast_hash::hash_integer(static_cast<std::uint64_t>(key))) &
+           (capacity - 1);
+  }
+
+  static void check_key(Key key) {
+    if (key == EmptyKey) {
+      throw std::invalid_argument{"IntHashMap: the empty-key sentinel cannot be stored"};
+    }
+  }
+
+  // Следующая проверка начинается за текущей; если текущая дошла до конца
+  // массива (или захватила слоты за ним) - с начала
+  std::size_t next_group(std::size_t pos) const {
+    return pos + kLanes >= capacity ? 0 : pos + kLanes;
+  }
+
+  // Индекс слота с ключом key или capacity, если ключа нет. За слотами
+  // [capacity, capacity + kLanes) - всегда свободные: свободный слот там
+  // значит не конец цепочки, а переход к началу массива
+  std::size_t find_index(Key key) const {
+    if (capacity == 0 || key == EmptyKey) {
+      return capacity;
+    }
+    std::size_t pos = home(key);
+    if constexpr (kHasValues) {
+      // Ключ обычно в домашнем слоте: значение грузится параллельно с ключом
+      prefetch(values + pos);
+    }
+    while (true) {
+      const std::uint32_t found = match(keys + pos, key);
+      const std::uint32_t empty = match(keys + pos, EmptyKey);
+      if (found != 0 && (empty == 0 || lowest_bit(found) < lowest_bit(empty))) {
+        return pos + lowest_bit(found) / sizeof(Key);
+      }
+      if (empty != 0 && pos + lowest_bit(empty) / sizeof(Key) < capacity) {
+        return capacity;
+      }
+      pos = next_group(pos);
+    }
+  }
+
+  // Первый свободный слот цепочки ключа (ключа в таблице нет)
+  std::size_t free_index(Key key) const {
+    std::size_t pos = home(key);
+    while (true) {
+      const std::uint32_t empty = match(keys + pos, EmptyKey);
+      if (empty != 0) {
+        const std::size_t index = pos + lowest_bit(empty) / sizeof(Key);
+        if (index < capacity) {
+          return index;
+        }
+      }
+      pos = next_group(pos);
+    }
+  }
+
+  // Вставляет ключ, которого в таблице нет, возвращает его слот
+  template <class... Args>
+  std::size_t insert_new(Key key, Args &&...args) {
+    if (s + 1 > max_size_for(capacity)) {
+      rehash_to(capacity ? capacity * 2 : kMinCapacity);
+    }
+    const std::size_t index = free_index(key);
+    if constexpr (kHasValues) {
+      ValueTraits::construct(alloc, values + index, std::forward<Args>(args)...);
+    }
+    keys[index] = key;
+    ++s;
+    return index;
+  }
+
+  // Удаляет слот index и сдвигает назад элементы цепочки за ним, которые
+  // могут стоять ближе к своему домашнему слоту
+  void erase_index(std::size_t index) {
+    const std::size_t mask = capacity - 1;
+    if constexpr (kHasValues) {
+      ValueTraits::destroy(alloc, values + index);
+    }
+    std::size_t hole = index;
+    for (std::size_t next = (hole + 1) & mask; keys[next] != EmptyKey; next = (next + 1) & mask) {
+      const std::size_t ideal = home(keys[next]);
+      // Элемент остается, если его домашний слот циклически в (hole, next]
+      const bool stays = hole <= next ? (hole < ideal && ideal <= next)
+                                      : (hole < ideal || ideal <= next);
+      if (stays) {
+        continue;
+      }
+      keys[hole] = keys[next];
+      if constexpr (kHasValues) {
+        ValueTraits::construct(alloc, values + hole, std::move(values[next]));
+        ValueTraits::destroy(alloc, values + next);
+      }
+      hole = next;
+    }
+    keys[hole] = EmptyKey;
+    --s;
+  }
+
+  template <class F>
+  void for_each_index(F &&fn) const {
+    for (std::size_t i = 0; i < capacity; i++) {
+      if (keys[i] != EmptyKey) {
+        fn(i);
+      }
+    }
+  }
+
+  void rehash_to(std::size_t new_capacity) {
+    KeyAllocator key_alloc(alloc);
+    Key *new_keys = KeyTraits::allocate(key_alloc, new_capacity + kLanes);
+    StoredValue *new_values = nullptr;
+    if constexpr (kHasValues) {
+      try {
+        new_values = ValueTraits::allocate(alloc, new_capacity);
+      } catch (...) {
+        KeyTraits::deallocate(key_alloc, new_keys, new_capacity + kLanes);
+        throw;
+      }
+    }
+    for (std::size_t i = 0; i < new_capacity + kLanes; i++) {
+      new_keys[i] = EmptyKey;
+    }
+
+    Key *old_keys = std::exchange(keys, new_keys);
+    StoredValue *old_values = std::exchange(values, new_values);
+    const std::size_t old_capacity = std::exchange(capacity, new_capacity);
+    for (std::size_t i = 0; i < old_capacity; i++) {
+      if (old_keys[i] != EmptyKey) {
+        const std::size_t index = free_index(old_keys[i]);
+        keys[index] = old_keys[i];
+        if constexpr (kHasValues) {
+          ValueTraits::construct(alloc, values + index, std::move(old_values[i]));
+          ValueTraits::destroy(alloc, old_values + i);
+        }
+      }
+    }
+    if (old_capacity) {
+      KeyTraits::deallocate(key_alloc, old_keys, old_capacity + kLanes);
+      if constexpr (kHasValues) {
+        ValueTraits::deallocate(alloc, old_values, old_capacity);
+      }
+    }
+  }
+
+  void reserve(std::size_t n) {
+    std::size_t new_capacity = capacity ? capacity : kMinCapacity;
+    while (max_size_for(new_capacity) < n) {
+      new_capacity *= 2;
+    }
+    if (new_capacity > capacity) {
+      rehash_to(new_capacity);
+    }
+  }
+
+  void destroy_all() {
+    if (capacity == 0) {
+      return;
+    }
+    if constexpr (kHasValues) {
+      for_each_index([&](std::size_t i) { ValueTraits::destroy(alloc, values + i); });
+      ValueTraits::deallocate(alloc, values, capacity);
+    }
+    KeyAllocator key_alloc(alloc);
+    KeyTraits::deallocate(key_alloc, keys, capacity + kLanes);
+    keys = nullptr;
+    values = nullptr;
+    capacity = 0;
+    s = 0;
+  }
+};
+
+} // namespace int_hash
+
+// Словарь с целыми ключами. API как у FlatUnorderedMap, но без итераторов
+// (ключи и значения в разных массивах, пары в памяти нет): find возвращает
+// указатель на значение, обход - for_each(fn(key, value)).
+// IntHashMap<std::uint64_t, std::uint32_t> map;
+// map[42] = 7; if (auto *v = map.find(42)) { ... }
+template <class Key, class Value, Key EmptyKey = std::numeric_limits<Key>::max(),
+          class Allocator = std::allocator<std::pair<const Key, Value>>>
+class IntHashMap {
+  int_hash::Table<Key, Value, EmptyKey, Allocator> table;
+
+public:
+  using allocator_type = Allocator;
+
+  // Создает пустой словарь. Память не выделяется до первой вставки
+  IntHashMap() : IntHashMap(Allocator()) {}
+
+  explicit IntHashMap(const Allocator &alloc) : table(alloc) {}
+
+  IntHashMap(const IntHashMap &other) = default;
+
+  // Таблица передается целиком, other остается пустым
+  IntHashMap(IntHashMap &&other) noexcept : table(Allocator(other.table.alloc)) {
+    table.swap(other.table);
+  }
+
+  IntHashMap &operator=(const IntHashMap &other) {
+    IntHashMap tmp{other};
+    table.swap(tmp.table);
+    return *this;
+  }
+
+  IntHashMap &operator=(IntHashMap &&other) noexcept {
+    IntHashMap tmp{std::move(other)};
+    table.swap(tmp.table);
+    return *this;
+  }
+
+  Allocator get_allocator() const { return Allocator(table.alloc); }
+
+  // Возвращает количество элементов
+  std::size_t size() const { return table.s; }
+
+  // Проверяет является ли словарь пустым
+  bool empty() const { return !table.s; }
+
+  // Возвращает количество слотов
+  std::size_t bucket_count() const { return table.capacity; }
+
+  // Готовит таблицу к n элементам без роста при вставке
+  void reserve(std::size_t n) { table.reserve(n); }
+
+  // Удаляет все элементы и освобождает память
+  void clear() { table.destroy_all(); }
+
+  // Возвращает элемент по ключу. Если отсутсвует, выбрасывает исключение
+  const Value &operator[](Key key) const {
+    const std::size_t index = table.find_index(key);
+    if (index == table.capacity) {
+      throw std::out_of_range{"No such a key here"};
+    }
+    return table.values[index];
+  }
+
+  // Возвращает ссылку на элемент по ключу. Если элемента нет, создает его с
+  // дефолтным значением. Ключ EmptyKey - std::invalid_argument
+  Value &operator[](Key key) {
+    std::size_t index = table.find_index(key);
+    if (index == table.capacity) {
+      table.check_key(key);
+      index = table.insert_new(key);
+    }
+    return table.values[index];
+  }
+
+  // Проверяет есть ли в контейнере элемент с таким ключом
+  bool contains(Key key) const { return table.find_index(key) != table.capacity; }
+
+  // Возвращает указатель на значение ключа или nullptr
+  Value *find(Key key) {
+    const std::size_t index = table.find_index(key);
+    return index == table.capacity ? nullptr : table.values + index;
+  }
+
+  const Value *find(Key key) const {
+    const std::size_t index = table.find_index(key);
+    return index == table.capacity ? nullptr : table.values + index;
+  }
+
+  // Добавляет элемент, если элемента с таким ключом еще нет. Возвращает,
+  // был ли он добавлен. Ключ EmptyKey - std::invalid_argument
+  bool insert(Key key, const Value &value) {
+    table.check_key(key);
+    if (table.find_index(key) != table.capacity) {
+      return false;
+    }
+    table.insert_new(key, value);
+    return true;
+  }
+
+  // Удаляет элемент по ключу и возвращает результат операции
+  bool erase(Key key) {
+    const std::size_t index = table.find_index(key);
+    if (index == table.capacity) {
+      return false;
+    }
+    table.erase_index(index);
+    return true;
+  }
+
+  // Вызывает fn(key, value) для каждого элемента
+  template <class F>
+  void for_each(F &&fn) {
+    table.for_each_index([&](std::size_t i) { fn(table.keys[i], table.values[i]); });
+  }
+
+  template <class F>
+  void for_each(F &&fn) const {
+    table.for_each_index([&](std::size_t i) {
+      fn(table.keys[i], static_cast<const Value &>(table.values[i]));
+    });
+  }
+};
+
+// Множество целых чисел на тех же массивах, только без значений
+template <class Key, Key EmptyKey = std::numeric_limits<Key>::max(),
+          class Allocator = std::allocator<Key>>
+class IntHashSet {
+  int_hash::Table<Key, void, EmptyKey, Allocator> table;
+
+public:
+  using allocator_type = Allocator;
+
+  IntHashSet() : IntHashSet(Allocator()) {}
+
+  explicit IntHashSet(const Allocator &alloc) : table(alloc) {}
+
+  IntHashSet(const IntHashSet &other) = default;
+
+  IntHashSet(IntHashSet &&other) noexcept : table(Allocator(other.table.alloc)) {
+    table.swap(other.table);
+  }
+
+  IntHashSet &operator=(const IntHashSet &other) {
+    IntHashSet tmp{other};
+    table.swap(tmp.table);
+    return *this;
+  }
+
+  IntHashSet &operator=(IntHashSet &&other) noexcept {
+    IntHashSet tmp{std::move(other)};
+    table.swap(tmp.table);
+    return *this;
+  }
+
+  Allocator get_allocator() const { return Allocator(table.alloc); }
+
+  std::size_t size() const { return table.s; }
+
+  bool empty() const { return !table.s; }
+
+  std::size_t bucket_count() const { return table.capacity; }
+
+  void reserve(std::size_t n) { table.reserve(n); }
+
+  void clear() { table.destroy_all(); }
+
+  bool contains(Key key) const { return table.find_index(key) != table.capacity; }
+
+  // Добавляет ключ, возвращает, был ли он добавлен. Ключ EmptyKey -
+  // std::invalid_argument
+  bool insert(Key key) {
+    table.check_key(key);
+    if (table.find_index(key) != table.capacity) {
+      return false;
+    }
+    table.insert_new(key);
+    return true;
+  }
+
+  bool erase(Key key) {
+    const std::size_t index = table.find_index(key);
+    if (index == table.capacity) {
+      return false;
+    }
+    table.erase_index(index);
+    return true;
+  }
+
+  // Вызывает fn(key) для каждого ключа
+  template <class F>
+  void for_each(F &&fn) const {
+    table.for_each_index([&](std::size_t i) { fn(table.keys[i]); });
+  }
+};
+
+#endif
@@ -0,0 +1,418 @@
+#ifndef LOCK_FREE_UNORDERED_MAP_H
+#define LOCK_FREE_UNORDERED_MAP_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "unordered_map.hpp"
+
+// Освобождение памяти по эпохам (epoch-based reclamation).
+//
+// Поток, который читает разделяемые узлы, "закрепляется" (pin): записывает
+// в свой слот текущую глобальную эпоху. Удаленный узел не освобождается
+// сразу, а откладывается вместе с эпохой удаления r. Глобальная эпоха
+// продвигается на 1, только когда все закрепленные потоки видели текущую,
+// поэтому к эпохе r + 2 ни один поток, который мог видеть узел, уже не
+// закреплен, и узел можно удалить.
+//
+// Читатель пишет только в свой слот (своя кеш-линия), общие данные он
+// только читает.
+//
+// Вместо барьеров (atomic_thread_fence) используются seq_cst-операции:
+// запись слота, чтение голов корзин и CAS писателей упорядочены одним
+// глобальным порядком, поэтому сборщик, увидевший слот свободным, не может
+// разминуться с читателем, который еще увидит удаленный узел. На x86
+// seq_cst-чтение - обычный mov, а ThreadSanitizer барьеры не понимает.
+namespace epoch {
+
+inline constexpr std::size_t kMaxThreads = 256;
+
+// Раздает потокам номера слотов [0, kMaxThreads), номер завершившегося
+// потока переиспользуется
+class ThreadRegistry {
+  std::mutex mutex;
+  std::vector<std::size_t> free;
+  std::size_t next = 0;
+
+public:
+  std::size_t acquire() {
+    std::lock_guard lock(mutex);
+    if (!free.empty()) {
+      std::size_t index = free.back();
+      free.pop_back();
+      return index;
+    }
+    if (next == kMaxThreads) {
+      throw std::length_error("epoch: too many threads");
+    }
+    return next++;
+  }
+
+  void release(std::size_t index) {
+    std::lock_guard lock(mutex);
+    free.push_back(index);
+  }
+};
+
+inline ThreadRegistry &registry() {
+  static ThreadRegistry instance;
+  return instance;
+}
+
+struct ThreadIndex {
+  std::size_t value;
+  ThreadIndex() : value(registry().acquire()) {}
+  ~ThreadIndex() { registry().release(value); }
+};
+
+inline std::size_t thread_index() {
+  thread_local ThreadIndex index;
+  return index.value;
+}
+
+// Эпохи для одной структуры данных
+class Domain {
+  static constexpr std::uint64_t kIdle = std::numeric_limits<std::uint64_t>::max();
+  // Сколько отложенных узлов копит поток перед попыткой освободить их
+  static constexpr std::size_t kCollectThreshold = 64;
+
+  struct Retired {
+    void *ptr;
+    void (*deleter)(void *);
+    std::uint64_t epoch;
+  };
+
+  // Слот потока. retired трогает только сам поток, поэтому без блокировок
+  struct alignas(64) Slot {
+    std::atomic<std::uint64_t> epoch{kIdle};
+    std::size_t depth = 0;
+    std::vector<Retired> retired;
+  };
+
+  alignas(64) std::atomic<std::uint64_t> global{0};
+  std::unique_ptr<Slot[]> slots{new Slot[kMaxThreads]};
+
+  // Продвигает глобальную эпоху, если все закрепленные потоки ее видели
+  void try_advance() {
+    std::uint64_t current = global.load(std::memory_order_seq_cst);
+    for (std::size_t i = 0; i < kMaxThreads; i++) {
+      std::uint64_t seen = slots[i].epoch.load(std::memory_order_seq_cst);
+      if (seen != kIdle && seen != current) {
+        return;
+      }
+    }
+    global.compare_exchange_strong(current, current + 1, std::memory_order_seq_cst);
+  }
+
+  void collect(Slot &slot) {
+    try_advance();
+    std::uint64_t current = global.load(std::memory_order_acquire);
+    auto &retired = slot.retired;
+    std::size_t kept = 0;
+    for (auto &item : retired) {
+      if (item.epoch + 2 <= current) {
+        item.deleter(item.ptr);
+      } else {
+        retired[kept++] = item;
+      }
+    }
+    retired.resize(kept);
+  }
+
+public:
+  Domain() = default;
+  Domain(const Domain &) = delete;
+  Domain &operator=(const Domain &) = delete;
+
+  // Освобождает все отложенное. Вызывать, когда других потоков уже нет
+  ~Domain() {
+    for (std::size_t i = 0; i < kMaxThreads; i++) {
+      for (auto &item : slots[i].retired) {
+        item.deleter(item.ptr);
+      }
+    }
+  }
+
+  // Пока Guard жив, узлы, прочитанные потоком, не будут освобождены.
+  // Вложенные Guard в одном потоке допустимы
+  class Guard {
+    Slot *slot;
+
+  public:
+    explicit Guard(Slot *slot) : slot{slot} {}
+    Guard(const Guard &) = delete;
+    Guard &operator=(const Guard &) = delete;
+    ~Guard() {
+      if (--slot->depth == 0) {
+        slot->epoch.store(kIdle, std::memory_order_release);
+      }
+    }
+  };
+
+  Guard pin() {
+    Slot *slot = &slots[thread_index()];
+    if (slot->depth++ == 0) {
+      // Запись слота должна стать видна раньше, чем поток прочитает узлы
+      slot->epoch.exchange(global.load(std::memory_order_relaxed), std::memory_order_seq_cst);
+    }
+    return Guard{slot};
+  }
+
+  // Откладывает удаление ptr, который уже недостижим для новых читателей
+  template <class T>
+  void retire(T *ptr) {
+    Slot &slot = slots[thread_index()];
+    slot.retired.push_back({ptr, [](void *p) { delete static_cast<T *>(p); },
+                            global.load(std::memory_order_acquire)});
+    if (slot.retired.size() >= kCollectThreshold) {
+      collect(slot);
+    }
+  }
+};
+
+} // namespace epoch
+
+// Словарь для таблиц, которые читают на порядки чаще, чем меняют.
+//
+// Поиск не берет блокировок и ничего не пишет в общую память: он проходит
+// по цепочке неизменяемых узлов. Писатель меняет корзину одной операцией
+// CAS над ее головой: вставка добавляет узел в начало цепочки, а удаление и
+// замена значения копируют узлы перед изменяемым (хвост цепочки остается
+// общим). Если другой писатель успел изменить ту же корзину, CAS не
+// проходит и операция повторяется. Старые узлы освобождаются через эпохи
+// (epoch::Domain), когда их гарантированно никто не читает.
+//
+// Число корзин задается в конструкторе и не меняется: при заполнении выше
+// bucket_count цепочки просто удлиняются. Наружу отдаются копии значений;
+// без копирования значение можно прочитать через visit.
+template <class Key, class Value, class Hash = DefaultHash<Key>,
+          class KeyEqual = DefaultKeyEqual<Key>>
+class LockFreeUnorderedMap {
+private:
+  struct Node {
+    const Key key;
+    const Value value;
+    Node *next;
+  };
+
+  std::unique_ptr<std::atomic<Node *>[]> buckets;
+  std::size_t mask;
+  std::atomic<std::size_t> count{0};
+  Hash hasher;
+  KeyEqual equal;
+  mutable epoch::Domain domain;
+
+  static std::size_t round_up_to_power_of_two(std::size_t n) {
+    if (n > (std::numeric_limits<std::size_t>::max() >> 1) + 1) {
+      throw std::length_error("too many buckets");
+    }
+    std::size_t result = 1;
+    while (result < n) {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  template <class K>
+  std::atomic<Node *> &bucket_for(const K &key) const {
+    return buckets[hasher(key) & mask];
+  }
+
+  template <class K>
+  Node *find_node(const K &key) const {
+    Node *node = bucket_for(key).load(std::memory_order_seq_cst);
+    while (node != nullptr && !equal(node->key, key)) {
+      node = node->next;
+    }
+    return node;
+  }
+
+  // Заменяет в цепочке head узел target на replacement (nullptr - удалить):
+  // копирует узлы перед target и ставит новую цепочку CAS'ом. При неудаче
+  // копии удаляются и возвращается false
+  bool replace(std::atomic<Node *> &bucket, Node *head, Node *target, Node *replacement) {
+    Node *tail = replacement != nullptr ? replacement : target->next;
+    Node *new_head = tail;
+    Node **link = &new_head;
+    for (Node *node = head; node != target; node = node->next) {
+      Node *copy = new Node{node->key, node->value, tail};
+      *link = copy;
+      link = &copy->next;
+    }
+    if (bucket.compare_exchange_strong(head, new_head, std::memory_order_seq_cst)) {
+      for (Node *node = head; node != target;) {
+        Node *next = node->next;
+        domain.retire(node);
+        node = next;
+      }
+      domain.retire(target);
+      return true;
+    }
+    for (Node *node = new_head; node != tail;) {
+      Node *next = node->next;
+      delete node;
+      node = next;
+    }
+    return false;
+  }
+
+public:
+  explicit LockFreeUnorderedMap(std::size_t bucket_count = 1024, const Hash &hash = Hash(),
+                                const KeyEqual &key_equal = KeyEqual())
+      : buckets(new std::atomic<Node *>[round_up_to_power_of_two(bucket_count)]),
+        mask(round_up_to_power_of_two(bucket_count) - 1), hasher(hash), equal(key_equal) {
+    for (std::size_t i = 0; i <= mask; i++) {
+      buckets[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  LockFreeUnorderedMap(const LockFreeUnorderedMap &) = delete;
+  LockFreeUnorderedMap &operator=(const LockFreeUnorderedMap &) = delete;
+
+  // Других потоков, работающих со словарем, к этому моменту быть не должно
+  ~LockFreeUnorderedMap() {
+    for (std::size_t i = 0; i <= mask; i++) {
+      Node *node = buckets[i].load(std::memory_order_relaxed);
+      while (node != nullptr) {
+        Node *next = node->next;
+        delete node;
+        node = next;
+      }
+    }
+  }
+
+  std::size_t bucket_count() const { return mask + 1; }
+
+  // Число элементов; при параллельной записи - приблизительное
+  std::size_t size() const { return count.load(std::memory_order_relaxed); }
+
+  bool empty() const { return size() == 0; }
+
+  // Вызывает fn(value) для значения ключа, не копируя его. Возвращает
+  // false, если ключа нет. Значение остается живым до выхода из fn
+  template <class K, class F>
+  bool visit(const K &key, F &&fn) const {
+    auto guard = domain.pin();
+    Node *node = find_node(key);
+    if (node == nullptr) {
+      return false;
+    }
+    fn(node->value);
+    return true;
+  }
+
+  // Возвращает копию значения или nullopt, если ключа нет
+  template <class K>
+  std::optional<Value> find(const K &key) const {
+    auto guard = domain.pin();
+    Node *node = find_node(key);
+    if (node == nullptr) {
+      return std::nullopt;
+    }
+    return node->value;
+  }
+
+  template <class K>
+  bool contains(const K &key) const {
+    auto guard = domain.pin();
+    return find_node(key) != nullptr;
+  }
+
+  // Вставляет пару, если ключа еще нет. Возвращает true, если вставил
+  bool insert(const Key &key, const Value &value) {
+    auto guard = domain.pin();
+    auto &bucket = bucket_for(key);
+    Node *head = bucket.load(std::memory_order_seq_cst);
+    Node *node = nullptr;
+    while (true) {
+      Node *found = head;
+      while (found != nullptr && !equal(found->key, key)) {
+        found = found->next;
+      }
+      if (found != nullptr) {
+        delete node;
+        return false;
+      }
+      if (node == nullptr) {
+        node = new Node{key, value, head};
+      }
+      node->next = head;
+      // При неудаче head получает новую голову корзины
+      if (bucket.compare_exchange_weak(head, node, std::memory_order_seq_cst)) {
+        count.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+  }
+
+  // Вставляет пару или заменяет значение. Возвращает true, если вставил
+  bool insert_or_assign(const Key &key, const Value &value) {
+    auto guard = domain.pin();
+    auto &bucket = bucket_for(key);
+    while (true) {
+      Node *head = bucket.load(std::memory_order_seq_cst);
+      Node *found = head;
+      while (found != nullptr && !equal(found->key, key)) {
+        found = found->next;
+      }
+      if (found == nullptr) {
+        auto *node = new Node{key, value, head};
+        if (bucket.compare_exchange_strong(head, node, std::memory_order_seq_cst)) {
+          count.fetch_add(1, std::memory_order_relaxed);
+          return true;
+        }
+        delete node;
+        continue;
+      }
+      auto *node = new Node{key, value, found->next};
+      if (replace(bucket, head, found, node)) {
+        return false;
+      }
+      delete node;
+    }
+  }
+
+  // Удаляет ключ. Возвращает true, если он был
+  template <class K>
+  bool erase(const K &key) {
+    auto guard = domain.pin();
+    auto &bucket = bucket_for(key);
+    while (true) {
+      Node *head = bucket.load(std::memory_order_seq_cst);
+      Node *found = head;
+      while (found != nullptr && !equal(found->key, key)) {
+        found = found->next;
+      }
+      if (found == nullptr) {
+        return false;
+      }
+      if (replace(bucket, head, found, nullptr)) {
+        count.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+  }
+
+  // Вызывает fn(key, value) для каждого элемента. Параллельные изменения
+  // могут быть видны частично
+  template <class F>
+  void for_each(F &&fn) const {
+    auto guard = domain.pin();
+    for (std::size_t i = 0; i <= mask; i++) {
+      for (Node *node = buckets[i].load(std::memory_order_seq_cst); node != nullptr;
+           node = node->next) {
+        fn(node->key, node->value);
+      }
+    }
+  }
+};
+
+#endif
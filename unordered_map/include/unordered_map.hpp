@@ -2,32 +2,437 @@
 #ifndef UNORDERED_MAP_H
 #define UNORDERED_MAP_H
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
 #include <list>
+#include <memory>
+#include <ostream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
-template <class Key, class Value> 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+#include "fast_hash.hpp"
+#include "snapshot.hpp"
+
+// Хеш ключей по умолчанию. Для строк он прозрачный (is_transparent): строка,
+// std::string_view и const char* хешируются одинаково (как string_view),
+// поэтому map.find(std::string_view{...}) ищет без временной std::string
+template <class Key>
+struct DefaultHash {
+  std::size_t operator()(const Key &key) const { return std::hash<Key>{}(key); }
+};
+
+template <class Char, class Traits, class Alloc>
+struct DefaultHash<std::basic_string<Char, Traits, Alloc>> {
+  using is_transparent = void;
+  std::size_t operator()(std::basic_string_view<Char, Traits> key) const {
+    return std::hash<std::basic_string_view<Char, Traits>>{}(key);
+  }
+};
+
+// Сравнение ключей по умолчанию, для строк тоже прозрачное
+template <class Key>
+struct DefaultKeyEqual : std::equal_to<Key> {};
+
+template <class Char, class Traits, class Alloc>
+struct DefaultKeyEqual<std::basic_string<Char, Traits, Alloc>> : std::equal_to<> {};
+
+// Hash и KeyEqual - хеш и сравнение ключей (быстрый хеш - FastHash из
+// fast_hash.hpp). Поиск по ключу другого типа работает, если оба прозрачные.
+// Allocator - аллокатор пар ключ-значение (по умолчанию std::allocator).
+// Через него (rebind) выделяются и узлы цепочек, и массив корзин.
+// Порядок этих параметров тот же, что у std::unordered_map.
+// CacheHash - хранить в узле полный хеш ключа: ключи сравниваются только
+// при совпадении хешей, а rehash не хеширует ключи заново. Выгодно для
+// длинных строк, для чисел это лишние 8 байт на узел
+template <class Key, class Value, class Hash = DefaultHash<Key>,
+          class KeyEqual = DefaultKeyEqual<Key>,
+          class Allocator = std::allocator<std::pair<const Key, Value>>,
+          bool CacheHash = false>
 class UnorderedMap {
+public:
+  template <bool Const>
+  class BasicIterator;
+  using Iterator = BasicIterator<false>;
+  using ConstIterator = BasicIterator<true>;
+  using allocator_type = Allocator;
+
 private:
   using ValueType = std::pair<Key, Value>;
-  std::vector<std::list<ValueType>> data{};
+  using AllocTraits = std::allocator_traits<Allocator>;
+
+  struct HashSlot {
+    std::size_t hash;
+  };
+  struct NoHashSlot {};
+
+  // Узел цепочки: пара и, при CacheHash, ее хеш
+  struct Node : std::conditional_t<CacheHash, HashSlot, NoHashSlot> {
+    ValueType kv;
+
+    template <class... Args>
+    explicit Node(std::in_place_t, Args &&...args) : kv(std::forward<Args>(args)...) {}
+  };
+
+  using Bucket = std::list<Node, typename AllocTraits::template rebind_alloc<Node>>;
+  using Buckets =
+      std::vector<Bucket, typename AllocTraits::template rebind_alloc<Bucket>>;
+  // Количество корзин всегда степень двойки, поэтому корзина ключа -
+  // младшие биты хеша (маска вместо деления)
+  Buckets data{};
   std::size_t s = 0;
+  float mlf = 1.0f;
+  Hash hasher;
+  KeyEqual equal;
+
+  // Инкрементальное перехеширование (step > 0). Пока migrating, data -
+  // старые корзины, а next - новые (вдвое больше), которые строятся по
+  // порядку, по step штук за изменяющую операцию. Новая корзина j собирает
+  // из старой j & (data.size() - 1) ключи, у которых младшие биты хеша
+  // равны j, поэтому ключ уже перенесен, если его новая корзина построена
+  // (меньше next.size()), иначе он в старой. После переноса массивы
+  // меняются местами, и пустые старые корзины так же по частям удаляются
+  // из next, чтобы и их освобождение не было одной долгой операцией
+  Buckets next{};
+  std::size_t step = 0;
+  bool migrating = false;
+
+  // Сколько пустых старых корзин удаляется за операцию на один шаг
+  static constexpr std::size_t kDrainPerStep = 4;
+
+  std::size_t bucket_index(std::size_t hashed) const { return hashed & (data.size() - 1); }
+
+  std::size_t next_index(std::size_t hashed) const { return hashed & (2 * data.size() - 1); }
+
+  // Лежит ли ключ с хешем hashed уже в новых корзинах
+  bool moved(std::size_t hashed) const { return migrating && next_index(hashed) < next.size(); }
+
+  Bucket &bucket_of(std::size_t hashed) {
+    return moved(hashed) ? next[next_index(hashed)] : data[bucket_index(hashed)];
+  }
+
+  const Bucket &bucket_of(std::size_t hashed) const {
+    return moved(hashed) ? next[next_index(hashed)] : data[bucket_index(hashed)];
+  }
+
+  std::size_t node_hash(const Node &node) const {
+    if constexpr (CacheHash) {
+      return node.hash;
+    } else {
+      return hasher(node.kv.first);
+    }
+  }
+
+  static void store_hash([[maybe_unused]] Node &node, [[maybe_unused]] std::size_t hashed) {
+    if constexpr (CacheHash) {
+      node.hash = hashed;
+    }
+  }
+
+  // Ищет ключ с хешем hashed в корзине, возвращает узел или bucket.end()
+  template <class K, class Nodes>
+  auto find_in(Nodes &bucket, const K &key, [[maybe_unused]] std::size_t hashed) const {
+    auto it = bucket.begin();
+    for (; it != bucket.end(); ++it) {
+      if constexpr (CacheHash) {
+        if (it->hash != hashed) {
+          continue;
+        }
+      }
+      if (equal(it->kv.first, key)) {
+        break;
+      }
+    }
+    return it;
+  }
+
+  void swap(UnorderedMap &other) {
+    std::swap(data, other.data);
+    std::swap(s, other.s);
+    std::swap(mlf, other.mlf);
+    std::swap(hasher, other.hasher);
+    std::swap(equal, other.equal);
+    std::swap(next, other.next);
+    std::swap(step, other.step);
+    std::swap(migrating, other.migrating);
+  }
 
-  void set(const Key &key, Value &value) {
-    std::size_t hashed = std::hash<Key>{}(key);
-    data[hashed % data.size()].push_front({key, value});
+  // Один проход по корзине ключа key с хешем hashed: возвращает итератор на
+  // ключ и false, если он уже есть, иначе создает пару из make_pair() в
+  // конце корзины и возвращает итератор на нее и true
+  template <class K, class MakePair>
+  std::pair<Iterator, bool> find_or_insert(const K &key, std::size_t hashed,
+                                           MakePair make_pair) {
+    auto &bucket = bucket_of(hashed);
+    auto it = find_in(bucket, key, hashed);
+    if (it != bucket.end()) {
+      return {iterator_at(hashed, it), false};
+    }
+    make_pair(bucket);
     ++s;
+    it = std::prev(bucket.end());
+    store_hash(*it, hashed);
+    // rehash переносит узлы через splice, итератор узла остается валидным
+    grow_if_needed();
+    return {iterator_at(hashed, it), true};
+  }
+
+  // Во время переноса обход идет сначала по новым корзинам, потом по старым
+  Iterator iterator_at(std::size_t hashed, typename Bucket::iterator node) {
+    if (moved(hashed)) {
+      return Iterator{next.begin() + next_index(hashed), --next.end(), node, data.begin(),
+                      --data.end()};
+    }
+    return Iterator{data.begin() + bucket_index(hashed), --data.end(), node};
+  }
+
+  ConstIterator iterator_at(std::size_t hashed, typename Bucket::const_iterator node) const {
+    if (moved(hashed)) {
+      return ConstIterator{next.begin() + next_index(hashed), --next.end(), node, data.begin(),
+                           --data.end()};
+    }
+    return ConstIterator{data.begin() + bucket_index(hashed), --data.end(), node};
+  }
+
+  template <class K>
+  Iterator find_key(const K &key, std::size_t hashed) {
+    auto &bucket = bucket_of(hashed);
+    auto it = find_in(bucket, key, hashed);
+    return it == bucket.end() ? end() : iterator_at(hashed, it);
+  }
+
+  template <class K>
+  ConstIterator find_key(const K &key, std::size_t hashed) const {
+    const auto &bucket = bucket_of(hashed);
+    auto it = find_in(bucket, key, hashed);
+    return it == bucket.end() ? end() : iterator_at(hashed, it);
+  }
+
+  bool erase_key(const Key &key, std::size_t hashed) {
+    auto &collisions = bucket_of(hashed);
+    auto it = find_in(collisions, key, hashed);
+    if (it == collisions.end()) {
+      return false;
+    }
+    collisions.erase(it);
+    --s;
+    if (step > 0) {
+      advance_rehash();
+    }
+    return true;
+  }
+
+  // Подсказка процессору заранее загрузить кеш-линию с addr
+  static void prefetch([[maybe_unused]] const void *addr) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(addr);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<const char *>(addr), _MM_HINT_T0);
+#endif
+  }
+
+  // Пакетный поиск идет конвейером: ключ i хешируется и запрашивается его
+  // корзина, для ключа i - kPrefetchDistance (корзина уже в кеше)
+  // запрашивается первый узел цепочки, а ключ i - 2 * kPrefetchDistance
+  // сравнивается. Так промахи кеша многих ключей ожидаются одновременно,
+  // а не по очереди. resolve(i, hashed, bucket) вызывается по порядку
+  static constexpr std::size_t kPrefetchDistance = 8;
+  static constexpr std::size_t kBatchRing = 4 * kPrefetchDistance;
+
+  template <class K, class Resolve>
+  void for_each_in_batch(const K *keys, std::size_t count, Resolve resolve) const {
+    std::size_t hashes[kBatchRing];
+    for (std::size_t i = 0; i < count + 2 * kPrefetchDistance; i++) {
+      if (i < count) {
+        hashes[i % kBatchRing] = hasher(keys[i]);
+        prefetch(&bucket_of(hashes[i % kBatchRing]));
+      }
+      if (i >= kPrefetchDistance && i - kPrefetchDistance < count) {
+        const Bucket &bucket = bucket_of(hashes[(i - kPrefetchDistance) % kBatchRing]);
+        if (!bucket.empty()) {
+          prefetch(&bucket.front());
+        }
+      }
+      if (i >= 2 * kPrefetchDistance) {
+        std::size_t k = i - 2 * kPrefetchDistance;
+        std::size_t hashed = hashes[k % kBatchRing];
+        resolve(k, hashed, bucket_of(hashed));
+      }
+    }
+  }
+
+  // Старшая степень двойки, которая помещается в size_t
+  static constexpr std::size_t kMaxPowerOfTwo = (std::numeric_limits<std::size_t>::max() >> 1) + 1;
+
+  // Наименьшая степень двойки, не меньшая n (и не меньшая 1). Если n больше
+  // kMaxPowerOfTwo, такой степени в size_t нет - бросает length_error
+  static std::size_t round_up_to_power_of_two(std::size_t n) {
+    if (n > kMaxPowerOfTwo) {
+      throw std::length_error{"too many buckets"};
+    }
+    std::size_t result = 1;
+    while (result < n) {
+      result *= 2;
+    }
+    return result;
+  }
+
+  // Сколько корзин нужно для count элементов при текущем max_load_factor.
+  // Если ответ не помещается в size_t, бросает length_error (приведение
+  // такого double к size_t - неопределенное поведение)
+  std::size_t buckets_for(std::size_t count) const {
+    const double buckets = std::ceil(static_cast<double>(count) / mlf);
+    if (!(buckets < static_cast<double>(kMaxPowerOfTwo) * 2)) {
+      throw std::length_error{"too many buckets"};
+    }
+    return static_cast<std::size_t>(buckets);
+  }
+
+  // Строит до count следующих новых корзин; когда построены все,
+  // новые корзины становятся data
+  void migrate(std::size_t count) {
+    const std::size_t old_count = data.size();
+    for (; count > 0 && next.size() < 2 * old_count; --count) {
+      const std::size_t j = next.size();
+      next.emplace_back(data.front().get_allocator());
+      Bucket &target = next.back();
+      Bucket &source = data[j & (old_count - 1)];
+      if (j >= old_count) {
+        // В старой корзине остались только ключи этой новой корзины
+        target.splice(target.end(), source);
+        continue;
+      }
+      for (auto it = source.begin(); it != source.end();) {
+        auto node = it++;
+        if (next_index(node_hash(*node)) == j) {
+          target.splice(target.end(), source, node);
+        }
+      }
+    }
+    if (next.size() == 2 * old_count) {
+      std::swap(data, next);
+      migrating = false;
+    }
+  }
+
+  // Удаляет до count пустых старых корзин после переноса
+  void drain(std::size_t count) {
+    for (; count > 0 && !next.empty(); --count) {
+      next.pop_back();
+    }
+    if (next.empty()) {
+      Buckets(next.get_allocator()).swap(next);
+    }
+  }
+
+  // Шаг инкрементального перехеширования, выполняется изменяющими операциями
+  void advance_rehash() {
+    if (migrating) {
+      migrate(step);
+    } else if (!next.empty()) {
+      drain(step * kDrainPerStep);
+    }
+  }
+
+  // Доводит начатый перенос до конца разом
+  void finish_rehash() {
+    if (migrating) {
+      migrate(2 * data.size());
+    }
+    drain(next.size());
+  }
+
+  // Вызывается после добавления элемента: если коэффициент заполнения
+  // превысил max_load_factor, корзин становится вдвое больше - сразу или,
+  // при step > 0, начинается перенос по частям
+  void grow_if_needed() {
+    if (step > 0) {
+      advance_rehash();
+    }
+    if (static_cast<double>(s) <= static_cast<double>(bucket_count()) * mlf) {
+      return;
+    }
+    if (step == 0) {
+      rehash(data.size() * 2);
+      return;
+    }
+    // Прошлый перенос не успел закончиться (step слишком мал для такого
+    // роста) - он завершается здесь целиком
+    finish_rehash();
+    next.reserve(2 * data.size());
+    migrating = true;
+    migrate(step);
   }
 
 public:
-  class Iterator;
-  class ConstIterator;
+  // Владелец узла, вынутого из словаря (extract): список из одного узла
+  // (или пустой) с аллокатором словаря. Узел переносится между списками
+  // через splice, поэтому extract и insert(node_type&&) не выделяют память
+  // и не копируют пару
+  class NodeHandle {
+    friend UnorderedMap;
+
+    Bucket node;
+
+    explicit NodeHandle(const typename Bucket::allocator_type &alloc) : node(alloc) {}
+
+  public:
+    NodeHandle() = default;
+    NodeHandle(NodeHandle &&) = default;
+    NodeHandle &operator=(NodeHandle &&) = default;
+
+    bool empty() const { return node.empty(); }
+    explicit operator bool() const { return !node.empty(); }
+
+    // Ключ можно менять, пока узел не в словаре
+    Key &key() { return node.front().kv.first; }
+    const Key &key() const { return node.front().kv.first; }
+    Value &mapped() { return node.front().kv.second; }
+    const Value &mapped() const { return node.front().kv.second; }
+
+    Allocator get_allocator() const { return Allocator(node.get_allocator()); }
+  };
+  using node_type = NodeHandle;
+
+  // Результат insert(node_type&&)
+  struct insert_return_type {
+    Iterator position;
+    bool inserted;
+    node_type node;
+  };
+
   // Создает пустой словарь
-  UnorderedMap() : data{8} {}
+  UnorderedMap() : UnorderedMap(Allocator()) {}
+
+  // Создает пустой словарь, память которого выделяет alloc
+  explicit UnorderedMap(const Allocator &alloc)
+      : UnorderedMap(8, alloc) {}
+
+  // Создает пустой словарь хотя бы с bucket_count корзинами (округляется
+  // вверх до степени двойки)
+  explicit UnorderedMap(std::size_t bucket_count, const Allocator &alloc = Allocator())
+      : UnorderedMap(bucket_count, Hash(), KeyEqual(), alloc) {}
+
+  // То же с заданными объектами хеша и сравнения (если у них есть состояние)
+  UnorderedMap(std::size_t bucket_count, const Hash &hash,
+               const KeyEqual &key_equal = KeyEqual(), const Allocator &alloc = Allocator())
+      : data(round_up_to_power_of_two(bucket_count),
+             Bucket(typename Bucket::allocator_type(alloc)),
+             typename Buckets::allocator_type(alloc)),
+        hasher(hash), equal(key_equal), next(typename Buckets::allocator_type(alloc)) {}
 
   // Создает новый UnorderedMap, являющийся глубокой копией other [O(n)]
   // UnorderedMap<std::string, int>  map;
@@ -37,43 +442,59 @@ public:
   // copied["something"] == map["something"] == 69
   UnorderedMap(const UnorderedMap &other) = default;
 
-  // Конструктор перемещения
-  UnorderedMap(UnorderedMap &&other) {
-    std::swap(data, other.data);
-    std::swap(s, other.s);
+  // Конструктор перемещения. other остается пустым словарем с 8 корзинами
+  UnorderedMap(UnorderedMap &&other)
+      : UnorderedMap(8, other.hasher, other.equal, other.get_allocator()) {
+    swap(other);
   }
 
   // Перезаписывает текущий словарь словарем other
   UnorderedMap &operator=(const UnorderedMap &other) {
     UnorderedMap tmp{other};
-    std::swap(data, tmp.data);
-    std::swap(s, tmp.s);
+    swap(tmp);
     return *this;
   }
 
   // Присваивание перемещением
   UnorderedMap &operator=(UnorderedMap &&other) {
     UnorderedMap tmp{std::move(other)};
-    std::swap(data, tmp.data);
-    std::swap(s, tmp.s);
+    swap(tmp);
     return *this;
   }
 
   ~UnorderedMap() = default;
 
+  Allocator get_allocator() const { return Allocator(data.get_allocator()); }
+
+  Hash hash_function() const { return hasher; }
+
+  KeyEqual key_eq() const { return equal; }
+
   // Возвращает итератор на первый элемент
-  Iterator begin() { return Iterator{data.begin(), --data.end()}; }
+  Iterator begin() {
+    if (migrating && !next.empty()) {
+      return Iterator{next.begin(), --next.end(), next.front().begin(), data.begin(),
+                      --data.end()};
+    }
+    return Iterator{data.begin(), --data.end(), data.front().begin()};
+  }
 
   // Возвращает константный итератор на первый элемент
   ConstIterator begin() const {
-    return ConstIterator{Iterator{data.begin(), --data.end()}};
+    if (migrating && !next.empty()) {
+      return ConstIterator{next.begin(), --next.end(), next.front().begin(), data.begin(),
+                           --data.end()};
+    }
+    return ConstIterator{data.begin(), --data.end(), data.front().begin()};
   }
 
   // Возвращает итератор обозначающий конец контейнера (за последним элементом)
-  Iterator end() { return Iterator{data.end()-1}; }
+  Iterator end() { return Iterator{--data.end(), --data.end(), data.back().end()}; }
 
   // Возвращает константный итератор, обозначающий конец контейнера
-  ConstIterator end() const { return ConstIterator{Iterator{data.end() - 1}}; }
+  ConstIterator end() const {
+    return ConstIterator{--data.end(), --data.end(), data.back().end()};
+  }
 
   // Возвращает размер UnorderedMap (сколько элементов добавлено)
   std::size_t size() const {
@@ -83,51 +504,242 @@ public:
   // Проверяет является ли UnorderedMap пустым
   bool empty() const { return !s; }
 
-  // Возвращает элемент по ключу. Если отсутсвует, выбрасывает исключение
-  const Value &operator[](Key key) const {
-    size_t hashed = std::hash<Key>{}(key);
-    for (const auto& pair : data[hashed % data.size()]) {
-      if (key == pair.first) {
-        return pair.second;
+  // Возвращает количество корзин (степень двойки). Во время переноса -
+  // количество новых корзин
+  std::size_t bucket_count() const { return migrating ? 2 * data.size() : data.size(); }
+
+  // Среднее количество элементов в корзине
+  float load_factor() const {
+    return static_cast<float>(s) / static_cast<float>(bucket_count());
+  }
+
+  // Максимальный коэффициент заполнения: когда load_factor() его превышает,
+  // количество корзин удваивается. По умолчанию 1
+  float max_load_factor() const { return mlf; }
+
+  // Меняет максимальный коэффициент заполнения (должен быть > 0) и, если
+  // нужно, сразу перехеширует словарь под новое значение
+  void max_load_factor(float f) {
+    if (!(f > 0)) {
+      throw std::invalid_argument{"max_load_factor must be positive"};
+    }
+    mlf = f;
+    if (static_cast<double>(s) > static_cast<double>(bucket_count()) * mlf) {
+      rehash(0);
+    }
+  }
+
+  // Включает инкрементальное перехеширование: при росте словаря корзины
+  // переносятся не разом, а по buckets штук за каждую вставку и удаление,
+  // так что ни одна операция не перехеширует всю таблицу. Чем меньше
+  // buckets, тем короче самая долгая вставка; чтобы перенос успевал до
+  // следующего удвоения, нужно buckets >= 3 / max_load_factor() (иначе
+  // остаток переноса выполнится разом). 0 (по умолчанию) - перехеширование
+  // сразу целиком. Поиск корзины не переносит: find и итераторы не меняют
+  // словарь. Вставка, из-за которой растет таблица, и любой шаг переноса
+  // (в этом режиме - каждая вставка и удаление) делают итераторы
+  // невалидными, как и rehash; ссылки и указатели на элементы остаются
+  // валидными: узлы перевешиваются, а не копируются
+  void rehash_step(std::size_t buckets) {
+    step = buckets;
+    if (step == 0) {
+      finish_rehash();
+    }
+  }
+
+  std::size_t rehash_step() const { return step; }
+
+  // Делает корзин хотя бы count и не меньше, чем нужно для size() элементов
+  // при max_load_factor() (округляя до степени двойки). Может и уменьшить
+  // количество корзин. Узлы списков переносятся между корзинами через
+  // splice, без выделения памяти и копирования элементов. Если столько
+  // корзин не помещается в size_t, бросает length_error [O(n)]
+  void rehash(std::size_t count) {
+    finish_rehash();
+    const std::size_t new_count =
+        round_up_to_power_of_two(std::max(count, buckets_for(s)));
+    if (new_count == data.size()) {
+      return;
+    }
+    Buckets new_data(new_count, Bucket(data.front().get_allocator()), data.get_allocator());
+    const std::size_t mask = new_count - 1;
+    for (auto &bucket : data) {
+      while (!bucket.empty()) {
+        // При CacheHash ключ не хешируется заново
+        auto &target = new_data[node_hash(bucket.front()) & mask];
+        target.splice(target.end(), bucket, bucket.begin());
       }
     }
-    throw std::out_of_range{"No such a key here"};
+    std::swap(data, new_data);
+  }
+
+  // Готовит словарь к count элементам: вставки до этого размера не будут
+  // перехешировать
+  void reserve(std::size_t count) {
+    if (buckets_for(count) > bucket_count()) {
+      rehash(buckets_for(count));
+    }
+  }
+
+  // Возвращает элемент по ключу. Если отсутсвует, выбрасывает исключение
+  const Value &operator[](const Key &key) const {
+    auto it = find(key);
+    if (it == end()) {
+      throw std::out_of_range{"No such a key here"};
+    }
+    return it->second;
   }
 
   // Возвращает ссылку на элемент по Key (позволяет менять элемент). Если
   // элемент с таким ключом отсутствует, создает его и инициализирует дефолтным
   // значением map["something"] = 75;
-  Value &operator[](Key key) {
-    size_t hashed = std::hash<Key>{}(key);
-     for (auto& pair : data[hashed % data.size()]) {
-      if (key == pair.first) {
-        return pair.second;
-      }
-    }
-    insert(key, Value{});
-    return (*find(key)).second;
-  }
+  // Ключ хешируется и ищется в корзине один раз
+  Value &operator[](const Key &key) { return try_emplace(key).first->second; }
+
+  Value &operator[](Key &&key) { return try_emplace(std::move(key)).first->second; }
 
   // Проверяет есть ли в контейнере элемент с таким Key
-  bool contains(const Key &key) const {
-    size_t idx = std::hash<Key>{}(key);
-    for (const auto& it : data[idx % data.size()]) {
-      if(it.first == key) {
-        return true;
-      }
+  bool contains(const Key &key) const { return find(key) != end(); }
+
+  // Возвращяет Итератор на элемент который ищем, если нет такого элемента
+  // возвращает end()
+  Iterator find(const Key &key) { return find_key(key, hasher(key)); }
+
+  ConstIterator find(const Key &key) const { return find_key(key, hasher(key)); }
+
+  // Поиск по значению другого типа без создания Key, если хеш прозрачный:
+  // UnorderedMap<std::string, int> map;
+  // map.find(std::string_view{"abc"}); map.contains("abc");
+  template <class K, class H = Hash, class E = KeyEqual, class = typename H::is_transparent,
+            class = typename E::is_transparent>
+  Iterator find(const K &key) {
+    return find_key(key, hasher(key));
+  }
+
+  template <class K, class H = Hash, class E = KeyEqual, class = typename H::is_transparent,
+            class = typename E::is_transparent>
+  ConstIterator find(const K &key) const {
+    return find_key(key, hasher(key));
+  }
+
+  template <class K, class H = Hash, class E = KeyEqual, class = typename H::is_transparent,
+            class = typename E::is_transparent>
+  bool contains(const K &key) const {
+    return find_key(key, hasher(key)) != end();
+  }
+
+  // Поиск с уже посчитанным хешем: hashed должен быть равен
+  // hash_function()(key). Для оберток, которым хеш ключа нужен и самим
+  // (например, выбрать шард), чтобы не хешировать ключ дважды
+  template <class K>
+  Iterator find(const K &key, std::size_t hashed) {
+    return find_key(key, hashed);
+  }
+
+  template <class K>
+  ConstIterator find(const K &key, std::size_t hashed) const {
+    return find_key(key, hashed);
+  }
+
+  template <class K>
+  bool contains(const K &key, std::size_t hashed) const {
+    return find(key, hashed) != end();
+  }
+
+  // Ищет count ключей разом и пишет в out[i] итератор на keys[i] или end().
+  // Быстрее отдельных find, когда таблица не помещается в кеш: задержки
+  // памяти для разных ключей перекрываются (см. for_each_in_batch).
+  // K - Key или, при прозрачных Hash и KeyEqual, совместимый тип
+  // std::vector<std::string_view> keys = ...;
+  // std::vector<UnorderedMap<std::string, int>::Iterator> found(keys.size());
+  // map.find_batch(keys.data(), keys.size(), found.data());
+  template <class K>
+  void find_batch(const K *keys, std::size_t count, Iterator *out) {
+    for_each_in_batch(keys, count, [&](std::size_t i, std::size_t hashed, const Bucket &) {
+      auto &bucket = bucket_of(hashed);
+      auto it = find_in(bucket, keys[i], hashed);
+      out[i] = it == bucket.end() ? end() : iterator_at(hashed, it);
+    });
+  }
+
+  template <class K>
+  void find_batch(const K *keys, std::size_t count, ConstIterator *out) const {
+    for_each_in_batch(keys, count, [&](std::size_t i, std::size_t hashed, const Bucket &bucket) {
+      auto it = find_in(bucket, keys[i], hashed);
+      out[i] = it == bucket.end() ? end() : iterator_at(hashed, it);
+    });
+  }
+
+  // Пишет в out[i], есть ли ключ keys[i]
+  template <class K>
+  void contains_batch(const K *keys, std::size_t count, bool *out) const {
+    for_each_in_batch(keys, count, [&](std::size_t i, std::size_t hashed, const Bucket &bucket) {
+      out[i] = find_in(bucket, keys[i], hashed) != bucket.end();
+    });
+  }
+
+  // Если ключа k нет, создает элемент со значением Value(args...) и
+  // возвращает {итератор на него, true}. Иначе ничего не создает (args не
+  // трогаются) и возвращает {итератор на существующий, false}
+  // map.try_emplace("key", 3, 'x'); // Value = std::string("xxx")
+  template <class... Args>
+  std::pair<Iterator, bool> try_emplace(const Key &k, Args &&...args) {
+    return find_or_insert(k, hasher(k), [&](Bucket &bucket) {
+      bucket.emplace_back(std::in_place, std::piecewise_construct, std::forward_as_tuple(k),
+                          std::forward_as_tuple(std::forward<Args>(args)...));
+    });
+  }
+
+  template <class... Args>
+  std::pair<Iterator, bool> try_emplace(Key &&k, Args &&...args) {
+    return find_or_insert(k, hasher(k), [&](Bucket &bucket) {
+      bucket.emplace_back(std::in_place, std::piecewise_construct,
+                          std::forward_as_tuple(std::move(k)),
+                          std::forward_as_tuple(std::forward<Args>(args)...));
+    });
+  }
+
+  // try_emplace с уже посчитанным хешем ключа (см. find(key, hashed))
+  template <class K, class... Args>
+  std::pair<Iterator, bool> try_emplace_hashed(std::size_t hashed, K &&k, Args &&...args) {
+    return find_or_insert(k, hashed, [&](Bucket &bucket) {
+      bucket.emplace_back(std::in_place, std::piecewise_construct,
+                          std::forward_as_tuple(std::forward<K>(k)),
+                          std::forward_as_tuple(std::forward<Args>(args)...));
+    });
+  }
+
+  // Создает пару из args и добавляет ее, если такого ключа еще нет.
+  // Ключ известен только после создания пары, поэтому узел создается
+  // заранее и при успехе переносится в корзину без копирования
+  template <class... Args>
+  std::pair<Iterator, bool> emplace(Args &&...args) {
+    Bucket node(data.front().get_allocator());
+    node.emplace_back(std::in_place, std::forward<Args>(args)...);
+    const Key &key = node.front().kv.first;
+    return find_or_insert(key, hasher(key), [&](Bucket &bucket) {
+      bucket.splice(bucket.end(), node);
+    });
+  }
+
+  // Добавляет элемент или присваивает значение существующему.
+  // Возвращает {итератор, был ли элемент добавлен}
+  template <class M>
+  std::pair<Iterator, bool> insert_or_assign(const Key &k, M &&obj) {
+    auto result = try_emplace(k, std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
     }
-    return false;
+    return result;
   }
-  // Возвращяет Итератор на элемент который ищем, если нет такого элемента
-  // возвращает итератор на последный элемент
-  Iterator find(const Key &key) {
-   size_t idx = std::hash<Key>{}(key);
-    for(auto it = data[idx % data.size()].begin(); it != data[idx % data.size()].end(); ++it) {
-      if(it->first == key) {
-        return Iterator(it);
-      }
+
+  template <class M>
+  std::pair<Iterator, bool> insert_or_assign(Key &&k, M &&obj) {
+    auto result = try_emplace(std::move(k), std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
     }
-    return end();
+    return result;
   }
 
   // Добавляет новый элемент с ключем и значением, если нет уже существуюшего
@@ -138,15 +750,7 @@ public:
   //   };
   // c.(5,"something");
   // возвращает false, потому что элмемент с key = 5 уже существует․
-  bool insert(const Key &k, const Value &v) {
-    if (!contains(k)) {
-      std::size_t hashed = std::hash<Key>{}(k);
-      data[hashed % data.size()].push_back({k, v});
-      ++s;
-      return true;
-    }
-    return false;
-  }
+  bool insert(const Key &k, const Value &v) { return try_emplace(k, v).second; }
 
   // Удаляет элемент по ключу и возвращает результат операции
   // UnorderedMap<int, std::string> c =
@@ -160,94 +764,259 @@ public:
   //       {1, "one" }, {2, "two" }, {3, "three"},
   //             {5, "five"}, {6,"six"  }
   //   }; результат после erase
-  bool erase(const Key &key) {
-    size_t idx = std::hash<Key>{}(key);
-    auto &collisions = data[idx % data.size()];
-    for (auto it = collisions.begin(); it != collisions.end(); ++it) {
-      if (key == it->first) {
-        collisions.erase(it);
-        --s;
-        return true;
+  bool erase(const Key &key) { return erase_key(key, hasher(key)); }
+
+  // То же с уже посчитанным хешем ключа (см. find(key, hashed))
+  bool erase(const Key &key, std::size_t hashed) {
+    return erase_key(key, hashed);
+  }
+
+  // Вынимает элемент из словаря вместе с его узлом: ни память, ни пара не
+  // копируются и не освобождаются. Узел можно вставить в другой словарь
+  // (insert(node_type&&)) или изменить ключ и вернуть обратно. Если ключа
+  // нет, возвращает пустой node_type
+  //  auto node = active.extract("session");
+  //  if (node) expired.insert(std::move(node));
+  node_type extract(const Key &key) {
+    const std::size_t hashed = hasher(key);
+    auto &bucket = bucket_of(hashed);
+    auto it = find_in(bucket, key, hashed);
+    node_type handle(bucket.get_allocator());
+    if (it != bucket.end()) {
+      handle.node.splice(handle.node.end(), bucket, it);
+      --s;
+      if (step > 0) {
+        advance_rehash();
       }
     }
-    return false;
+    return handle;
   }
 
-  class Iterator {
-  private:
-    typename std::vector<std::list<std::pair<Key, Value>>>::iterator it{};
-    typename std::vector<std::list<std::pair<Key, Value>>>::iterator list_it_start{};
-    typename std::vector<std::list<std::pair<Key, Value>>>::iterator list_it_end{};
-    typename std::list<std::pair<Key, Value>>::iterator index{};
+  // То же для элемента под итератором (не end())
+  node_type extract(Iterator pos) {
+    node_type handle(pos.it->get_allocator());
+    handle.node.splice(handle.node.end(), *pos.it, pos.index);
+    --s;
+    if (step > 0) {
+      advance_rehash();
+    }
+    return handle;
+  }
 
-  public:
-    using iterator_category = std::forward_iterator_tag;
-    using value_type = std::pair<Key, Value>;
-    using difference_type = std::ptrdiff_t;
-    using pointer = value_type *;
-    using reference = value_type &;
-
-    Iterator(typename std::vector<std::list<std::pair<Key, Value>>>::iterator list_it_start,
-              typename std::vector<std::list<std::pair<Key, Value>>>::iterator list_it_end)
-        : it{list_it_start}, list_it_start{list_it_start},
-          list_it_end{list_it_end}, index{(*list_it_start).begin()} {
-      while (index == (*it).end()) {
-        if (it == list_it_end) {
-          return;
+  // Вставляет узел, вынутый extract, без выделения памяти. Если ключ уже
+  // есть, узел остается в возвращаемом node (его можно вставить еще куда-то)
+  // и position указывает на существующий элемент. Аллокаторы словаря и
+  // узла должны быть равны
+  insert_return_type insert(node_type &&handle) {
+    if (!handle) {
+      return {end(), false, node_type(data.front().get_allocator())};
+    }
+    assert(handle.node.get_allocator() == data.front().get_allocator());
+    const Key &key = handle.key();
+    auto result = find_or_insert(key, hasher(key), [&](Bucket &bucket) {
+      bucket.splice(bucket.end(), handle.node);
+    });
+    if (!result.second) {
+      return {result.first, false, std::move(handle)};
+    }
+    return {result.first, true, node_type(data.front().get_allocator())};
+  }
+
+  // Переносит из other все элементы, ключей которых здесь нет, через splice
+  // узлов. Элементы с совпадающими ключами остаются в other. Ссылки и
+  // указатели на перенесенные элементы остаются валидными (узлы не
+  // двигаются в памяти ни здесь, ни при rehash), но итераторы other на них -
+  // нет. Аллокаторы должны быть равны [O(m) в среднем]
+  void merge(UnorderedMap &other) {
+    if (&other == this) {
+      return;
+    }
+    assert(other.get_allocator() == get_allocator());
+    auto take = [&](Bucket &source) {
+      for (auto it = source.begin(); it != source.end();) {
+        auto node = it++;
+        // Хеш считается этим словарем: у other может быть другое состояние Hash
+        const std::size_t hashed = hasher(node->kv.first);
+        auto &bucket = bucket_of(hashed);
+        if (find_in(bucket, node->kv.first, hashed) != bucket.end()) {
+          continue;
         }
-        ++it;
-        index = it.begin();
+        bucket.splice(bucket.end(), source, node);
+        store_hash(*node, hashed);
+        --other.s;
+        ++s;
+        grow_if_needed();
       }
+    };
+    for (auto &bucket : other.next) {
+      take(bucket);
+    }
+    for (auto &bucket : other.data) {
+      take(bucket);
     }
+  }
 
-    Iterator(typename std::vector<std::list<std::pair<Key, Value>>>::iterator list_it_end)
-        : it{list_it_end}, list_it_start{list_it_end}, list_it_end{list_it_end},
-          index((*list_it_end).end()) {}
+  void merge(UnorderedMap &&other) { merge(other); }
+
+  // Записывает словарь в поток (см. snapshot.hpp): заголовок, размер,
+  // количество корзин и коэффициент заполнения, затем корзины по порядку -
+  // количество элементов и пары ключ-значение. Ключ и значение пишутся через
+  // snapshot::write (trivially copyable типы и строки)
+  void save(std::ostream &os) const {
+    snapshot::write_header(os, "UMAP", sizeof(Key), sizeof(Value));
+    // Во время переноса пишутся и новые, и старые корзины
+    const std::size_t moved_count = migrating ? next.size() : 0;
+    const std::size_t total = moved_count + data.size();
+    snapshot::write(os, static_cast<std::uint64_t>(s));
+    snapshot::write(os, static_cast<std::uint64_t>(total));
+    snapshot::write(os, static_cast<double>(s) / static_cast<double>(total));
+    auto write_bucket = [&](const Bucket &bucket) {
+      snapshot::write(os, static_cast<std::uint64_t>(bucket.size()));
+      for (const auto &node : bucket) {
+        snapshot::write(os, node.kv.first);
+        snapshot::write(os, node.kv.second);
+      }
+    };
+    for (std::size_t i = 0; i < moved_count; i++) {
+      write_bucket(next[i]);
+    }
+    for (const auto &bucket : data) {
+      write_bucket(bucket);
+    }
+  }
 
-    Iterator(typename std::list<std::pair<Key, Value>>::iterator it) : index{it} {}
+  // Заменяет содержимое словаря снимком из потока. Корзины создаются сразу в
+  // количестве из заголовка, а ключи не проверяются на повторы (в снимке
+  // их нет), поэтому загрузка - O(n) без перехеширования и лишних поисков.
+  // max_load_factor() и rehash_step() словаря сохраняются. Заголовок
+  // проверяется: коэффициент заполнения должен сходиться с размером и
+  // количеством корзин, а корзины - помещаться в остаток потока.
+  // При ошибке бросает snapshot::Error, а словарь остается прежним
+  void load(std::istream &is) {
+    snapshot::read_header(is, "UMAP", sizeof(Key), sizeof(Value));
+    std::uint64_t size = 0, bucket_count = 0;
+    double load_factor = 0;
+    snapshot::read(is, size);
+    snapshot::read(is, bucket_count);
+    snapshot::read(is, load_factor);
+    // Каждая корзина занимает в снимке хотя бы 8 байт (свой размер)
+    snapshot::check_count(is, bucket_count, sizeof(std::uint64_t));
+    if (bucket_count == 0 ||
+        load_factor != static_cast<double>(size) / static_cast<double>(bucket_count)) {
+      throw snapshot::Error("snapshot: inconsistent header");
+    }
 
-    Iterator &operator++() {
-      ++index;
-      while (index == (*it).end()) {
-        if (it != list_it_end) {
-          ++it;
-          index = it.begin();
-        }
+    UnorderedMap tmp(bucket_count, hasher, equal, get_allocator());
+    tmp.mlf = mlf;
+    tmp.step = step;
+    for (std::uint64_t i = 0; i < bucket_count; i++) {
+      std::uint64_t bucket_size = 0;
+      snapshot::read(is, bucket_size);
+      for (std::uint64_t j = 0; j < bucket_size; j++) {
+        ValueType pair{};
+        snapshot::read(is, pair.first);
+        snapshot::read(is, pair.second);
+        // Хеш считается заново: std::hash не обязан совпадать между запусками
+        std::size_t hashed = tmp.hasher(pair.first);
+        auto &target = tmp.data[tmp.bucket_index(hashed)];
+        target.emplace_back(std::in_place, std::move(pair));
+        store_hash(target.back(), hashed);
+        ++tmp.s;
       }
-      return *this;
     }
+    if (tmp.s != size) {
+      throw snapshot::Error("snapshot: size does not match contents");
+    }
+    // Снимок мог быть сохранен при большем max_load_factor
+    if (static_cast<double>(tmp.s) > static_cast<double>(tmp.bucket_count()) * mlf) {
+      tmp.rehash(0);
+    }
+    *this = std::move(tmp);
+  }
 
-    bool operator!=(const Iterator &other) { return index != other.index; }
-    bool operator==(const Iterator &other) { return index == other.index; }
+  // Однонаправленный итератор: корзина и узел в ней. Const - ConstIterator
+  template <bool Const>
+  class BasicIterator {
+    friend UnorderedMap;
+    template <bool>
+    friend class BasicIterator;
+
+    using BucketIt = std::conditional_t<Const, typename Buckets::const_iterator,
+                                        typename Buckets::iterator>;
+    using NodeIt = std::conditional_t<Const, typename Bucket::const_iterator,
+                                      typename Bucket::iterator>;
+
+    BucketIt it{};
+    // Последняя корзина: end() - конец ее списка
+    BucketIt last{};
+    NodeIt index{};
+    // Во время переноса: корзины [rest, rest_last], которые обходятся
+    // после last (старые после новых)
+    BucketIt rest{};
+    BucketIt rest_last{};
+    bool has_rest = false;
+
+    BasicIterator(BucketIt it, BucketIt last, NodeIt index)
+        : it{it}, last{last}, index{index} {
+      skip_empty();
+    }
 
-    // Разыменовывает указатель: std::cout << it->second;
-    std::pair<Key, Value> &operator->() { return &(*index); }
+    BasicIterator(BucketIt it, BucketIt last, NodeIt index, BucketIt rest, BucketIt rest_last)
+        : it{it}, last{last}, index{index}, rest{rest}, rest_last{rest_last}, has_rest{true} {
+      skip_empty();
+    }
 
-    // Возвращает значение итератора: *it = {"travel", 42};
-   std::pair<Key, Value> &operator*() { return *index; }
-  };
-  class ConstIterator {
-  private:
-    Iterator it;
+    // Переходит к первому узлу следующих непустых корзин
+    void skip_empty() {
+      while (index == it->end()) {
+        if (it != last) {
+          ++it;
+        } else if (has_rest) {
+          it = rest;
+          last = rest_last;
+          has_rest = false;
+        } else {
+          break;
+        }
+        index = it->begin();
+      }
+    }
 
   public:
     using iterator_category = std::forward_iterator_tag;
     using value_type = std::pair<Key, Value>;
     using difference_type = std::ptrdiff_t;
-    using pointer = value_type *;
-    using reference = value_type &;
+    using pointer = std::conditional_t<Const, const value_type *, value_type *>;
+    using reference = std::conditional_t<Const, const value_type &, value_type &>;
+
+    BasicIterator() = default;
 
-    ConstIterator(Iterator it) : it{it} {}
+    // Iterator неявно превращается в ConstIterator
+    template <bool OtherConst, class = std::enable_if_t<Const && !OtherConst>>
+    BasicIterator(const BasicIterator<OtherConst> &other)
+        : it{other.it}, last{other.last}, index{other.index}, rest{other.rest},
+          rest_last{other.rest_last}, has_rest{other.has_rest} {}
 
-    ConstIterator &operator++() {
-      ++it;
+    BasicIterator &operator++() {
+      ++index;
+      skip_empty();
       return *this;
     }
 
-    bool operator!=(const ConstIterator &other) { return it != other.it; }
-    bool operator==(const ConstIterator &other) { return it == other.it; }
+    BasicIterator operator++(int) {
+      BasicIterator old = *this;
+      ++*this;
+      return old;
+    }
+
+    bool operator!=(const BasicIterator &other) const { return index != other.index; }
+    bool operator==(const BasicIterator &other) const { return index == other.index; }
 
-    const std::pair<Key, Value> &operator*() { return *it; }
+    // Разыменовывает указатель: std::cout << it->second;
+    pointer operator->() const { return &index->kv; }
+
+    // Возвращает значение итератора: *it = {"travel", 42};
+    reference operator*() const { return index->kv; }
   };
 };
 
@@ -1,4 +1,9 @@
 #include "unordered_map.hpp"
+#include "flat_unordered_map.hpp"
+#include "concurrent_unordered_map.hpp"
+#include "lock_free_unordered_map.hpp"
+#include "int_hash_map.hpp"
+#include "fast_hash.hpp"
 
 int main(){
     return 0;
@@ -0,0 +1,107 @@
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lock_free_unordered_map.hpp"
+
+// Нагрузочный тест LockFreeUnorderedMap, собирается с ThreadSanitizer
+// (цель tsan_stress). Читатели ищут ключи, пока писатели вставляют,
+// заменяют и удаляют их в одних и тех же корзинах. Значение всегда
+// связано с ключом (value = key * 10 + версия), поэтому читатель может
+// проверить, что не видит чужой или освобожденный узел.
+
+void stress_readers_and_writers() {
+  LockFreeUnorderedMap<std::uint64_t, std::uint64_t> map(64);
+  const std::uint64_t keys = 512;
+  const int writers = 2;
+  const int readers = 4;
+  const int rounds = 20000;
+  std::atomic<bool> done{false};
+  std::atomic<std::uint64_t> found{0};
+
+  std::vector<std::thread> threads;
+  for (int w = 0; w < writers; w++) {
+    threads.emplace_back([&, w] {
+      std::uint64_t state = 88172645463325252ull + w;
+      for (int i = 0; i < rounds; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        std::uint64_t key = state % keys;
+        switch (state >> 60 & 3) {
+        case 0:
+          map.insert(key, key * 10);
+          break;
+        case 1:
+          map.insert_or_assign(key, key * 10 + (state >> 32) % 10);
+          break;
+        default:
+          map.erase(key);
+          break;
+        }
+      }
+    });
+  }
+  for (int r = 0; r < readers; r++) {
+    threads.emplace_back([&, r] {
+      std::uint64_t local = 0;
+      std::uint64_t key = r;
+      while (!done.load(std::memory_order_relaxed)) {
+        key = (key + 7) % keys;
+        auto value = map.find(key);
+        if (value) {
+          assert(*value / 10 == key);
+          ++local;
+        }
+        map.visit(key, [&](const std::uint64_t &v) { assert(v / 10 == key); });
+      }
+      found.fetch_add(local);
+    });
+  }
+  for (int w = 0; w < writers; w++) {
+    threads[w].join();
+  }
+  done.store(true);
+  for (std::size_t i = writers; i < threads.size(); i++) {
+    threads[i].join();
+  }
+
+  std::size_t counted = 0;
+  map.for_each([&](std::uint64_t key, std::uint64_t value) {
+    assert(value / 10 == key);
+    ++counted;
+  });
+  assert(counted == map.size());
+  std::cout << "lookups that hit: " << found.load() << std::endl;
+}
+
+// Потоки, которые завершаются, отдают номера слотов новым потокам
+void stress_short_lived_threads() {
+  LockFreeUnorderedMap<int, int> map(16);
+  for (int generation = 0; generation < 50; generation++) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+      threads.emplace_back([&, t] {
+        for (int i = 0; i < 200; i++) {
+          int key = t * 1000 + i;
+          map.insert_or_assign(key, generation);
+          assert(map.find(key).has_value());
+          map.erase(key);
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+  assert(map.empty());
+}
+
+int main() {
+  stress_readers_and_writers();
+  stress_short_lived_threads();
+}
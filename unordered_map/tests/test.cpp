@@ -1,4 +1,25 @@
+#include <cassert>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include "unordered_map.hpp"
+#include "flat_unordered_map.hpp"
+#include "concurrent_unordered_map.hpp"
+#include "lock_free_unordered_map.hpp"
+#include "int_hash_map.hpp"
 
 void test_operator_brackets_simple() {
   UnorderedMap<std::string, std::string> map;
@@ -161,6 +182,869 @@ void test_copy_constructor() {
   assert(map.size() == copied.size());
 }
 
+void test_save_load() {
+  UnorderedMap<std::string, int> map(64);
+  for (int i = 0; i < 500; ++i) {
+    map[std::to_string(i)] = i * 2;
+  }
+  std::stringstream stream;
+  map.save(stream);
+
+  UnorderedMap<std::string, int> loaded;
+  loaded["stale"] = 1;
+  loaded.load(stream);
+  assert(loaded.size() == 500);
+  assert(loaded.bucket_count() == map.bucket_count());
+  assert(!loaded.contains("stale"));
+  for (int i = 0; i < 500; ++i) {
+    assert(loaded[std::to_string(i)] == i * 2);
+  }
+}
+
+void test_save_load_trivial_types() {
+  UnorderedMap<std::uint64_t, double> map;
+  for (std::uint64_t i = 0; i < 100; ++i) {
+    map.insert(i, i / 2.0);
+  }
+  std::stringstream stream;
+  map.save(stream);
+
+  UnorderedMap<std::uint64_t, double> loaded;
+  loaded.load(stream);
+  assert(loaded.size() == 100 && loaded.bucket_count() == map.bucket_count());
+  assert(loaded[99] == 49.5);
+}
+
+void test_load_rejects_bad_snapshot() {
+  UnorderedMap<int, int> map;
+  map[1] = 1;
+  std::stringstream stream;
+  map.save(stream);
+
+  UnorderedMap<std::string, int> other;
+  other["kept"] = 1;
+  bool exception_thrown{};
+  try {
+    other.load(stream);
+  } catch (const snapshot::Error &) {
+    exception_thrown = true;
+  }
+  assert(exception_thrown);
+  assert(other.size() == 1 && other.contains("kept"));
+}
+
+void test_load_keeps_settings() {
+  UnorderedMap<int, int> map;
+  for (int i = 0; i < 100; i++) {
+    map[i] = i;
+  }
+  std::stringstream stream;
+  map.save(stream);
+
+  UnorderedMap<int, int> loaded;
+  loaded.max_load_factor(0.5f);
+  loaded.rehash_step(4);
+  loaded.load(stream);
+  assert(loaded.max_load_factor() == 0.5f && loaded.rehash_step() == 4);
+  assert(loaded.size() == 100 && loaded.load_factor() <= 0.5f);
+  assert(loaded[42] == 42);
+}
+
+void test_load_rejects_corrupt_header() {
+  UnorderedMap<int, int> map;
+  map[1] = 1;
+  std::stringstream stream;
+  map.save(stream);
+  const std::string good = stream.str();
+  // После 16 байт заголовка: размер, количество корзин, коэффициент заполнения
+  auto rejected = [](std::string bytes) {
+    std::stringstream corrupt(bytes);
+    UnorderedMap<int, int> other;
+    other[7] = 7;
+    try {
+      other.load(corrupt);
+    } catch (const snapshot::Error &) {
+      return other.size() == 1 && other[7] == 7;
+    }
+    return false;
+  };
+  std::string huge_buckets = good;
+  std::uint64_t bucket_count = std::uint64_t{1} << 60;
+  std::memcpy(&huge_buckets[24], &bucket_count, sizeof(bucket_count));
+  assert(rejected(huge_buckets));
+
+  std::string wrong_load_factor = good;
+  double load_factor = 3.0;
+  std::memcpy(&wrong_load_factor[32], &load_factor, sizeof(load_factor));
+  assert(rejected(wrong_load_factor));
+}
+
+void test_rehash_on_growth() {
+  UnorderedMap<int, int> map;
+  assert(map.bucket_count() == 8);
+  for (int i = 0; i < 10000; ++i) {
+    map[i] = i;
+    assert(map.load_factor() <= map.max_load_factor());
+  }
+  assert(map.bucket_count() == 16384);
+  for (int i = 0; i < 10000; ++i) {
+    assert(map[i] == i);
+  }
+  assert(map.size() == 10000);
+}
+
+void test_rehash_and_reserve() {
+  UnorderedMap<std::string, int> map;
+  map.reserve(1000);
+  const std::size_t buckets = map.bucket_count();
+  assert(buckets == 1024);
+  for (int i = 0; i < 1000; ++i) {
+    map.insert(std::to_string(i), i);
+  }
+  assert(map.bucket_count() == buckets);
+
+  // rehash не опускается ниже size() / max_load_factor()
+  map.rehash(1);
+  assert(map.bucket_count() == 1024);
+  map.rehash(5000);
+  assert(map.bucket_count() == 8192);
+  for (int i = 0; i < 1000; ++i) {
+    assert(map[std::to_string(i)] == i);
+  }
+
+  UnorderedMap<int, int> odd(100);
+  assert(odd.bucket_count() == 128);
+}
+
+void test_rehash_too_many_buckets() {
+  UnorderedMap<int, int> map;
+  map[1] = 1;
+  // Степени двойки больше 2^63 в size_t нет
+  const std::size_t too_many = std::numeric_limits<std::size_t>::max() / 2 + 2;
+  auto throws_length_error = [](auto f) {
+    try {
+      f();
+    } catch (const std::length_error &) {
+      return true;
+    }
+    return false;
+  };
+  assert(throws_length_error([&] { map.rehash(too_many); }));
+  assert(throws_length_error([&] { map.reserve(std::numeric_limits<std::size_t>::max()); }));
+  assert(map.size() == 1 && map[1] == 1);
+  assert(throws_length_error([&] { ConcurrentUnorderedMap<int, int> concurrent(too_many); }));
+  assert(throws_length_error([&] { LockFreeUnorderedMap<int, int> lock_free(too_many); }));
+}
+
+void test_max_load_factor() {
+  UnorderedMap<int, int> map;
+  for (int i = 0; i < 64; ++i) {
+    map[i] = i;
+  }
+  assert(map.bucket_count() == 64 && map.load_factor() == 1.0f);
+  map.max_load_factor(0.25f);
+  assert(map.max_load_factor() == 0.25f);
+  assert(map.bucket_count() == 256);
+  map.max_load_factor(4.0f);
+  map.insert(64, 64);
+  assert(map.bucket_count() == 256);
+
+  bool exception_thrown{};
+  try {
+    map.max_load_factor(0.0f);
+  } catch (const std::invalid_argument &) {
+    exception_thrown = true;
+  }
+  assert(exception_thrown && map.max_load_factor() == 4.0f);
+}
+
+void test_moved_from_is_usable() {
+  UnorderedMap<int, int> map;
+  map[1] = 1;
+  UnorderedMap<int, int> moved{std::move(map)};
+  assert(map.empty() && map.bucket_count() == 8);
+  map[2] = 2;
+  assert(map.contains(2) && !moved.contains(2));
+}
+
+void test_try_emplace() {
+  UnorderedMap<std::string, std::string> map;
+  auto [it, inserted] = map.try_emplace("key", 3, 'x');
+  assert(inserted && it->first == "key" && it->second == "xxx");
+
+  std::string value = "kept";
+  auto again = map.try_emplace("key", std::move(value));
+  assert(!again.second && again.first->second == "xxx");
+  // Если элемент уже есть, аргументы не перемещаются
+  assert(value == "kept");
+  assert(map.size() == 1);
+}
+
+void test_emplace_and_insert_or_assign() {
+  UnorderedMap<int, std::string> map;
+  auto first = map.emplace(1, "one");
+  assert(first.second && first.first->second == "one");
+  auto second = map.emplace(std::make_pair(1, std::string("uno")));
+  assert(!second.second && second.first->second == "one");
+  assert(map.size() == 1);
+
+  auto assigned = map.insert_or_assign(1, "uno");
+  assert(!assigned.second && map[1] == "uno");
+  auto added = map.insert_or_assign(2, "two");
+  assert(added.second && added.first->second == "two" && map.size() == 2);
+}
+
+// Итераторы, которые вернули try_emplace/emplace, остаются верными, даже
+// если вставка вызвала перехеширование
+// Итератор, который вернула вставка, вызвавшая рост, указывает уже в новые
+// корзины. Итераторы, полученные до этой вставки, становятся невалидными
+void test_try_emplace_iterator_after_rehash() {
+  UnorderedMap<int, int> map;
+  for (int i = 0; i < 8; ++i) {
+    map[i] = i;
+  }
+  const std::size_t buckets = map.bucket_count();
+  auto [it, inserted] = map.try_emplace(100, 42);
+  assert(inserted && map.bucket_count() > buckets);
+  assert(it->first == 100 && it->second == 42);
+  assert(map.find(100) == it);
+}
+
+void test_iteration() {
+  UnorderedMap<int, int> map;
+  int expected_sum = 0;
+  for (int i = 0; i < 1000; ++i) {
+    map[i] = i;
+    expected_sum += i;
+  }
+  int sum = 0, count = 0;
+  for (auto &pair : map) {
+    assert(pair.first == pair.second);
+    sum += pair.second;
+    ++count;
+  }
+  assert(count == 1000 && sum == expected_sum);
+
+  const UnorderedMap<int, int> &const_map = map;
+  UnorderedMap<int, int>::ConstIterator it = map.find(5);
+  assert(it != const_map.end() && it->second == 5);
+  assert(const_map.find(-1) == const_map.end());
+
+  UnorderedMap<int, int> empty;
+  assert(empty.begin() == empty.end());
+}
+
+void test_heterogeneous_find() {
+  UnorderedMap<std::string, int> map;
+  map["alpha"] = 1;
+  map["beta"] = 2;
+  std::string_view key = "beta";
+  assert(map.find(key) != map.end() && map.find(key)->second == 2);
+  assert(map.contains("alpha") && !map.contains(std::string_view{"gamma"}));
+
+  const UnorderedMap<std::string, int> &const_map = map;
+  assert(const_map.find(std::string_view{"alpha"})->second == 1);
+}
+
+void test_find_batch() {
+  UnorderedMap<std::string, int> map;
+  for (int i = 0; i < 200; i++) {
+    map[std::to_string(i)] = i;
+  }
+  // Больше одной порции, часть ключей отсутствует
+  std::vector<std::string> keys;
+  for (int i = 0; i < 100; i++) {
+    keys.push_back(std::to_string(i * 3));
+  }
+  std::vector<std::string_view> views(keys.begin(), keys.end());
+
+  std::vector<UnorderedMap<std::string, int>::Iterator> found(keys.size());
+  map.find_batch(views.data(), views.size(), found.data());
+  const auto &const_map = map;
+  std::vector<UnorderedMap<std::string, int>::ConstIterator> const_found(keys.size());
+  const_map.find_batch(keys.data(), keys.size(), const_found.data());
+  std::unique_ptr<bool[]> present(new bool[keys.size()]);
+  map.contains_batch(views.data(), views.size(), present.get());
+
+  for (std::size_t i = 0; i < keys.size(); i++) {
+    bool expected = i * 3 < 200;
+    assert(present[i] == expected);
+    assert((found[i] != map.end()) == expected);
+    assert((const_found[i] != const_map.end()) == expected);
+    if (expected) {
+      assert(found[i]->second == static_cast<int>(i * 3));
+      assert(const_found[i]->first == keys[i]);
+      found[i]->second = -1;
+    }
+  }
+  assert(map["3"] == -1);
+  map.find_batch(views.data(), 0, found.data());
+}
+
+// Инкрементальное перехеширование сверяется с std::unordered_map, в том
+// числе посреди переноса: поиск, обход, удаление, копия и снимок
+void test_incremental_rehash() {
+  for (std::size_t step : {1, 2, 16}) {
+    UnorderedMap<int, int> map;
+    map.rehash_step(step);
+    assert(map.rehash_step() == step);
+    std::unordered_map<int, int> expected;
+    std::mt19937 random(static_cast<unsigned>(step));
+    bool checked_mid_migration = false;
+    for (int i = 0; i < 5000; i++) {
+      int key = static_cast<int>(random() % 3000);
+      if (random() % 4 == 0) {
+        assert(map.erase(key) == (expected.erase(key) == 1));
+      } else {
+        auto [it, inserted] = map.try_emplace(key, i);
+        assert(inserted == expected.emplace(key, i).second);
+        assert(it->first == key && it->second == expected[key]);
+      }
+      assert(map.size() == expected.size());
+      assert(map.load_factor() <= map.max_load_factor() * 2);
+      if (i % 97 == 0) {
+        std::size_t count = 0;
+        for (const auto &[k, v] : map) {
+          assert(expected.at(k) == v);
+          ++count;
+        }
+        assert(count == expected.size());
+        for (const auto &[k, v] : expected) {
+          assert(map.find(k)->second == v);
+        }
+        if (!checked_mid_migration && map.bucket_count() >= 64 && !map.empty()) {
+          checked_mid_migration = true;
+          UnorderedMap<int, int> copy{map};
+          std::stringstream stream;
+          map.save(stream);
+          UnorderedMap<int, int> loaded;
+          loaded.load(stream);
+          for (const auto &[k, v] : expected) {
+            assert(copy[k] == v && loaded[k] == v);
+          }
+          assert(copy.size() == expected.size() && loaded.size() == expected.size());
+        }
+      }
+    }
+    map.rehash_step(0);
+    for (const auto &[k, v] : expected) {
+      assert(map.find(k)->second == v);
+    }
+    assert(map.load_factor() <= map.max_load_factor());
+  }
+}
+
+// Итератор, полученный посреди переноса, остается рабочим после вставок
+void test_incremental_rehash_references() {
+  UnorderedMap<int, int> map(8);
+  map.rehash_step(1);
+  for (int i = 0; i < 9; i++) {
+    map[i] = i;
+  }
+  // Начался перенос в 16 корзин, построена одна
+  assert(map.bucket_count() == 16);
+  // Итераторы шаги переноса не переживают, ссылки на элементы - переживают
+  int &value = map[3];
+  const int *key = &map.find(3)->first;
+  for (int i = 9; i < 100; i++) {
+    map[i] = i;
+  }
+  assert(map.bucket_count() > 16);
+  assert(&map.find(3)->second == &value && &map.find(3)->first == key);
+  value = 300;
+  assert(map[3] == 300);
+  int sum = 0;
+  for (auto pos = map.begin(); pos != map.end(); ++pos) {
+    sum += pos->second;
+  }
+  assert(sum == 99 * 100 / 2 - 3 + 300);
+}
+
+// Регистронезависимые хеш и сравнение строк
+struct CaseInsensitiveHash {
+  std::size_t operator()(const std::string &key) const {
+    std::string lower = key;
+    for (char &c : lower) {
+      c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return std::hash<std::string>{}(lower);
+  }
+};
+
+struct CaseInsensitiveEqual {
+  bool operator()(const std::string &a, const std::string &b) const {
+    if (a.size() != b.size()) {
+      return false;
+    }
+    for (std::size_t i = 0; i < a.size(); i++) {
+      if (std::tolower(static_cast<unsigned char>(a[i])) !=
+          std::tolower(static_cast<unsigned char>(b[i]))) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+void test_custom_hash_and_equal() {
+  UnorderedMap<std::string, int, CaseInsensitiveHash, CaseInsensitiveEqual> map;
+  map["Hello"] = 1;
+  map["HELLO"] = 2;
+  assert(map.size() == 1);
+  assert(map["hello"] == 2);
+  assert(map.contains("hElLo"));
+  assert(!map.insert("HeLLo", 3));
+}
+
+// Хеш, который считает свои вызовы
+struct CountingHash {
+  std::size_t *calls;
+  std::size_t operator()(int key) const {
+    ++*calls;
+    return std::hash<int>{}(key);
+  }
+};
+
+void test_cached_hash_rehash() {
+  std::size_t calls = 0;
+  UnorderedMap<int, int, CountingHash, DefaultKeyEqual<int>,
+               std::allocator<std::pair<const int, int>>, true>
+      map(8, CountingHash{&calls});
+  const int count = 1000;
+  for (int i = 0; i < count; i++) {
+    map[i] = i * 2;
+  }
+  // С кешем каждый ключ хешируется один раз, даже при росте таблицы
+  assert(calls == count);
+  map.rehash(map.bucket_count() * 4);
+  assert(calls == count);
+  for (int i = 0; i < count; i++) {
+    assert(map.find(i)->second == i * 2);
+  }
+  assert(map.erase(7) && !map.contains(7));
+
+  std::size_t plain_calls = 0;
+  UnorderedMap<int, int, CountingHash> plain(8, CountingHash{&plain_calls});
+  for (int i = 0; i < count; i++) {
+    plain[i] = i;
+  }
+  // Без кеша rehash хеширует ключи заново
+  assert(plain_calls > count);
+}
+
+void test_cached_hash_save_load() {
+  using Map = UnorderedMap<std::string, int, FastHash<std::string>, DefaultKeyEqual<std::string>,
+                           std::allocator<std::pair<const std::string, int>>, true>;
+  Map map;
+  for (int i = 0; i < 100; i++) {
+    map["key" + std::to_string(i)] = i;
+  }
+  std::stringstream stream;
+  map.save(stream);
+  Map loaded;
+  loaded.load(stream);
+  assert(loaded.size() == map.size());
+  for (int i = 0; i < 100; i++) {
+    std::string key = "key" + std::to_string(i);
+    assert(loaded.find(std::string_view{key})->second == i);
+  }
+}
+
+void test_fast_hash() {
+  FastHash<std::string> hash;
+  std::string key = "a fairly long key that crosses several sixteen byte blocks";
+  assert(hash(key) == hash(std::string_view{key}));
+  assert(hash(key) == hash(key.c_str()));
+  assert(hash(key) == FastHash<std::string_view>{}(key));
+  assert(hash("") != hash(std::string_view{"\0", 1}));
+
+  // Ключи с общим длинным префиксом не должны сливаться
+  std::unordered_set<std::size_t> seen;
+  const std::string prefix(100, 'x');
+  for (int i = 0; i < 10000; i++) {
+    seen.insert(hash(prefix + std::to_string(i)));
+  }
+  assert(seen.size() == 10000);
+
+  FastHash<std::uint64_t> int_hash;
+  std::unordered_set<std::size_t> low_bits;
+  for (std::uint64_t i = 0; i < 1024; i++) {
+    low_bits.insert(int_hash(i << 20) & 1023);
+  }
+  // Младшие биты (по ним выбирается корзина) зависят и от старших битов ключа
+  assert(low_bits.size() > 512);
+
+  UnorderedMap<std::string, int, FastHash<std::string>> map;
+  map["fast"] = 1;
+  assert(map.find(std::string_view{"fast"})->second == 1);
+}
+
+void test_concurrent_basic() {
+  ConcurrentUnorderedMap<std::string, int> map(6);
+  assert(map.shard_count() == 8);
+  assert(map.empty() && !map.find("a"));
+  assert(map.insert("a", 1));
+  assert(!map.insert("a", 2));
+  assert(map.find("a") == 1);
+  assert(map.find(std::string_view{"a"}) == 1);
+  assert(map.contains("a") && !map.contains("b"));
+  assert(map.update("a", [](int &value) { value += 10; }));
+  assert(!map.update("b", [](int &value) { value += 10; }));
+  assert(map.find("a") == 11);
+  assert(map.erase("a") && !map.erase("a"));
+  assert(map.empty());
+}
+
+// Потоки параллельно вставляют свои ключи и увеличивают общие счетчики
+void test_concurrent_same_parameters_as_map() {
+  using Alloc = std::allocator<std::pair<const std::string, int>>;
+  using Hash = FastHash<std::string>;
+  using Equal = DefaultKeyEqual<std::string>;
+  ConcurrentUnorderedMap<std::string, int, Hash, Equal, Alloc, true> map(4);
+  static_assert(std::is_same_v<decltype(map)::Map, UnorderedMap<std::string, int, Hash, Equal,
+                                                                Alloc, true>>);
+  assert(map.insert("a", 1) && !map.insert("a", 2));
+  assert(map.contains("a") && *map.find("a") == 1);
+  assert(map.erase("a") && !map.contains("a"));
+
+  // Обертка передает в шард готовый хеш
+  UnorderedMap<std::string, int> plain;
+  const std::size_t hashed = plain.hash_function()("key");
+  assert(plain.try_emplace_hashed(hashed, std::string("key"), 5).second);
+  assert(plain.find("key", hashed)->second == 5 && plain.contains("key", hashed));
+  assert(plain.erase("key", hashed) && plain.size() == 0);
+}
+
+void test_concurrent_threads() {
+  ConcurrentUnorderedMap<int, int> map(16);
+  const int threads = 8;
+  const int per_thread = 2000;
+  const int counters = 10;
+  for (int i = 0; i < counters; i++) {
+    map.insert(-1 - i, 0);
+  }
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; t++) {
+    workers.emplace_back([&, t] {
+      for (int i = 0; i < per_thread; i++) {
+        int key = t * per_thread + i;
+        assert(map.insert(key, key));
+        assert(map.find(key) == key);
+        map.update(-1 - i % counters, [](int &value) { ++value; });
+        if (i % 2 == 0) {
+          assert(map.erase(key));
+        }
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  assert(map.size() == threads * per_thread / 2 + counters);
+  int total = 0;
+  std::size_t shards_seen = 0;
+  map.for_each_shard([&](const ConcurrentUnorderedMap<int, int>::Map &shard) {
+    ++shards_seen;
+    for (const auto &[key, value] : shard) {
+      if (key < 0) {
+        total += value;
+      } else {
+        assert(key % 2 == 1 && value == key);
+      }
+    }
+  });
+  assert(shards_seen == map.shard_count());
+  assert(total == threads * per_thread);
+}
+
+void test_lock_free_basic() {
+  LockFreeUnorderedMap<std::string, int> map(4);
+  assert(map.bucket_count() == 4);
+  assert(map.empty() && !map.find("a"));
+  // Ключей больше, чем корзин: цепочки длиннее одного узла
+  for (int i = 0; i < 20; i++) {
+    assert(map.insert(std::to_string(i), i));
+  }
+  assert(!map.insert("3", 30));
+  assert(map.size() == 20);
+  assert(map.find("3") == 3);
+  assert(map.find(std::string_view{"19"}) == 19);
+  assert(!map.insert_or_assign("3", 30));
+  assert(map.insert_or_assign("20", 20));
+  assert(map.find("3") == 30);
+  int seen = -1;
+  assert(map.visit("20", [&](const int &value) { seen = value; }));
+  assert(seen == 20);
+  assert(!map.visit("21", [&](const int &value) { seen = value; }));
+  for (int i = 0; i < 21; i += 2) {
+    assert(map.erase(std::to_string(i)));
+  }
+  assert(!map.erase("0") && !map.contains("0"));
+  assert(map.size() == 10);
+  int sum = 0;
+  map.for_each([&](const std::string &key, int value) {
+    assert(std::stoi(key) % 2 == 1);
+    sum += value;
+  });
+  assert(sum == 1 + 30 + 5 + 7 + 9 + 11 + 13 + 15 + 17 + 19);
+}
+
+// Случайные вставки и удаления сверяются с std::unordered_map; маленький
+// диапазон ключей дает длинные цепочки, перенос через конец массива и
+// сдвиги при удалении
+template <class Key, class Value>
+void check_int_hash_map_matches_std(Key range, int operations) {
+  IntHashMap<Key, Value> map;
+  std::unordered_map<Key, Value> expected;
+  std::mt19937 random(7);
+  for (int i = 0; i < operations; i++) {
+    Key key = static_cast<Key>(random() % range);
+    switch (random() % 3) {
+    case 0:
+      assert(map.insert(key, static_cast<Value>(i)) ==
+             expected.emplace(key, static_cast<Value>(i)).second);
+      break;
+    case 1:
+      map[key] = static_cast<Value>(i);
+      expected[key] = static_cast<Value>(i);
+      break;
+    default:
+      assert(map.erase(key) == (expected.erase(key) == 1));
+      break;
+    }
+    assert(map.size() == expected.size());
+  }
+  for (const auto &[key, value] : expected) {
+    assert(map.contains(key) && *map.find(key) == value);
+  }
+  std::size_t count = 0;
+  map.for_each([&](Key key, const Value &value) {
+    assert(expected.at(key) == value);
+    ++count;
+  });
+  assert(count == expected.size());
+}
+
+void test_int_hash_map() {
+  check_int_hash_map_matches_std<std::uint64_t, std::uint32_t>(5000, 100000);
+  check_int_hash_map_matches_std<std::int32_t, std::int64_t>(300, 20000);
+  check_int_hash_map_matches_std<std::uint16_t, int>(1000, 20000);
+  check_int_hash_map_matches_std<std::uint8_t, int>(200, 5000);
+
+  IntHashMap<std::uint64_t, std::string> map;
+  assert(map.empty() && map.bucket_count() == 0 && !map.find(1));
+  map[1] = "one";
+  assert(map.insert(2, "two") && !map.insert(2, "deux"));
+  assert(*map.find(2) == "two" && map[1] == "one");
+  const auto &const_map = map;
+  assert(const_map[2] == "two" && !const_map.find(3));
+  bool exception_thrown{};
+  try {
+    const_map[3];
+  } catch (const std::out_of_range &) {
+    exception_thrown = true;
+  }
+  assert(exception_thrown);
+  // Максимальное значение - признак свободного слота
+  exception_thrown = false;
+  try {
+    map.insert(UINT64_MAX, "empty");
+  } catch (const std::invalid_argument &) {
+    exception_thrown = true;
+  }
+  assert(exception_thrown && !map.contains(UINT64_MAX) && !map.erase(UINT64_MAX));
+
+  // Строки переносятся при росте и сдвигаются при удалении
+  for (std::uint64_t i = 0; i < 1000; i++) {
+    map[i] = std::to_string(i);
+  }
+  for (std::uint64_t i = 0; i < 1000; i += 3) {
+    assert(map.erase(i));
+  }
+  IntHashMap<std::uint64_t, std::string> copy{map};
+  IntHashMap<std::uint64_t, std::string> moved{std::move(map)};
+  assert(map.empty() && copy.size() == moved.size());
+  for (std::uint64_t i = 0; i < 1000; i++) {
+    assert(moved.contains(i) == (i % 3 != 0));
+    assert(i % 3 == 0 || *copy.find(i) == std::to_string(i));
+  }
+  copy.clear();
+  assert(copy.empty() && copy.bucket_count() == 0);
+}
+
+void test_int_hash_set() {
+  IntHashSet<std::uint32_t, 0> set;
+  assert(!set.contains(5) && !set.contains(0));
+  for (std::uint32_t i = 1; i <= 100; i++) {
+    assert(set.insert(i * 7));
+  }
+  assert(!set.insert(7) && set.size() == 100);
+  assert(set.erase(14) && !set.erase(14) && !set.contains(14));
+  set.reserve(1000);
+  std::uint64_t sum = 0;
+  set.for_each([&](std::uint32_t key) { sum += key; });
+  assert(sum == 7 * 100 * 101 / 2 - 14);
+  bool exception_thrown{};
+  try {
+    set.insert(0);
+  } catch (const std::invalid_argument &) {
+    exception_thrown = true;
+  }
+  assert(exception_thrown);
+}
+
+void test_flat_operator_brackets() {
+  FlatUnorderedMap<std::string, std::string> map;
+  map["Nikolay"] = "teacher";
+  assert(map["Nikolay"] == "teacher");
+  assert(map["John"] == "");
+  assert(map.size() == 2);
+
+  const FlatUnorderedMap<std::string, std::string> &const_map = map;
+  assert(const_map["Nikolay"] == "teacher");
+  bool exception_thrown{};
+  try {
+    const_map["Alex"];
+  } catch (const std::out_of_range &) {
+    exception_thrown = true;
+  }
+  assert(exception_thrown);
+}
+
+void test_flat_insert_find_erase() {
+  FlatUnorderedMap<int, std::string> map;
+  assert(map.find(1) == map.end());
+  assert(map.insert(1, "one"));
+  assert(!map.insert(1, "uno"));
+  assert(map.find(1)->second == "one");
+  assert(map.contains(1) && !map.contains(2));
+  assert(map.erase(1));
+  assert(!map.erase(1));
+  assert(map.empty() && map.find(1) == map.end());
+}
+
+// Случайная последовательность операций сверяется с std::unordered_map,
+// в том числе переиспользование удаленных слотов и рост таблицы
+void test_flat_matches_std() {
+  FlatUnorderedMap<std::uint64_t, std::uint64_t> map;
+  std::unordered_map<std::uint64_t, std::uint64_t> expected;
+  std::mt19937_64 random(42);
+  for (int i = 0; i < 200000; ++i) {
+    std::uint64_t key = random() % 5000;
+    switch (random() % 3) {
+    case 0:
+      assert(map.insert(key, i) == expected.emplace(key, i).second);
+      break;
+    case 1:
+      map[key] = i;
+      expected[key] = i;
+      break;
+    default:
+      assert(map.erase(key) == (expected.erase(key) == 1));
+    }
+  }
+  assert(map.size() == expected.size());
+  std::size_t visited = 0;
+  for (const auto &pair : map) {
+    assert(expected.at(pair.first) == pair.second);
+    ++visited;
+  }
+  assert(visited == expected.size());
+  for (std::uint64_t key = 0; key < 5000; ++key) {
+    assert(map.contains(key) == (expected.count(key) == 1));
+  }
+}
+
+void test_flat_reserve() {
+  FlatUnorderedMap<int, int> map;
+  map.reserve(1000);
+  const std::size_t buckets = map.bucket_count();
+  assert(buckets >= 1000);
+  for (int i = 0; i < 1000; ++i) {
+    map[i] = i;
+  }
+  assert(map.bucket_count() == buckets);
+}
+
+void test_flat_copy_and_move() {
+  FlatUnorderedMap<std::string, int> map;
+  for (int i = 0; i < 100; ++i) {
+    map[std::to_string(i)] = i;
+  }
+  FlatUnorderedMap<std::string, int> copied{map};
+  copied["0"] = -1;
+  assert(copied.size() == 100 && map["0"] == 0 && copied["99"] == 99);
+
+  FlatUnorderedMap<std::string, int> moved{std::move(map)};
+  assert(map.empty() && map.find("1") == map.end());
+  assert(moved.size() == 100 && moved["1"] == 1);
+
+  map = moved;
+  moved = std::move(copied);
+  assert(map["0"] == 0 && moved["0"] == -1);
+  map.clear();
+  assert(map.empty() && map.bucket_count() == 0);
+}
+
+void test_extract_insert_node() {
+  UnorderedMap<std::string, std::string> active;
+  UnorderedMap<std::string, std::string> expired;
+  active["a"] = "first";
+  active["b"] = "second";
+  std::string *value = &active["b"];
+
+  auto node = active.extract("b");
+  assert(node && node.key() == "b" && node.mapped() == "second");
+  assert(!active.contains("b") && active.size() == 1);
+  assert(!active.extract("missing"));
+
+  auto result = expired.insert(std::move(node));
+  assert(result.inserted && !result.node);
+  assert(result.position->first == "b");
+  // узел перенесен, а не скопирован
+  assert(&expired["b"] == value);
+
+  auto again = active.extract(active.find("a"));
+  assert(active.empty() && again.mapped() == "first");
+  expired["a"] = "kept";
+  auto rejected = expired.insert(std::move(again));
+  assert(!rejected.inserted && rejected.position->second == "kept");
+  rejected.node.key() = "c";
+  assert(expired.insert(std::move(rejected.node)).inserted);
+  assert(expired.size() == 3 && expired["c"] == "first");
+}
+
+void test_merge() {
+  for (std::size_t step : {0, 1}) {
+    UnorderedMap<int, int> map;
+    UnorderedMap<int, int> other;
+    map.rehash_step(step);
+    other.rehash_step(step);
+    for (int i = 0; i < 1000; i += 2) {
+      map[i] = i;
+    }
+    for (int i = 0; i < 1000; i++) {
+      other[i] = -i;
+    }
+    int *moved = &other[501];
+    map.merge(other);
+
+    assert(map.size() == 1000);
+    assert(other.size() == 500);
+    assert(&map[501] == moved);
+    for (int i = 0; i < 1000; i++) {
+      assert(map[i] == (i % 2 == 0 ? i : -i));
+      assert(other.contains(i) == (i % 2 == 0));
+    }
+    std::size_t count = 0;
+    for (const auto &[k, v] : other) {
+      assert(v == -k);
+      ++count;
+    }
+    assert(count == 500);
+  }
+}
+
 int main() {
   test_operator_brackets_simple();
   test_operator_brackets_empty_string();
@@ -188,4 +1072,47 @@ int main() {
   test_operator_equal_r_value();
   test_move_constructor();
   test_copy_constructor();
+
+  test_save_load();
+  test_save_load_trivial_types();
+  test_load_rejects_bad_snapshot();
+  test_load_keeps_settings();
+  test_load_rejects_corrupt_header();
+
+  test_rehash_on_growth();
+  test_rehash_and_reserve();
+  test_rehash_too_many_buckets();
+  test_max_load_factor();
+  test_moved_from_is_usable();
+
+  test_try_emplace();
+  test_emplace_and_insert_or_assign();
+  test_try_emplace_iterator_after_rehash();
+  test_iteration();
+  test_heterogeneous_find();
+  test_find_batch();
+  test_incremental_rehash();
+  test_incremental_rehash_references();
+
+  test_extract_insert_node();
+  test_merge();
+
+  test_custom_hash_and_equal();
+  test_cached_hash_rehash();
+  test_cached_hash_save_load();
+  test_fast_hash();
+
+  test_concurrent_basic();
+  test_concurrent_same_parameters_as_map();
+  test_concurrent_threads();
+  test_lock_free_basic();
+
+  test_flat_operator_brackets();
+  test_flat_insert_find_erase();
+  test_flat_matches_std();
+  test_flat_reserve();
+  test_flat_copy_and_move();
+
+  test_int_hash_map();
+  test_int_hash_set();
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+#include "vector.hpp"
+
+// Стоимость проверки индекса в operator[] во внутреннем цикле: сумма
+// элементов через v[i] для каждой политики BoundsCheck и через data().
+// DebugAssert здесь с включенным assert (бенчмарк собирается без NDEBUG).
+// ./bench_indexing [count] [passes]
+namespace {
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+template <class Policy>
+using IntVector = Vector<std::int32_t, std::allocator<std::int32_t>, Policy>;
+
+template <class Container>
+void fill(Container &v, std::size_t count) {
+  v.reserve(count);
+  for (std::size_t i = 0; i < count; i++) {
+    v.push_back(static_cast<std::int32_t>(i % 1000));
+  }
+}
+
+template <class Policy>
+void run(const char *name, std::size_t count, std::size_t passes) {
+  IntVector<Policy> v;
+  fill(v, count);
+  std::int64_t sum = 0;
+  double ms = measure_ms([&] {
+    for (std::size_t pass = 0; pass < passes; pass++) {
+      for (std::size_t i = 0; i < v.size(); i++) {
+        sum += v[i];
+      }
+    }
+  });
+  std::cout << name << ": " << ms << " ms, "
+            << ms * 1e6 / static_cast<double>(count * passes) << " ns/element (sum "
+            << sum << ")" << std::endl;
+}
+
+void run_raw(std::size_t count, std::size_t passes) {
+  IntVector<bounds_check::Unchecked> v;
+  fill(v, count);
+  std::int64_t sum = 0;
+  double ms = measure_ms([&] {
+    for (std::size_t pass = 0; pass < passes; pass++) {
+      const std::int32_t *data = v.data();
+      for (std::size_t i = 0; i < v.size(); i++) {
+        sum += data[i];
+      }
+    }
+  });
+  std::cout << "data()[i]: " << ms << " ms, "
+            << ms * 1e6 / static_cast<double>(count * passes) << " ns/element (sum "
+            << sum << ")" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  std::size_t passes = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100;
+
+  run<bounds_check::Checked>("Checked", count, passes);
+  run<bounds_check::DebugAssert>("DebugAssert", count, passes);
+  run<bounds_check::Unchecked>("Unchecked", count, passes);
+  run_raw(count, passes);
+}
@@ -0,0 +1,100 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include "inlining_ops.hpp"
+
+// Сравнивает операции контейнеров, встроенные из заголовка, с вызовами через
+// другую единицу трансляции. Собирается дважды: bench_inlining (без LTO,
+// вызовы через inlining_ops.cpp не встраиваются) и bench_inlining_lto
+// (с LTO разница должна исчезнуть).
+// ./bench_inlining [count]
+namespace {
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+void report(const char *name, double inlined, double out_of_line) {
+  std::cout << name << ": header " << inlined << " ms, other TU " << out_of_line
+            << " ms" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  std::int64_t sum = 0;
+
+  Vector<std::int32_t> a, b;
+  a.reserve(count);
+  b.reserve(count);
+  double push_inlined = measure_ms([&] {
+    for (std::size_t i = 0; i < count; i++) {
+      a.push_back(static_cast<std::int32_t>(i));
+    }
+  });
+  double push_out = measure_ms([&] {
+    for (std::size_t i = 0; i < count; i++) {
+      push_back_out_of_line(b, static_cast<std::int32_t>(i));
+    }
+  });
+  report("Vector::push_back", push_inlined, push_out);
+
+  double index_inlined = measure_ms([&] {
+    for (std::size_t i = 0; i < a.size(); i++) {
+      sum += a[i];
+    }
+  });
+  double index_out = measure_ms([&] {
+    for (std::size_t i = 0; i < b.size(); i++) {
+      sum += index_out_of_line(b, i);
+    }
+  });
+  report("Vector::operator[]", index_inlined, index_out);
+
+  Stack<std::int32_t> s1, s2;
+  double stack_inlined = measure_ms([&] {
+    for (std::size_t i = 0; i < count; i++) {
+      s1.push_back(static_cast<std::int32_t>(i));
+    }
+    while (!s1.empty()) {
+      sum += s1.pop();
+    }
+  });
+  double stack_out = measure_ms([&] {
+    for (std::size_t i = 0; i < count; i++) {
+      push_out_of_line(s2, static_cast<std::int32_t>(i));
+    }
+    while (!s2.empty()) {
+      sum += pop_out_of_line(s2);
+    }
+  });
+  report("Stack push/pop", stack_inlined, stack_out);
+
+  Queue<std::int32_t> q1, q2;
+  double queue_inlined = measure_ms([&] {
+    for (std::size_t i = 0; i < count / 10; i++) {
+      q1.push(static_cast<std::int32_t>(i));
+    }
+    while (!q1.empty()) {
+      sum += q1.pop();
+    }
+  });
+  double queue_out = measure_ms([&] {
+    for (std::size_t i = 0; i < count / 10; i++) {
+      push_out_of_line(q2, static_cast<std::int32_t>(i));
+    }
+    while (!q2.empty()) {
+      sum += pop_out_of_line(q2);
+    }
+  });
+  report("Queue push/pop", queue_inlined, queue_out);
+
+  std::cout << "(checksum " << sum << ")" << std::endl;
+}
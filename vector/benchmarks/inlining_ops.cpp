@@ -0,0 +1,13 @@
+#include "inlining_ops.hpp"
+
+void push_back_out_of_line(Vector<std::int32_t> &v, std::int32_t x) { v.push_back(x); }
+
+std::int32_t index_out_of_line(const Vector<std::int32_t> &v, std::size_t i) { return v[i]; }
+
+void push_out_of_line(Stack<std::int32_t> &s, std::int32_t x) { s.push_back(x); }
+
+std::int32_t pop_out_of_line(Stack<std::int32_t> &s) { return s.pop(); }
+
+void push_out_of_line(Queue<std::int32_t> &q, std::int32_t x) { q.push(x); }
+
+std::int32_t pop_out_of_line(Queue<std::int32_t> &q) { return q.pop(); }
@@ -0,0 +1,20 @@
+#ifndef INLINING_OPS_H
+#define INLINING_OPS_H
+
+#include <cstdint>
+
+#include "vector.hpp"
+#include "stack.hpp"
+#include "queue.hpp"
+
+// Те же операции, что и в заголовках контейнеров, но определенные в другой
+// единице трансляции (inlining_ops.cpp). Так выглядел вызов, пока шаблоны
+// были в src/*.cpp: без LTO компилятор не может их встроить в цикл
+void push_back_out_of_line(Vector<std::int32_t> &v, std::int32_t x);
+std::int32_t index_out_of_line(const Vector<std::int32_t> &v, std::size_t i);
+void push_out_of_line(Stack<std::int32_t> &s, std::int32_t x);
+std::int32_t pop_out_of_line(Stack<std::int32_t> &s);
+void push_out_of_line(Queue<std::int32_t> &q, std::int32_t x);
+std::int32_t pop_out_of_line(Queue<std::int32_t> &q);
+
+#endif
@@ -0,0 +1,100 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "vector.hpp"
+
+// Сравнивает блочные insert/erase с прежним алгоритмом, который ставил
+// элемент в конец и "всплывал" его через std::swap.
+// ./bench_insert_erase [splice]
+namespace {
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+// Прежние реализации, выраженные через публичный интерфейс Vector
+template <class T>
+void swap_insert(Vector<T> &v, std::size_t pos, const T &value) {
+  v.push_back(value);
+  T *data = v.data();
+  for (std::size_t i = v.size() - 1; i > pos; i--) {
+    std::swap(data[i], data[i - 1]);
+  }
+}
+
+template <class T>
+T swap_erase(Vector<T> &v, std::size_t pos) {
+  T *data = v.data();
+  for (std::size_t i = pos; i < v.size() - 1; i++) {
+    std::swap(data[i], data[i + 1]);
+  }
+  return v.pop_back();
+}
+
+Vector<int> make(std::size_t size) {
+  Vector<int> v;
+  v.reserve(size);
+  for (std::size_t i = 0; i < size; i++) {
+    v.push_back(static_cast<int>(i));
+  }
+  return v;
+}
+
+void check(const Vector<int> &a, const Vector<int> &b) {
+  if (a.size() != b.size()) {
+    std::abort();
+  }
+  for (std::size_t i = 0; i < a.size(); i++) {
+    if (a[i] != b[i]) {
+      std::abort();
+    }
+  }
+}
+
+void run(std::size_t size, std::size_t splice) {
+  std::vector<int> chunk(splice, -1);
+  std::size_t middle = size / 2;
+
+  Vector<int> old_way = make(size);
+  Vector<int> new_way = make(size);
+
+  double swap_insert_ms = measure_ms([&] {
+    for (std::size_t i = 0; i < splice; i++) {
+      swap_insert(old_way, middle + i, chunk[i]);
+    }
+  });
+  double block_insert_ms = measure_ms([&] {
+    new_way.insert(middle, chunk.begin(), chunk.end());
+  });
+  check(old_way, new_way);
+
+  double swap_erase_ms = measure_ms([&] {
+    for (std::size_t i = 0; i < splice; i++) {
+      swap_erase(old_way, middle);
+    }
+  });
+  double block_erase_ms = measure_ms([&] { new_way.erase(middle, middle + splice); });
+  check(old_way, new_way);
+
+  std::cout << "size " << size << ", splice " << splice << ":" << std::endl
+            << "  insert: swap loop " << swap_insert_ms << " ms, block "
+            << block_insert_ms << " ms" << std::endl
+            << "  erase:  swap loop " << swap_erase_ms << " ms, block "
+            << block_erase_ms << " ms" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t splice = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000;
+
+  run(1000, splice);
+  run(1000000, splice);
+}
@@ -0,0 +1,83 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "mmap_vector.hpp"
+#include "vector.hpp"
+
+// Потоковое чтение большого файла записей: MmapVector (открытие только на
+// чтение + MADV_SEQUENTIAL, без копирования) против чтения всего файла в
+// Vector через std::ifstream. Файл сначала записывается через MmapVector.
+// Если файл помещается в page cache, оба чтения идут из памяти; чтобы
+// измерить чтение с диска, возьмите размер больше RAM (тогда Vector-вариант
+// упрется в своп или не выделит память - в этом и разница).
+// ./bench_mmap [megabytes] [path]
+namespace {
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+struct Record {
+  std::uint64_t id;
+  double value;
+};
+
+void report(const char *name, double ms, std::size_t bytes, std::uint64_t checksum) {
+  std::cout << name << ": " << ms << " ms, "
+            << static_cast<double>(bytes) / (1 << 20) / (ms / 1000) << " MB/s (checksum "
+            << checksum << ")" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t megabytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10240;
+  std::string path = argc > 2 ? argv[2]
+                              : (std::filesystem::temp_directory_path() / "bench_mmap.bin").string();
+  const std::size_t count = megabytes * (1 << 20) / sizeof(Record);
+  const std::size_t bytes = count * sizeof(Record);
+
+  std::uint64_t checksum = 0;
+  double ms = measure_ms([&] {
+    MmapVector<Record> out(path);
+    out.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+      out.push_back({i, static_cast<double>(i)});
+    }
+    checksum = out.size();
+  });
+  report("write MmapVector", ms, bytes, checksum);
+
+  checksum = 0;
+  ms = measure_ms([&] {
+    MmapVector<Record> in(path, MmapVector<Record>::Mode::ReadOnly);
+    in.advise(MmapVector<Record>::Advice::Sequential);
+    for (const Record &r : in) {
+      checksum += r.id;
+    }
+  });
+  report("read MmapVector", ms, bytes, checksum);
+
+  checksum = 0;
+  ms = measure_ms([&] {
+    std::ifstream file(path, std::ios::binary);
+    Vector<Record> in(count);
+    file.read(reinterpret_cast<char *>(in.data()), static_cast<std::streamsize>(bytes));
+    for (std::size_t i = 0; i < in.size(); i++) {
+      checksum += in[i].id;
+    }
+  });
+  report("read into Vector", ms, bytes, checksum);
+
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,59 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <execution>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "vector.hpp"
+
+// Параллельные std::sort и std::reduce (std::execution::par_unseq) на
+// Vector и на std::vector одинакового содержимого.
+// ./bench_parallel [count]
+namespace {
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+template <class Container>
+void run(const char *name, Container &c) {
+  std::int64_t sum = 0;
+  double reduce_ms = measure_ms([&] {
+    sum = std::reduce(std::execution::par_unseq, c.begin(), c.end(), std::int64_t{0});
+  });
+  double sort_ms = measure_ms([&] { std::sort(std::execution::par_unseq, c.begin(), c.end()); });
+  if (!std::is_sorted(c.begin(), c.end())) {
+    std::abort();
+  }
+  std::cout << name << ": reduce " << reduce_ms << " ms, sort " << sort_ms
+            << " ms (sum " << sum << ")" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000000;
+
+  std::mt19937 gen{42};
+  std::vector<std::int32_t> std_vector(count);
+  for (auto &x : std_vector) {
+    x = static_cast<std::int32_t>(gen());
+  }
+
+  Vector<std::int32_t> vector;
+  vector.insert(0, std_vector.begin(), std_vector.end());
+
+  // Первый параллельный вызов поднимает пул потоков, не считаем его
+  std::reduce(std::execution::par_unseq, std_vector.begin(), std_vector.end(), std::int64_t{0});
+
+  run("Vector", vector);
+  run("std::vector", std_vector);
+}
@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "vector.hpp"
+
+// Сравнивает скорость push_back у Vector и std::vector.
+// ./bench_push_back [count]
+namespace {
+
+struct Record {
+  std::uint64_t id;
+  double value;
+  std::uint32_t flags;
+};
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+// Лучшее время из нескольких прогонов: первый прогон платит за прогрев
+// аллокатора и page fault'ы
+template <class Container, class Make>
+double run(std::size_t count, Make make) {
+  double best = 0;
+  for (int attempt = 0; attempt < 3; attempt++) {
+    std::size_t size = 0;
+    double ms = measure_ms([&] {
+      Container c;
+      for (std::size_t i = 0; i < count; i++) {
+        c.push_back(make(i));
+      }
+      size = c.size();
+    });
+    if (size != count) {
+      std::abort();
+    }
+    best = attempt == 0 ? ms : std::min(best, ms);
+  }
+  return best;
+}
+
+template <class T, class Make>
+void compare(const char *name, std::size_t count, Make make) {
+  double ours = run<Vector<T>>(count, make);
+  double theirs = run<std::vector<T>>(count, make);
+  std::cout << name << ": Vector " << ours << " ms, std::vector " << theirs
+            << " ms (" << count / ours / 1000.0 << " vs "
+            << count / theirs / 1000.0 << " Mops/s)" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+  compare<int>("int", count, [](std::size_t i) { return static_cast<int>(i); });
+  compare<Record>("Record", count, [](std::size_t i) {
+    return Record{i, static_cast<double>(i), static_cast<std::uint32_t>(i)};
+  });
+  compare<std::string>("std::string", count / 10, [](std::size_t i) {
+    return std::string(32, static_cast<char>('a' + i % 26));
+  });
+}
@@ -0,0 +1,96 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include "vector.hpp"
+#include "vector_simd.hpp"
+
+// Ядра из vector_simd.hpp на каждом уровне (Scalar, SSE2, AVX2) для
+// Vector<int32_t> и Vector<float>. Уровни выше поддерживаемого процессором
+// пропускаются. Скалярный цикл собирается с -O2, то есть без автовекторизации
+// (в GCC 12 она включается только с -O3).
+// ./bench_simd [count] [passes]
+namespace {
+
+template <class F>
+double measure_ms(F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+const char *level_name(simd::Level level) {
+  switch (level) {
+  case simd::Level::Scalar:
+    return "scalar";
+  case simd::Level::SSE2:
+    return "sse2";
+  case simd::Level::AVX2:
+    return "avx2";
+  }
+  return "?";
+}
+
+template <class F>
+void report(const char *type, const char *kernel, simd::Level level, std::size_t count,
+            std::size_t passes, F &&f) {
+  double ms = measure_ms([&] {
+    for (std::size_t pass = 0; pass < passes; pass++) {
+      f();
+    }
+  });
+  std::cout << type << " " << kernel << " " << level_name(level) << ": " << ms << " ms, "
+            << ms * 1e6 / static_cast<double>(count * passes) << " ns/element" << std::endl;
+}
+
+template <class T>
+void run(const char *type, std::size_t count, std::size_t passes) {
+  Vector<T> v(count);
+  for (std::size_t i = 0; i < count; i++) {
+    v[i] = static_cast<T>(i % 1000);
+  }
+  // find ищет значение, которого нет, чтобы пройти весь массив
+  const T missing = static_cast<T>(-1);
+  // Результаты копятся сюда, чтобы компилятор не выбросил вычисления
+  volatile double sink = 0;
+
+  for (simd::Level level : {simd::Level::Scalar, simd::Level::SSE2, simd::Level::AVX2}) {
+    if (level > simd::level()) {
+      break;
+    }
+    T *data = v.data();
+    report(type, "fill", level, count, passes,
+           [&] { simd::detail::fill(level, data, count, static_cast<T>(sink)); });
+    for (std::size_t i = 0; i < count; i++) {
+      data[i] = static_cast<T>(i % 1000);
+    }
+    report(type, "find", level, count, passes,
+           [&] { sink = sink + simd::detail::find(level, data, count, missing); });
+    report(type, "count", level, count, passes,
+           [&] { sink = sink + simd::detail::count(level, data, count, static_cast<T>(7)); });
+    report(type, "sum", level, count, passes,
+           [&] { sink = sink + static_cast<double>(simd::detail::sum(level, data, count)); });
+    report(type, "minmax", level, count, passes, [&] {
+      auto result = simd::detail::minmax(level, data, count);
+      sink = sink + static_cast<double>(result.first) + static_cast<double>(result.second);
+    });
+    auto op = [](T x) { return static_cast<T>(x * 3 + 1); };
+    report(type, "transform_inplace", level, count, passes,
+           [&] { simd::detail::transform_inplace(level, data, count, op); });
+    for (std::size_t i = 0; i < count; i++) {
+      data[i] = static_cast<T>(i % 1000);
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  std::size_t passes = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100;
+
+  run<std::int32_t>("int32", count, passes);
+  run<float>("float", count, passes);
+}
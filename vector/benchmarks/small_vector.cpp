@@ -0,0 +1,59 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <vector>
+
+#include "vector.hpp"
+#include "small_vector.hpp"
+
+// Сравнивает короткоживущие маленькие векторы: SmallVector, Vector и
+// std::vector. Кроме времени считает выделения памяти в куче.
+// ./bench_small_vector [iterations] [elements]
+static std::size_t allocations = 0;
+
+void *operator new(std::size_t size) {
+  ++allocations;
+  if (void *ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+template <class Container>
+void run(const char *name, std::size_t iterations, std::size_t elements) {
+  std::size_t before = allocations;
+  long long checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < iterations; i++) {
+    Container c;
+    for (std::size_t j = 0; j < elements; j++) {
+      c.push_back(static_cast<int>(i + j));
+    }
+    checksum += c.data()[c.size() - 1];
+  }
+  auto finish = std::chrono::steady_clock::now();
+  double ms = std::chrono::duration<double, std::milli>(finish - start).count();
+  std::cout << name << ": " << ms << " ms, " << allocations - before
+            << " heap allocations (checksum " << checksum << ")" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  std::size_t elements = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 12;
+  elements = std::max<std::size_t>(elements, 1);
+
+  std::cout << iterations << " containers of " << elements << " ints" << std::endl;
+  run<SmallVector<int, 16>>("SmallVector<int, 16>", iterations, elements);
+  run<Vector<int>>("Vector<int>", iterations, elements);
+  run<std::vector<int>>("std::vector<int>", iterations, elements);
+}
@@ -0,0 +1,131 @@
+#ifndef MMAP_VECTOR_H
+#define MMAP_VECTOR_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "vector.hpp"
+
+// Только POSIX (mmap). На Linux файл растет через mremap, на других
+// системах отображение пересоздается.
+//
+// Вектор, элементы которого лежат в файле, отображенном в память (mmap).
+// Память процесса под элементы не выделяется, поэтому объем данных
+// ограничен диском, а не RAM. Файл растет через ftruncate + mremap.
+// Только для trivially copyable T: элементы пишутся в файл как есть.
+//
+// MmapVector<Record> out("data.bin");                 // новый (пустой) файл
+// out.push_back(record);
+// MmapVector<Record> in("data.bin", MmapVector<Record>::Mode::ReadOnly);
+// in.advise(MmapVector<Record>::Advice::Sequential);
+//
+// Файл всегда содержит ровно size() элементов без заголовка: при росте он
+// увеличивается с запасом, а в деструкторе обрезается до size(). Поэтому
+// файл, записанный MmapVector, можно открыть заново или прочитать как
+// обычный массив T.
+template <class T, class BoundsCheck = bounds_check::Checked>
+class MmapVector {
+  static_assert(std::is_trivially_copyable_v<T>, "MmapVector needs trivially copyable T");
+
+public:
+    enum class Mode {
+        Create,    // создать файл (существующий обрезается до нуля)
+        ReadWrite, // открыть существующий файл на чтение и запись
+        ReadOnly   // открыть существующий файл только на чтение
+    };
+
+    // Подсказка ядру о порядке доступа (madvise)
+    enum class Advice { Normal, Sequential, Random, WillNeed };
+
+private:
+  int fd_{-1};
+  bool read_only_{};
+  std::size_t size_{};
+  std::size_t capacity_{};
+  T *data_{};
+
+  // Меняет размер файла и отображения на new_capacity элементов
+  void remap(std::size_t new_capacity);
+  void check_writable() const;
+  void close();
+
+  // Следующая емкость при росте
+  std::size_t grow_capacity() const;
+
+public:
+    using Iterator = typename Vector<T>::Iterator;
+    using ConstIterator = typename Vector<T>::ConstIterator;
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
+
+    explicit MmapVector(const std::string &path, Mode mode = Mode::Create);
+
+    // Копировать отображение файла нельзя, только передать
+    MmapVector(const MmapVector &other) = delete;
+    MmapVector &operator=(const MmapVector &other) = delete;
+    MmapVector(MmapVector &&other) noexcept;
+    MmapVector &operator=(MmapVector &&other) noexcept;
+
+    ~MmapVector();
+
+    bool read_only() const;
+
+    std::size_t size() const;
+    T *data();
+    const T *data() const;
+    bool empty() const;
+    std::size_t capacity() const;
+
+    const T &operator[](std::size_t index) const;
+    T &operator[](std::size_t index);
+    const T &at(std::size_t index) const;
+    T &at(std::size_t index);
+
+    Iterator begin();
+    Iterator end();
+    ConstIterator begin() const;
+    ConstIterator end() const;
+    ConstIterator cbegin() const;
+    ConstIterator cend() const;
+
+    void reserve(std::size_t new_capacity);
+    void shrink_to_fit();
+    void resize(std::size_t new_size);
+    void resize(std::size_t new_size, const T &value);
+    void push_back(const T &x);
+    template <class... Args>
+    T &emplace_back(Args &&...args);
+    T pop_back();
+    void clear();
+    void insert(size_t pos, T value);
+    T erase(size_t pos);
+
+    // Записывает измененные страницы в файл (msync) и ждет окончания записи
+    void flush();
+    void advise(Advice advice);
+};
+
+#include "mmap_vector.ipp"
+
+#endif
@@ -0,0 +1,421 @@
+// Определения шаблонных методов MmapVector. Подключается в конце mmap_vector.hpp,
+// отдельно не включать
+
+// Меняет размер файла и отображения на new_capacity элементов. При росте
+// файл увеличивается до перестройки отображения, при уменьшении - после,
+// чтобы отображение никогда не выходило за конец файла
+template <class T, class BoundsCheck>
+void MmapVector<T, BoundsCheck>::remap(std::size_t new_capacity)
+{
+    const std::size_t old_bytes = capacity_ * sizeof(T);
+    const std::size_t new_bytes = new_capacity * sizeof(T);
+    if (new_capacity > capacity_ && ::ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "ftruncate");
+    }
+
+    void *mapped = nullptr;
+    if (new_capacity == 0)
+    {
+        ::munmap(data_, old_bytes);
+    }
+    else if (data_ == nullptr)
+    {
+        mapped = ::mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    }
+    else
+    {
+#ifdef __linux__
+        mapped = ::mremap(data_, old_bytes, new_bytes, MREMAP_MAYMOVE);
+#else
+        // Без mremap файл отображается заново, а старое отображение снимается
+        // только после успеха, чтобы при ошибке вектор остался прежним.
+        // Данные при этом не копируются: они в файле
+        mapped = ::mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (mapped != MAP_FAILED)
+        {
+            ::munmap(data_, old_bytes);
+        }
+#endif
+    }
+    if (mapped == MAP_FAILED)
+    {
+        throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+    data_ = static_cast<T *>(mapped);
+    capacity_ = new_capacity;
+
+    if (new_bytes < old_bytes && ::ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "ftruncate");
+    }
+}
+
+// Бросает std::logic_error, если файл открыт только на чтение
+template <class T, class BoundsCheck>
+void MmapVector<T, BoundsCheck>::check_writable() const
+{
+    if (read_only_)
+    {
+        throw std::logic_error("MmapVector is read-only");
+    }
+}
+
+// Снимает отображение, обрезает файл до size() элементов и закрывает его
+template <class T, class BoundsCheck>
+void MmapVector<T, BoundsCheck>::close()
+{
+    if (data_ != nullptr)
+    {
+        ::munmap(data_, capacity_ * sizeof(T));
+    }
+    if (fd_ >= 0)
+    {
+        if (!read_only_)
+        {
+            // Ошибку здесь сообщить некуда (вызывается из деструктора)
+            [[maybe_unused]] int result = ::ftruncate(fd_, static_cast<off_t>(size_ * sizeof(T)));
+        }
+        ::close(fd_);
+    }
+    fd_ = -1;
+    data_ = nullptr;
+    size_ = 0;
+    capacity_ = 0;
+}
+
+// Следующая емкость при росте. Начинается с одной страницы памяти, чтобы не
+// менять размер файла на каждой из первых вставок
+template <class T, class BoundsCheck>
+std::size_t MmapVector<T, BoundsCheck>::grow_capacity() const
+{
+    return capacity_ == 0 ? std::max<std::size_t>(1, 4096 / sizeof(T)) : capacity_ * 2;
+}
+
+// Открывает файл path. В режиме Create файл создается (или обрезается до
+// нуля), в остальных должен существовать, и его содержимое становится
+// элементами вектора без копирования. В режиме ReadOnly элементы нельзя
+// менять: методы, меняющие размер, бросают std::logic_error, а запись через
+// operator[] или data() приведет к SIGSEGV. Ошибки ОС - std::system_error
+template <class T, class BoundsCheck>
+MmapVector<T, BoundsCheck>::MmapVector(const std::string &path, Mode mode)
+    : read_only_{mode == Mode::ReadOnly}
+{
+    int flags = O_RDWR;
+    if (mode == Mode::Create)
+    {
+        flags = O_RDWR | O_CREAT | O_TRUNC;
+    }
+    else if (mode == Mode::ReadOnly)
+    {
+        flags = O_RDONLY;
+    }
+    fd_ = ::open(path.c_str(), flags, 0644);
+    if (fd_ < 0)
+    {
+        throw std::system_error(errno, std::generic_category(), path);
+    }
+
+    struct stat st;
+    if (::fstat(fd_, &st) != 0)
+    {
+        int error = errno;
+        ::close(fd_);
+        throw std::system_error(error, std::generic_category(), path);
+    }
+    const std::size_t bytes = static_cast<std::size_t>(st.st_size);
+    if (bytes % sizeof(T) != 0)
+    {
+        ::close(fd_);
+        throw std::runtime_error(path + ": file size is not a multiple of sizeof(T)");
+    }
+    if (bytes > 0)
+    {
+        void *mapped = ::mmap(nullptr, bytes, read_only_ ? PROT_READ : PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (mapped == MAP_FAILED)
+        {
+            int error = errno;
+            ::close(fd_);
+            throw std::system_error(error, std::generic_category(), path);
+        }
+        data_ = static_cast<T *>(mapped);
+    }
+    size_ = bytes / sizeof(T);
+    capacity_ = size_;
+}
+
+// Отображение и файл передаются, other остается пустым и закрытым
+template <class T, class BoundsCheck>
+MmapVector<T, BoundsCheck>::MmapVector(MmapVector &&other) noexcept
+    : fd_{std::exchange(other.fd_, -1)},
+      read_only_{other.read_only_},
+      size_{std::exchange(other.size_, 0)},
+      capacity_{std::exchange(other.capacity_, 0)},
+      data_{std::exchange(other.data_, nullptr)}
+{
+}
+
+template <class T, class BoundsCheck>
+MmapVector<T, BoundsCheck> &MmapVector<T, BoundsCheck>::operator=(MmapVector &&other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        fd_ = std::exchange(other.fd_, -1);
+        read_only_ = other.read_only_;
+        size_ = std::exchange(other.size_, 0);
+        capacity_ = std::exchange(other.capacity_, 0);
+        data_ = std::exchange(other.data_, nullptr);
+    }
+    return *this;
+}
+
+// Файл обрезается до size() элементов и закрывается. Измененные страницы
+// ядро запишет на диск само; чтобы дождаться записи, вызовите flush()
+template <class T, class BoundsCheck>
+MmapVector<T, BoundsCheck>::~MmapVector()
+{
+    close();
+}
+
+template <class T, class BoundsCheck>
+bool MmapVector<T, BoundsCheck>::read_only() const { return read_only_; }
+
+template <class T, class BoundsCheck>
+std::size_t MmapVector<T, BoundsCheck>::size() const { return size_; }
+
+template <class T, class BoundsCheck>
+T *MmapVector<T, BoundsCheck>::data() { return data_; }
+
+template <class T, class BoundsCheck>
+const T *MmapVector<T, BoundsCheck>::data() const { return data_; }
+
+template <class T, class BoundsCheck>
+bool MmapVector<T, BoundsCheck>::empty() const { return size_ == 0; }
+
+template <class T, class BoundsCheck>
+std::size_t MmapVector<T, BoundsCheck>::capacity() const { return capacity_; }
+
+template <class T, class BoundsCheck>
+const T &MmapVector<T, BoundsCheck>::operator[](std::size_t index) const
+{
+    BoundsCheck::check(index, size_);
+    return data_[index];
+}
+
+template <class T, class BoundsCheck>
+T &MmapVector<T, BoundsCheck>::operator[](std::size_t index)
+{
+    BoundsCheck::check(index, size_);
+    return data_[index];
+}
+
+template <class T, class BoundsCheck>
+const T &MmapVector<T, BoundsCheck>::at(std::size_t index) const
+{
+    bounds_check::Checked::check(index, size_);
+    return data_[index];
+}
+
+template <class T, class BoundsCheck>
+T &MmapVector<T, BoundsCheck>::at(std::size_t index)
+{
+    bounds_check::Checked::check(index, size_);
+    return data_[index];
+}
+
+template <class T, class BoundsCheck>
+typename MmapVector<T, BoundsCheck>::Iterator MmapVector<T, BoundsCheck>::begin() { return Iterator{data_}; }
+
+template <class T, class BoundsCheck>
+typename MmapVector<T, BoundsCheck>::Iterator MmapVector<T, BoundsCheck>::end() { return Iterator{data_ + size_}; }
+
+template <class T, class BoundsCheck>
+typename MmapVector<T, BoundsCheck>::ConstIterator MmapVector<T, BoundsCheck>::begin() const { return ConstIterator{data_}; }
+
+template <class T, class BoundsCheck>
+typename MmapVector<T, BoundsCheck>::ConstIterator MmapVector<T, BoundsCheck>::end() const { return ConstIterator{data_ + size_}; }
+
+template <class T, class BoundsCheck>
+typename MmapVector<T, BoundsCheck>::ConstIterator MmapVector<T, BoundsCheck>::cbegin() const { return begin(); }
+
+template <class T, class BoundsCheck>
+typename MmapVector<T, BoundsCheck>::ConstIterator MmapVector<T, BoundsCheck>::cend() const { return end(); }
+
+// Увеличивает файл до new_capacity элементов (если он меньше)
+template <class T, class BoundsCheck>
+void MmapVector<T, BoundsCheck>::reserve(std::size_t new_capacity)
+{
+    check_writable();
+    if (new_capacity > capacity_)
+    {
+        remap(new_capacity);
+    }
+}
+
+// Обрезает файл до size() элементов
+template <class T, class BoundsCheck>
+void MmapVector<T, BoundsCheck>::shrink_to_fit()
+{
+    check_writable();
+    if (capacity_ > size_)
+    {
+        remap(size_);
+    }
+}
+
+// Новые элементы создаются дефолтными значениями типа T
+template <class T, class BoundsCheck>
+void MmapVector<T, BoundsCheck>::resize(std::size_t new_size)
+{
+    check_writable();
+    if (new_size > capacity_)
+    {
+        remap(std::max(new_size, grow_capacity()));
+    }
+    for (std::size_t i = size_; i < new_size; i++)
+    {
+        ::new (static_cast<void *>(data_ + i)) T();
+    }
+    size_ = new_size;
+}
+
+// Новые элементы создаются копиями value
+template <class T, class BoundsCheck>
+void MmapVector<T, BoundsCheck>::resize(std::size_t new_size, const T &value)
+{
+    check_writable();
+    // value может лежать в отображении, которое переместится
+    const T copy{value};
+    if (new_size > capacity_)
+    {
+        remap(std::max(new_size, grow_capacity()));
+    }
+    for (std::size_t i = size_; i < new_size; i++)
+    {
+        ::new (static_cast<void *>(data_ + i)) T(copy);
+    }
+    size_ = new_size;
+}
+
+template <class T, class BoundsCheck>
+void MmapVector<T, BoundsCheck>::push_back(const T &x)
+{
+    emplace_back(x);
+}
+
+// Создает элемент в конце из аргументов args и возвращает ссылку на него
+template <class T, class BoundsCheck>
+template <class... Args>
+T &MmapVector<T, BoundsCheck>::emplace_back(Args &&...args)
+{
+    check_writable();
+    // Аргументы могут ссылаться на элементы, а mremap может перенести
+    // отображение, поэтому элемент создается до роста
+    const T value(std::forward<Args>(args)...);
+    if (size_ == capacity_)
+    {
+        remap(grow_capacity());
+    }
+    ::new (static_cast<void *>(data_ + size_)) T(value);
+    return data_[size_++];
+}
+
+template <class T, class BoundsCheck>
+T MmapVector<T, BoundsCheck>::pop_back()
+{
+    check_writable();
+    if (size_ == 0)
+    {
+        throw std::out_of_range("error");
+    }
+    return data_[--size_];
+}
+
+// Делает вектор пустым. Размер файла не меняется до shrink_to_fit() или
+// деструктора
+template <class T, class BoundsCheck>
+void MmapVector<T, BoundsCheck>::clear()
+{
+    check_writable();
+    size_ = 0;
+}
+
+// Вставляет новый элемент value на место pos.
+// [1, 2, 3].insert(1, 42) -> [1, 42, 2, 3]
+template <class T, class BoundsCheck>
+void MmapVector<T, BoundsCheck>::insert(size_t pos, T value)
+{
+    check_writable();
+    if (pos > size_)
+    {
+        throw std::out_of_range("error");
+    }
+    if (size_ == capacity_)
+    {
+        remap(grow_capacity());
+    }
+    std::memmove(data_ + pos + 1, data_ + pos, (size_ - pos) * sizeof(T));
+    ::new (static_cast<void *>(data_ + pos)) T(value);
+    ++size_;
+}
+
+// Удаляет элемент на месте pos и возвращает его
+// [1, 42, 2, 3].erase(1) -> 42 ([1, 2, 3])
+template <class T, class BoundsCheck>
+T MmapVector<T, BoundsCheck>::erase(size_t pos)
+{
+    check_writable();
+    if (pos >= size_)
+    {
+        throw std::out_of_range("error");
+    }
+    T value{data_[pos]};
+    std::memmove(data_ + pos, data_ + pos + 1, (size_ - pos - 1) * sizeof(T));
+    --size_;
+    return value;
+}
+
+template <class T, class BoundsCheck>
+void MmapVector<T, BoundsCheck>::flush()
+{
+    if (read_only_ || size_ == 0)
+    {
+        return;
+    }
+    if (::msync(data_, size_ * sizeof(T), MS_SYNC) != 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "msync");
+    }
+}
+
+// Подсказывает ядру, как будут читаться элементы: Sequential - заранее
+// подгружать следующие страницы, Random - не подгружать лишнего
+template <class T, class BoundsCheck>
+void MmapVector<T, BoundsCheck>::advise(Advice advice)
+{
+    if (data_ == nullptr)
+    {
+        return;
+    }
+    int flag = MADV_NORMAL;
+    switch (advice)
+    {
+    case Advice::Normal:
+        flag = MADV_NORMAL;
+        break;
+    case Advice::Sequential:
+        flag = MADV_SEQUENTIAL;
+        break;
+    case Advice::Random:
+        flag = MADV_RANDOM;
+        break;
+    case Advice::WillNeed:
+        flag = MADV_WILLNEED;
+        break;
+    }
+    if (::madvise(data_, capacity_ * sizeof(T), flag) != 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "madvise");
+    }
+}
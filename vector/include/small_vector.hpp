@@ -0,0 +1,63 @@
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include "vector.hpp"
+
+// Вектор, который хранит первые N элементов внутри самого объекта и
+// переходит в кучу (обычный Vector) только когда элементов становится больше N.
+// После перехода в кучу элементы там и остаются, даже если их снова <= N.
+template <class T, std::size_t N>
+class SmallVector {
+  static_assert(N > 0, "SmallVector needs at least one inline slot");
+
+private:
+  alignas(T) unsigned char buffer_[N * sizeof(T)];
+  // Размер, пока элементы лежат во встроенном буфере
+  std::size_t size_{};
+  // Пуст (capacity() == 0), пока элементы лежат во встроенном буфере
+  Vector<T> heap_;
+
+  T *inline_data();
+  const T *inline_data() const;
+
+  // Переносит элементы из встроенного буфера в heap_ емкостью min_capacity
+  void spill(std::size_t min_capacity);
+
+public:
+    SmallVector(std::size_t size = 0);
+
+    SmallVector(const SmallVector &other);
+    SmallVector &operator=(const SmallVector &other);
+    SmallVector(SmallVector &&other) noexcept;
+    SmallVector &operator=(SmallVector &&other) noexcept;
+
+    ~SmallVector();
+
+    // Лежат ли элементы во встроенном буфере
+    bool is_inline() const;
+
+    std::size_t size() const;
+    T *data();
+    const T *data() const;
+    bool empty() const;
+    std::size_t capacity() const;
+
+    const T &operator[](std::size_t index) const;
+    T &operator[](std::size_t index);
+    const T &at(std::size_t index) const;
+    T &at(std::size_t index);
+
+    void reserve(std::size_t new_capacity);
+    void push_back(const T &x);
+    void push_back(T &&x);
+    template <class... Args>
+    T &emplace_back(Args &&...args);
+    T pop_back();
+    void clear();
+    void insert(size_t pos, T value);
+    T erase(size_t pos);
+};
+
+#include "small_vector.ipp"
+
+#endif
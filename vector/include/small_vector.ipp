@@ -0,0 +1,298 @@
+// Определения шаблонных методов SmallVector. Подключается в конце small_vector.hpp,
+// отдельно не включать
+
+template <class T, std::size_t N>
+T *SmallVector<T, N>::inline_data()
+{
+    return reinterpret_cast<T *>(buffer_);
+}
+
+template <class T, std::size_t N>
+const T *SmallVector<T, N>::inline_data() const
+{
+    return reinterpret_cast<const T *>(buffer_);
+}
+
+// Переносит элементы из встроенного буфера в кучу. Вызывается один раз,
+// когда во встроенный буфер больше не помещается
+template <class T, std::size_t N>
+void SmallVector<T, N>::spill(std::size_t min_capacity)
+{
+    Vector<T> heap;
+    heap.reserve(std::max(min_capacity, 2 * N));
+    for (std::size_t i = 0; i < size_; i++)
+    {
+        heap.push_back(std::move(inline_data()[i]));
+    }
+    std::destroy(inline_data(), inline_data() + size_);
+    size_ = 0;
+    heap_ = std::move(heap);
+}
+
+// Создает вектор размера size заполненный дефолтными значениями типа T.
+// Если size <= N, память в куче не выделяется
+template <class T, std::size_t N>
+SmallVector<T, N>::SmallVector(std::size_t size)
+{
+    if (size <= N)
+    {
+        std::uninitialized_value_construct_n(inline_data(), size);
+        size_ = size;
+    }
+    else
+    {
+        heap_ = Vector<T>(size);
+    }
+}
+
+// Создает новый вектор, являющийся глубокой копией вектора other
+template <class T, std::size_t N>
+SmallVector<T, N>::SmallVector(const SmallVector &other)
+{
+    if (other.size() <= N)
+    {
+        std::uninitialized_copy(other.data(), other.data() + other.size(), inline_data());
+        size_ = other.size();
+    }
+    else
+    {
+        heap_ = other.heap_;
+    }
+}
+
+template <class T, std::size_t N>
+SmallVector<T, N> &SmallVector<T, N>::operator=(const SmallVector &other)
+{
+    SmallVector tmp{other};
+    *this = std::move(tmp);
+    return *this;
+}
+
+// Встроенные элементы перемещаются по одному, память в куче просто
+// передается (как в Vector)
+template <class T, std::size_t N>
+SmallVector<T, N>::SmallVector(SmallVector &&other) noexcept
+{
+    if (other.is_inline())
+    {
+        std::uninitialized_move(other.inline_data(), other.inline_data() + other.size_, inline_data());
+        size_ = other.size_;
+        other.clear();
+    }
+    else
+    {
+        heap_ = std::move(other.heap_);
+    }
+}
+
+template <class T, std::size_t N>
+SmallVector<T, N> &SmallVector<T, N>::operator=(SmallVector &&other) noexcept
+{
+    if (this == &other)
+    {
+        return *this;
+    }
+    clear();
+    heap_ = Vector<T>{};
+    if (other.is_inline())
+    {
+        std::uninitialized_move(other.inline_data(), other.inline_data() + other.size_, inline_data());
+        size_ = other.size_;
+        other.clear();
+    }
+    else
+    {
+        heap_ = std::move(other.heap_);
+    }
+    return *this;
+}
+
+// Уничтожает встроенные элементы. Память в куче очищает heap_
+template <class T, std::size_t N>
+SmallVector<T, N>::~SmallVector()
+{
+    std::destroy(inline_data(), inline_data() + size_);
+}
+
+template <class T, std::size_t N>
+bool SmallVector<T, N>::is_inline() const { return heap_.capacity() == 0; }
+
+// Возвращает размер вектора (сколько памяти уже занято)
+template <class T, std::size_t N>
+std::size_t SmallVector<T, N>::size() const
+{
+    return is_inline() ? size_ : heap_.size();
+}
+
+template <class T, std::size_t N>
+T *SmallVector<T, N>::data()
+{
+    return is_inline() ? inline_data() : heap_.data();
+}
+
+template <class T, std::size_t N>
+const T *SmallVector<T, N>::data() const
+{
+    return is_inline() ? inline_data() : heap_.data();
+}
+
+// Проверяет является ли контейнер пустым
+template <class T, std::size_t N>
+bool SmallVector<T, N>::empty() const { return size() == 0; }
+
+// Возвращает размер доступной памяти (N, пока элементы во встроенном буфере)
+template <class T, std::size_t N>
+std::size_t SmallVector<T, N>::capacity() const
+{
+    return is_inline() ? N : heap_.capacity();
+}
+
+// Возвращает ссылку на элемент по индексу
+template <class T, std::size_t N>
+const T &SmallVector<T, N>::operator[](std::size_t index) const
+{
+    bounds_check::Checked::check(index, size());
+    return data()[index];
+}
+
+// Возвращает ссылку на элемент по индексу (позволяет менять элемент)
+template <class T, std::size_t N>
+T &SmallVector<T, N>::operator[](std::size_t index)
+{
+    bounds_check::Checked::check(index, size());
+    return data()[index];
+}
+
+// То же, что operator[]: SmallVector всегда проверяет индекс
+template <class T, std::size_t N>
+const T &SmallVector<T, N>::at(std::size_t index) const
+{
+    return (*this)[index];
+}
+
+template <class T, std::size_t N>
+T &SmallVector<T, N>::at(std::size_t index)
+{
+    return (*this)[index];
+}
+
+// Резервирует память минимум под new_capacity элементов. Если new_capacity > N,
+// элементы переносятся в кучу
+template <class T, std::size_t N>
+void SmallVector<T, N>::reserve(std::size_t new_capacity)
+{
+    if (!is_inline())
+    {
+        heap_.reserve(new_capacity);
+    }
+    else if (new_capacity > N)
+    {
+        spill(new_capacity);
+    }
+}
+
+// Добавляет элемент в конец вектора
+template <class T, std::size_t N>
+void SmallVector<T, N>::push_back(const T &x)
+{
+    emplace_back(x);
+}
+
+template <class T, std::size_t N>
+void SmallVector<T, N>::push_back(T &&x)
+{
+    emplace_back(std::move(x));
+}
+
+// Создает элемент в конце вектора из аргументов args
+template <class T, std::size_t N>
+template <class... Args>
+T &SmallVector<T, N>::emplace_back(Args &&...args)
+{
+    if (!is_inline())
+    {
+        return heap_.emplace_back(std::forward<Args>(args)...);
+    }
+    if (size_ < N)
+    {
+        T *slot = ::new (static_cast<void *>(inline_data() + size_)) T(std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+    // args могут ссылаться на встроенные элементы, поэтому новый элемент
+    // создается до переноса в кучу
+    T value(std::forward<Args>(args)...);
+    spill(2 * N);
+    return heap_.emplace_back(std::move(value));
+}
+
+// Удаляет последний элемент вектора. Возвращает удаленный элемент.
+template <class T, std::size_t N>
+T SmallVector<T, N>::pop_back()
+{
+    if (!is_inline())
+    {
+        return heap_.pop_back();
+    }
+    if (size_ == 0)
+    {
+        throw std::out_of_range("error");
+    }
+    T value{std::move(inline_data()[--size_])};
+    inline_data()[size_].~T();
+    return value;
+}
+
+// Очищает вектор (выделенная память остает выделенной)
+template <class T, std::size_t N>
+void SmallVector<T, N>::clear()
+{
+    if (!is_inline())
+    {
+        heap_.clear();
+        return;
+    }
+    std::destroy(inline_data(), inline_data() + size_);
+    size_ = 0;
+}
+
+// Вставляет новый элемент value на место pos.
+// [1, 2, 3].insert(1, 42) -> [1, 42, 2, 3]
+template <class T, std::size_t N>
+void SmallVector<T, N>::insert(size_t pos, T value)
+{
+    if (pos > size())
+    {
+        throw std::out_of_range("error");
+    }
+    if (is_inline() && size_ < N)
+    {
+        emplace_back(std::move(value));
+        std::rotate(inline_data() + pos, inline_data() + size_ - 1, inline_data() + size_);
+        return;
+    }
+    if (is_inline())
+    {
+        spill(2 * N);
+    }
+    heap_.insert(pos, std::move(value));
+}
+
+// Удаляет элемент с идексом pos. Возвращает удаленный элемент.
+// [1, 2, 3].erase(1) -> [1, 3] (return 2)
+template <class T, std::size_t N>
+T SmallVector<T, N>::erase(size_t pos)
+{
+    if (!is_inline())
+    {
+        return heap_.erase(pos);
+    }
+    if (pos >= size_)
+    {
+        throw std::out_of_range("error");
+    }
+    T value{std::move(inline_data()[pos])};
+    std::move(inline_data() + pos + 1, inline_data() + size_, inline_data() + pos);
+    inline_data()[--size_].~T();
+    return value;
+}
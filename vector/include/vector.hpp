@@ -1,41 +1,222 @@
 #ifndef VECTOR_H
 #define VECTOR_H
 
+#include <algorithm>
+#include <compare>
+#include <cstring>
+#include <cstdint>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
-template <class T>
+#include "bounds_check.hpp"
+#include "snapshot.hpp"
+
+// Allocator - аллокатор элементов (по умолчанию std::allocator<T>). Вся
+// память и все элементы создаются и уничтожаются только через него.
+// BoundsCheck - проверка индекса в operator[] (см. bounds_check.hpp)
+template <class T, class Allocator = std::allocator<T>,
+          class BoundsCheck = bounds_check::Checked>
 class Vector {
 private:
+  using AllocTraits = std::allocator_traits<Allocator>;
+
+  Allocator alloc_;
   std::size_t size_;
   std::size_t capacity_;
   T *data_;
 
+  // Выделяет сырую (неинициализированную) память под capacity элементов
+  T *allocate(std::size_t capacity);
+  void deallocate(T *data, std::size_t capacity);
+
+  void destroy(T *first, T *last);
+  template <class Construct>
+  void construct_range(T *first, T *last, Construct construct_one);
+
+  // Переносит элементы [first, last) в неинициализированную память dest.
+  // Для trivially copyable T это один memcpy, иначе move + деструктор
+  void relocate(T *first, T *last, T *dest);
+
+  // Сдвигают элементы [first, last) на count позиций влево/вправо внутри
+  // буфера. Освободившиеся позиции остаются неинициализированными.
+  // Для trivially copyable T это один memmove
+  void shift_left(T *first, T *last, std::size_t count);
+  void shift_right(T *first, T *last, std::size_t count);
+
+  // Освобождает место под count элементов перед pos (перевыделяя память,
+  // если нужно) и создает их вызовом construct_one(p) для каждой позиции
+  template <class Construct>
+  void insert_gap(std::size_t pos, std::size_t count, Construct construct_one);
+
+  // Перевыделяет память ровно под new_capacity элементов (new_capacity >= size_)
+  void reallocate(std::size_t new_capacity);
+
+  // Следующая емкость при росте
+  std::size_t grow_capacity() const;
+
+  // Обменивается с other памятью и элементами, но не аллокаторами
+  void swap_storage(Vector &other) noexcept;
+
 public:
+    template <class Pointer>
+    class BasicIterator;
+    using Iterator = BasicIterator<T *>;
+    using ConstIterator = BasicIterator<const T *>;
 
-    Vector(std::size_t size = 0);
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
+    using reverse_iterator = std::reverse_iterator<Iterator>;
+    using const_reverse_iterator = std::reverse_iterator<ConstIterator>;
+
+    static_assert(std::is_same_v<typename AllocTraits::value_type, T>,
+                  "Allocator::value_type must be T");
+
+    Vector(std::size_t size = 0, const Allocator &alloc = Allocator());
+    explicit Vector(const Allocator &alloc);
 
     Vector(const Vector &other);
+    Vector(const Vector &other, const Allocator &alloc);
     Vector &operator=(const Vector &other);
-    Vector(Vector &&other);
-    Vector &operator=(Vector &&other);
+    Vector(Vector &&other) noexcept;
+    Vector(Vector &&other, const Allocator &alloc);
+    // Не бросает, если аллокатор переходит вместе с памятью или все
+    // аллокаторы типа равны. Иначе при неравных аллокаторах элементы
+    // перемещаются по одному в новую память
+    Vector &operator=(Vector &&other) noexcept(
+        AllocTraits::propagate_on_container_move_assignment::value ||
+        AllocTraits::is_always_equal::value);
 
     ~Vector();
 
+    Allocator get_allocator() const;
+
     std::size_t size() const;
+    T *data();
     const T *data() const;
     bool empty() const;
     std::size_t capacity() const;
 
-    T operator[](std::size_t index) const;
+    const T &operator[](std::size_t index) const;
     T &operator[](std::size_t index);
+    const T &at(std::size_t index) const;
+    T &at(std::size_t index);
 
-    void resize(std::size_t new_capacity);
+    Iterator begin();
+    Iterator end();
+    ConstIterator begin() const;
+    ConstIterator end() const;
+    ConstIterator cbegin() const;
+    ConstIterator cend() const;
+
+    reverse_iterator rbegin();
+    reverse_iterator rend();
+    const_reverse_iterator rbegin() const;
+    const_reverse_iterator rend() const;
+    const_reverse_iterator crbegin() const;
+    const_reverse_iterator crend() const;
+
+    void reserve(std::size_t new_capacity);
+    void shrink_to_fit();
+    void resize(std::size_t new_size);
+    void resize(std::size_t new_size, const T &value);
     void push_back(const T &x);
+    void push_back(T &&x);
+    template <class... Args>
+    T &emplace_back(Args &&...args);
     T pop_back();
     void clear();
     void insert(size_t pos, T value);
+    void insert(size_t pos, std::size_t count, const T &value);
+    template <class InputIt,
+              class = std::enable_if_t<std::is_base_of_v<
+                  std::input_iterator_tag,
+                  typename std::iterator_traits<InputIt>::iterator_category>>>
+    void insert(size_t pos, InputIt first, InputIt last);
     T erase(size_t pos);
-    
+    void erase(size_t first, size_t last);
+
+    // Бинарный снимок (см. snapshot.hpp): заголовок, размер и data() одним
+    // блоком. Только для trivially copyable T
+    void save(std::ostream &os) const;
+    void load(std::istream &is);
+
+    // Итератор произвольного доступа по непрерывной памяти (contiguous),
+    // поэтому с Vector работают std::sort, std::ranges и параллельные
+    // алгоритмы. Pointer - T* для Iterator и const T* для ConstIterator
+    template <class Pointer>
+    class BasicIterator {
+        friend Vector;
+        template <class Other>
+        friend class BasicIterator;
+
+        Pointer ptr{};
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept = std::contiguous_iterator_tag;
+        using value_type = T;
+        using element_type = std::remove_pointer_t<Pointer>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Pointer;
+        using reference = element_type &;
+
+        BasicIterator() = default;
+        explicit BasicIterator(Pointer p) : ptr{p} {}
+
+        // Iterator неявно превращается в ConstIterator, но не наоборот
+        template <class Other,
+                  class = std::enable_if_t<std::is_convertible_v<Other, Pointer>>>
+        BasicIterator(const BasicIterator<Other> &other) : ptr{other.ptr} {}
+
+        // разыменование (как с указателями): *it = 42; или std::cout << *it;
+        reference operator*() const { return *ptr; }
+        pointer operator->() const { return ptr; }
+        reference operator[](difference_type n) const { return ptr[n]; }
+
+        BasicIterator &operator++() {
+            ++ptr;
+            return *this;
+        }
+        BasicIterator operator++(int) { return BasicIterator{ptr++}; }
+        BasicIterator &operator--() {
+            --ptr;
+            return *this;
+        }
+        BasicIterator operator--(int) { return BasicIterator{ptr--}; }
+
+        BasicIterator &operator+=(difference_type n) {
+            ptr += n;
+            return *this;
+        }
+        BasicIterator &operator-=(difference_type n) {
+            ptr -= n;
+            return *this;
+        }
+        BasicIterator operator+(difference_type n) const { return BasicIterator{ptr + n}; }
+        friend BasicIterator operator+(difference_type n, const BasicIterator &it) {
+            return BasicIterator{it.ptr + n};
+        }
+        BasicIterator operator-(difference_type n) const { return BasicIterator{ptr - n}; }
+        difference_type operator-(const BasicIterator &other) const { return ptr - other.ptr; }
+
+        bool operator==(const BasicIterator &other) const = default;
+        auto operator<=>(const BasicIterator &other) const = default;
+    };
 };
 
+#include "vector.ipp"
+
 #endif
\ No newline at end of file
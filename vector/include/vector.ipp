@@ -0,0 +1,689 @@
+// Определения шаблонных методов Vector. Подключается в конце vector.hpp,
+// отдельно не включать
+
+template <class T, class Allocator, class BoundsCheck>
+T *Vector<T, Allocator, BoundsCheck>::allocate(std::size_t capacity)
+{
+    if (capacity == 0)
+    {
+        return nullptr;
+    }
+    return AllocTraits::allocate(alloc_, capacity);
+}
+
+template <class T, class Allocator, class BoundsCheck>
+void Vector<T, Allocator, BoundsCheck>::deallocate(T *data, std::size_t capacity)
+{
+    if (data)
+    {
+        AllocTraits::deallocate(alloc_, data, capacity);
+    }
+}
+
+// Уничтожает элементы [first, last) через аллокатор
+template <class T, class Allocator, class BoundsCheck>
+void Vector<T, Allocator, BoundsCheck>::destroy(T *first, T *last)
+{
+    for (; first != last; ++first)
+    {
+        AllocTraits::destroy(alloc_, first);
+    }
+}
+
+// Создает элементы [first, last) вызовом construct_one(p) для каждого p.
+// Если создание бросает исключение, уже созданные элементы уничтожаются
+template <class T, class Allocator, class BoundsCheck>
+template <class Construct>
+void Vector<T, Allocator, BoundsCheck>::construct_range(T *first, T *last, Construct construct_one)
+{
+    T *current = first;
+    try
+    {
+        for (; current != last; ++current)
+        {
+            construct_one(current);
+        }
+    }
+    catch (...)
+    {
+        destroy(first, current);
+        throw;
+    }
+}
+
+// Переносит элементы в новую память. Для trivially copyable T достаточно
+// memcpy, иначе элементы перемещаются (или копируются, если move может
+// бросить исключение) и старые объекты уничтожаются
+template <class T, class Allocator, class BoundsCheck>
+void Vector<T, Allocator, BoundsCheck>::relocate(T *first, T *last, T *dest)
+{
+    if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        if (first != last)
+        {
+            std::memcpy(static_cast<void *>(dest), first, (last - first) * sizeof(T));
+        }
+    }
+    else
+    {
+        if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                      !std::is_copy_constructible_v<T>)
+        {
+            for (; first != last; ++first, ++dest)
+            {
+                AllocTraits::construct(alloc_, dest, std::move(*first));
+                AllocTraits::destroy(alloc_, first);
+            }
+        }
+        else
+        {
+            T *source = first;
+            construct_range(dest, dest + (last - first),
+                            [&](T *p) { AllocTraits::construct(alloc_, p, *source++); });
+            destroy(first, last);
+        }
+    }
+}
+
+template <class T, class Allocator, class BoundsCheck>
+void Vector<T, Allocator, BoundsCheck>::shift_left(T *first, T *last, std::size_t count)
+{
+    if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        if (first != last)
+        {
+            std::memmove(static_cast<void *>(first - count), first, (last - first) * sizeof(T));
+        }
+    }
+    else
+    {
+        for (; first != last; ++first)
+        {
+            AllocTraits::construct(alloc_, first - count, std::move(*first));
+            AllocTraits::destroy(alloc_, first);
+        }
+    }
+}
+
+template <class T, class Allocator, class BoundsCheck>
+void Vector<T, Allocator, BoundsCheck>::shift_right(T *first, T *last, std::size_t count)
+{
+    if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        if (first != last)
+        {
+            std::memmove(static_cast<void *>(first + count), first, (last - first) * sizeof(T));
+        }
+    }
+    else
+    {
+        while (last != first)
+        {
+            --last;
+            AllocTraits::construct(alloc_, last + count, std::move(*last));
+            AllocTraits::destroy(alloc_, last);
+        }
+    }
+}
+
+// Общая часть всех insert. Если памяти не хватает, новые элементы создаются
+// сразу в новом буфере, а старые переносятся вокруг них - без лишнего сдвига
+template <class T, class Allocator, class BoundsCheck>
+template <class Construct>
+void Vector<T, Allocator, BoundsCheck>::insert_gap(std::size_t pos, std::size_t count, Construct construct_one)
+{
+    if (pos > size_)
+    {
+        throw std::out_of_range("error");
+    }
+    if (count == 0)
+    {
+        return;
+    }
+    if (size_ + count > capacity_)
+    {
+        std::size_t new_capacity = std::max(size_ + count, grow_capacity());
+        T *data_new = allocate(new_capacity);
+        try
+        {
+            construct_range(data_new + pos, data_new + pos + count, construct_one);
+        }
+        catch (...)
+        {
+            deallocate(data_new, new_capacity);
+            throw;
+        }
+        relocate(data_, data_ + pos, data_new);
+        relocate(data_ + pos, data_ + size_, data_new + pos + count);
+        deallocate(data_, capacity_);
+        data_ = data_new;
+        capacity_ = new_capacity;
+    }
+    else
+    {
+        shift_right(data_ + pos, data_ + size_, count);
+        try
+        {
+            construct_range(data_ + pos, data_ + pos + count, construct_one);
+        }
+        catch (...)
+        {
+            shift_left(data_ + pos + count, data_ + size_ + count, count);
+            throw;
+        }
+    }
+    size_ += count;
+}
+
+template <class T, class Allocator, class BoundsCheck>
+void Vector<T, Allocator, BoundsCheck>::reallocate(std::size_t new_capacity)
+{
+    T *data_new = allocate(new_capacity);
+    try
+    {
+        relocate(data_, data_ + size_, data_new);
+    }
+    catch (...)
+    {
+        deallocate(data_new, new_capacity);
+        throw;
+    }
+    deallocate(data_, capacity_);
+    data_ = data_new;
+    capacity_ = new_capacity;
+}
+
+template <class T, class Allocator, class BoundsCheck>
+std::size_t Vector<T, Allocator, BoundsCheck>::grow_capacity() const
+{
+    return capacity_ == 0 ? 1 : 2 * capacity_;
+}
+
+// Создает вектор размера size заполненный дефолтными значениями типа T.
+// Память под элементы выделяется ровно один раз и сразу же инициализируется
+template <class T, class Allocator, class BoundsCheck>
+Vector<T, Allocator, BoundsCheck>::Vector(std::size_t size, const Allocator &alloc)
+    : alloc_{alloc}, size_{size}, capacity_{size}, data_{allocate(size)}
+{
+    try
+    {
+        construct_range(data_, data_ + size_, [&](T *p) { AllocTraits::construct(alloc_, p); });
+    }
+    catch (...)
+    {
+        deallocate(data_, capacity_);
+        throw;
+    }
+}
+
+// Создает пустой вектор, память которого выделяет alloc
+template <class T, class Allocator, class BoundsCheck>
+Vector<T, Allocator, BoundsCheck>::Vector(const Allocator &alloc)
+    : alloc_{alloc}, size_{0}, capacity_{0}, data_{nullptr} {}
+
+// Создает новый вектор, являющийся глубокой копией вектора other
+template <class T, class Allocator, class BoundsCheck>
+Vector<T, Allocator, BoundsCheck>::Vector(const Vector &other)
+    : Vector(other, AllocTraits::select_on_container_copy_construction(other.alloc_)) {}
+
+// То же, но память копии выделяет alloc
+template <class T, class Allocator, class BoundsCheck>
+Vector<T, Allocator, BoundsCheck>::Vector(const Vector &other, const Allocator &alloc)
+    : alloc_{alloc}, size_{other.size_}, capacity_{other.size_},
+      data_{allocate(other.size_)}
+{
+    try
+    {
+        const T *source = other.data_;
+        construct_range(data_, data_ + size_,
+                        [&](T *p) { AllocTraits::construct(alloc_, p, *source++); });
+    }
+    catch (...)
+    {
+        deallocate(data_, capacity_);
+        throw;
+    }
+}
+
+template <class T, class Allocator, class BoundsCheck>
+void Vector<T, Allocator, BoundsCheck>::swap_storage(Vector &other) noexcept
+{
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+}
+
+// Перезаписывает текущий вектор вектором other
+// Vector v1{5}, v2{10};
+// v1 = v2;
+// std::cout << v1.size() == 10 << std::endl // True
+// Аллокатор other переходит сюда, только если этого требует
+// propagate_on_container_copy_assignment, иначе остается свой
+template <class T, class Allocator, class BoundsCheck>
+Vector<T, Allocator, BoundsCheck> &Vector<T, Allocator, BoundsCheck>::operator=(const Vector<T, Allocator, BoundsCheck> &other)
+{
+    constexpr bool propagate = AllocTraits::propagate_on_container_copy_assignment::value;
+    Vector tmp{other, propagate ? other.alloc_ : alloc_};
+    swap_storage(tmp);
+    if constexpr (propagate)
+    {
+        std::swap(alloc_, tmp.alloc_);
+    }
+    return *this;
+}
+
+template <class T, class Allocator, class BoundsCheck>
+Vector<T, Allocator, BoundsCheck>::Vector(Vector &&other) noexcept
+    : alloc_{std::move(other.alloc_)}, size_{other.size_},
+      capacity_{other.capacity_}, data_{other.data_}
+{
+    other.data_ = nullptr;
+    other.size_ = other.capacity_ = 0;
+}
+
+// Перемещает other в вектор с аллокатором alloc. Память other можно забрать,
+// только если alloc равен его аллокатору; иначе элементы по одному
+// перемещаются в новую память от alloc, а other остается с перемещенными
+// элементами
+template <class T, class Allocator, class BoundsCheck>
+Vector<T, Allocator, BoundsCheck>::Vector(Vector &&other, const Allocator &alloc)
+    : alloc_{alloc}, size_{0}, capacity_{0}, data_{nullptr}
+{
+    if (AllocTraits::is_always_equal::value || alloc_ == other.alloc_)
+    {
+        swap_storage(other);
+        return;
+    }
+    data_ = allocate(other.size_);
+    capacity_ = other.size_;
+    try
+    {
+        T *source = other.data_;
+        construct_range(data_, data_ + other.size_,
+                        [&](T *p) { AllocTraits::construct(alloc_, p, std::move(*source++)); });
+    }
+    catch (...)
+    {
+        deallocate(data_, capacity_);
+        throw;
+    }
+    size_ = other.size_;
+}
+
+// Аллокатор other переходит сюда вместе с памятью, только если этого требует
+// propagate_on_container_move_assignment. Иначе остается свой, и при
+// неравных аллокаторах элементы перемещаются по одному
+template <class T, class Allocator, class BoundsCheck>
+Vector<T, Allocator, BoundsCheck> &Vector<T, Allocator, BoundsCheck>::operator=(Vector<T, Allocator, BoundsCheck> &&other) noexcept(
+    AllocTraits::propagate_on_container_move_assignment::value ||
+    AllocTraits::is_always_equal::value)
+{
+    if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+    {
+        Vector tmp{std::move(other)};
+        swap_storage(tmp);
+        std::swap(alloc_, tmp.alloc_);
+    }
+    else
+    {
+        Vector tmp{std::move(other), alloc_};
+        swap_storage(tmp);
+    }
+    return *this;
+}
+
+// Уничтожает элементы и очищает память вектора
+template <class T, class Allocator, class BoundsCheck>
+Vector<T, Allocator, BoundsCheck>::~Vector()
+{
+    destroy(data_, data_ + size_);
+    deallocate(data_, capacity_);
+}
+
+// Возвращает размер вектора (сколько памяти уже занято)
+template <class T, class Allocator, class BoundsCheck>
+std::size_t Vector<T, Allocator, BoundsCheck>::size() const { return size_; }
+
+template <class T, class Allocator, class BoundsCheck>
+Allocator Vector<T, Allocator, BoundsCheck>::get_allocator() const { return alloc_; }
+
+template <class T, class Allocator, class BoundsCheck>
+T *Vector<T, Allocator, BoundsCheck>::data() { return data_; }
+
+template <class T, class Allocator, class BoundsCheck>
+const T* Vector<T, Allocator, BoundsCheck>::data() const { return data_; }
+
+// Проверяет является ли контейнер пустым
+template <class T, class Allocator, class BoundsCheck>
+bool Vector<T, Allocator, BoundsCheck>::empty() const { return size_ == 0; }
+
+// Возвращает размер выделенной памяти
+template <class T, class Allocator, class BoundsCheck>
+std::size_t Vector<T, Allocator, BoundsCheck>::capacity() const { return capacity_; }
+
+// Возвращает ссылку на элемент по индексу. Проверка индекса задается
+// политикой BoundsCheck (по умолчанию бросает std::out_of_range)
+template <class T, class Allocator, class BoundsCheck>
+const T &Vector<T, Allocator, BoundsCheck>::operator[](std::size_t index) const
+{
+    BoundsCheck::check(index, size_);
+    return data_[index];
+}
+
+// Возвращает ссылку на элемент по индексу (позволяет менять элемент, типа
+// v[5] = 42;)
+template <class T, class Allocator, class BoundsCheck>
+T &Vector<T, Allocator, BoundsCheck>::operator[](std::size_t index)
+{
+    BoundsCheck::check(index, size_);
+    return data_[index];
+}
+
+// Возвращает ссылку на элемент по индексу. Индекс проверяется всегда,
+// при выходе за границы бросает std::out_of_range
+template <class T, class Allocator, class BoundsCheck>
+const T &Vector<T, Allocator, BoundsCheck>::at(std::size_t index) const
+{
+    bounds_check::Checked::check(index, size_);
+    return data_[index];
+}
+
+template <class T, class Allocator, class BoundsCheck>
+T &Vector<T, Allocator, BoundsCheck>::at(std::size_t index)
+{
+    bounds_check::Checked::check(index, size_);
+    return data_[index];
+}
+
+// Возвращает итератор на первый элемент
+template <class T, class Allocator, class BoundsCheck>
+typename Vector<T, Allocator, BoundsCheck>::Iterator Vector<T, Allocator, BoundsCheck>::begin() { return Iterator{data_}; }
+
+// Возвращает итератор обозначающий конец контейнера
+template <class T, class Allocator, class BoundsCheck>
+typename Vector<T, Allocator, BoundsCheck>::Iterator Vector<T, Allocator, BoundsCheck>::end() { return Iterator{data_ + size_}; }
+
+template <class T, class Allocator, class BoundsCheck>
+typename Vector<T, Allocator, BoundsCheck>::ConstIterator Vector<T, Allocator, BoundsCheck>::begin() const { return ConstIterator{data_}; }
+
+template <class T, class Allocator, class BoundsCheck>
+typename Vector<T, Allocator, BoundsCheck>::ConstIterator Vector<T, Allocator, BoundsCheck>::end() const { return ConstIterator{data_ + size_}; }
+
+template <class T, class Allocator, class BoundsCheck>
+typename Vector<T, Allocator, BoundsCheck>::ConstIterator Vector<T, Allocator, BoundsCheck>::cbegin() const { return begin(); }
+
+template <class T, class Allocator, class BoundsCheck>
+typename Vector<T, Allocator, BoundsCheck>::ConstIterator Vector<T, Allocator, BoundsCheck>::cend() const { return end(); }
+
+// Итераторы для обхода с конца: for (auto it = v.rbegin(); it != v.rend(); ++it)
+template <class T, class Allocator, class BoundsCheck>
+typename Vector<T, Allocator, BoundsCheck>::reverse_iterator Vector<T, Allocator, BoundsCheck>::rbegin() { return reverse_iterator{end()}; }
+
+template <class T, class Allocator, class BoundsCheck>
+typename Vector<T, Allocator, BoundsCheck>::reverse_iterator Vector<T, Allocator, BoundsCheck>::rend() { return reverse_iterator{begin()}; }
+
+template <class T, class Allocator, class BoundsCheck>
+typename Vector<T, Allocator, BoundsCheck>::const_reverse_iterator Vector<T, Allocator, BoundsCheck>::rbegin() const { return const_reverse_iterator{end()}; }
+
+template <class T, class Allocator, class BoundsCheck>
+typename Vector<T, Allocator, BoundsCheck>::const_reverse_iterator Vector<T, Allocator, BoundsCheck>::rend() const { return const_reverse_iterator{begin()}; }
+
+template <class T, class Allocator, class BoundsCheck>
+typename Vector<T, Allocator, BoundsCheck>::const_reverse_iterator Vector<T, Allocator, BoundsCheck>::crbegin() const { return rbegin(); }
+
+template <class T, class Allocator, class BoundsCheck>
+typename Vector<T, Allocator, BoundsCheck>::const_reverse_iterator Vector<T, Allocator, BoundsCheck>::crend() const { return rend(); }
+
+// Резервирует память минимум под new_capacity элементов. Элементы не
+// создаются, size() не меняется
+template <class T, class Allocator, class BoundsCheck>
+void Vector<T, Allocator, BoundsCheck>::reserve(std::size_t new_capacity)
+{
+    if (new_capacity > capacity_)
+    {
+        reallocate(new_capacity);
+    }
+}
+
+// Отдает лишнюю память: capacity() становится равным size()
+template <class T, class Allocator, class BoundsCheck>
+void Vector<T, Allocator, BoundsCheck>::shrink_to_fit()
+{
+    if (capacity_ > size_)
+    {
+        reallocate(size_);
+    }
+}
+
+// Меняет размер вектора как std::vector::resize:
+// * лишние элементы уничтожаются,
+// * недостающие создаются дефолтными значениями (или копиями value).
+// [1, 2, 3].resize(5) -> [1, 2, 3, 0, 0]
+template <class T, class Allocator, class BoundsCheck>
+void Vector<T, Allocator, BoundsCheck>::resize(std::size_t new_size)
+{
+    if (new_size <= size_)
+    {
+        destroy(data_ + new_size, data_ + size_);
+        size_ = new_size;
+        return;
+    }
+    if (new_size > capacity_)
+    {
+        reallocate(std::max(new_size, grow_capacity()));
+    }
+    construct_range(data_ + size_, data_ + new_size,
+                    [&](T *p) { AllocTraits::construct(alloc_, p); });
+    size_ = new_size;
+}
+
+template <class T, class Allocator, class BoundsCheck>
+void Vector<T, Allocator, BoundsCheck>::resize(std::size_t new_size, const T &value)
+{
+    if (new_size <= size_)
+    {
+        destroy(data_ + new_size, data_ + size_);
+        size_ = new_size;
+        return;
+    }
+    if (new_size > capacity_)
+    {
+        // value может ссылаться на элемент самого вектора
+        T copy{value};
+        reallocate(std::max(new_size, grow_capacity()));
+        construct_range(data_ + size_, data_ + new_size,
+                        [&](T *p) { AllocTraits::construct(alloc_, p, copy); });
+    }
+    else
+    {
+        construct_range(data_ + size_, data_ + new_size,
+                        [&](T *p) { AllocTraits::construct(alloc_, p, value); });
+    }
+    size_ = new_size;
+}
+
+// Добавляет элемент в конец вектора. Если нужно перевыделяет память
+template <class T, class Allocator, class BoundsCheck>
+void Vector<T, Allocator, BoundsCheck>::push_back(const T &x)
+{
+    emplace_back(x);
+}
+
+template <class T, class Allocator, class BoundsCheck>
+void Vector<T, Allocator, BoundsCheck>::push_back(T &&x)
+{
+    emplace_back(std::move(x));
+}
+
+// Создает элемент прямо в памяти вектора из аргументов args.
+// При перевыделении новый элемент создается до переноса старых, поэтому
+// args могут ссылаться на элементы самого вектора
+template <class T, class Allocator, class BoundsCheck>
+template <class... Args>
+T &Vector<T, Allocator, BoundsCheck>::emplace_back(Args &&...args)
+{
+    if (size_ == capacity_)
+    {
+        std::size_t new_capacity = grow_capacity();
+        T *data_new = allocate(new_capacity);
+        try
+        {
+            AllocTraits::construct(alloc_, data_new + size_, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            deallocate(data_new, new_capacity);
+            throw;
+        }
+        try
+        {
+            relocate(data_, data_ + size_, data_new);
+        }
+        catch (...)
+        {
+            AllocTraits::destroy(alloc_, data_new + size_);
+            deallocate(data_new, new_capacity);
+            throw;
+        }
+        deallocate(data_, capacity_);
+        data_ = data_new;
+        capacity_ = new_capacity;
+    }
+    else
+    {
+        AllocTraits::construct(alloc_, data_ + size_, std::forward<Args>(args)...);
+    }
+    return data_[size_++];
+}
+
+// Удаляет последний элемент вектора. Возвращает удаленный элемент.
+template <class T, class Allocator, class BoundsCheck>
+T Vector<T, Allocator, BoundsCheck>::pop_back()
+{
+    if (size_ == 0)
+    {
+        throw std::out_of_range("error");
+    }
+    T value{std::move(data_[--size_])};
+    AllocTraits::destroy(alloc_, data_ + size_);
+    return value;
+}
+
+// Очищает вектор (выделенная память остает выделенной)
+template <class T, class Allocator, class BoundsCheck>
+void Vector<T, Allocator, BoundsCheck>::clear()
+{
+    destroy(data_, data_ + size_);
+    size_ = 0;
+}
+
+// Вставляет новый элемент value на место pos.
+// [1, 2, 3].insert(1, 42) -> [1, 42, 2, 3]
+template <class T, class Allocator, class BoundsCheck>
+void Vector<T, Allocator, BoundsCheck>::insert(size_t pos, T value)
+{
+    insert_gap(pos, 1, [&](T *p) { AllocTraits::construct(alloc_, p, std::move(value)); });
+}
+
+// Вставляет count копий value на место pos.
+// [1, 2, 3].insert(1, 2, 42) -> [1, 42, 42, 2, 3]
+template <class T, class Allocator, class BoundsCheck>
+void Vector<T, Allocator, BoundsCheck>::insert(size_t pos, std::size_t count, const T &value)
+{
+    // value может ссылаться на элемент, который сдвинется
+    const T copy{value};
+    insert_gap(pos, count, [&](T *p) { AllocTraits::construct(alloc_, p, copy); });
+}
+
+// Вставляет элементы [first, last) на место pos. Хвост вектора сдвигается
+// один раз, а не на каждый элемент. first и last не должны указывать
+// внутрь самого вектора.
+// [1, 2, 3].insert(1, {7, 8}) -> [1, 7, 8, 2, 3]
+template <class T, class Allocator, class BoundsCheck>
+template <class InputIt, class>
+void Vector<T, Allocator, BoundsCheck>::insert(size_t pos, InputIt first, InputIt last)
+{
+    using Category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>)
+    {
+        std::size_t count = std::distance(first, last);
+        insert_gap(pos, count, [&](T *p) { AllocTraits::construct(alloc_, p, *first++); });
+    }
+    else
+    {
+        // Длина диапазона неизвестна: дописываем в конец и поворачиваем
+        if (pos > size_)
+        {
+            throw std::out_of_range("error");
+        }
+        std::size_t old_size = size_;
+        for (; first != last; ++first)
+        {
+            emplace_back(*first);
+        }
+        std::rotate(data_ + pos, data_ + old_size, data_ + size_);
+    }
+}
+
+// Удаляет элемент с идексом pos. Возвращает удаленный элемент.
+// [1, 2, 3].erase(1) -> [1, 3] (return 2)
+template <class T, class Allocator, class BoundsCheck>
+T Vector<T, Allocator, BoundsCheck>::erase(size_t pos)
+{
+    if (pos >= size_)
+    {
+        throw std::out_of_range("error");
+    }
+    T value{std::move(data_[pos])};
+    AllocTraits::destroy(alloc_, data_ + pos);
+    shift_left(data_ + pos + 1, data_ + size_, 1);
+    --size_;
+    return value;
+}
+
+// Удаляет элементы с индексами [first, last). Хвост сдвигается один раз.
+// [1, 2, 3, 4].erase(1, 3) -> [1, 4]
+template <class T, class Allocator, class BoundsCheck>
+void Vector<T, Allocator, BoundsCheck>::erase(size_t first, size_t last)
+{
+    if (first > last || last > size_)
+    {
+        throw std::out_of_range("error");
+    }
+    if (first == last)
+    {
+        return;
+    }
+    destroy(data_ + first, data_ + last);
+    shift_left(data_ + last, data_ + size_, last - first);
+    size_ -= last - first;
+}
+
+// Записывает вектор в поток: заголовок, количество элементов и содержимое
+// data() одним write
+template <class T, class Allocator, class BoundsCheck>
+void Vector<T, Allocator, BoundsCheck>::save(std::ostream &os) const
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Vector::save needs trivially copyable T");
+    snapshot::write_header(os, "VECT", sizeof(T), 0);
+    snapshot::write(os, static_cast<std::uint64_t>(size_));
+    snapshot::write_bytes(os, data_, size_ * sizeof(T));
+}
+
+// Заменяет содержимое вектора снимком из потока. Память выделяется один раз
+// под точный размер, элементы читаются прямо в нее. При ошибке бросает
+// snapshot::Error, а вектор остается прежним
+template <class T, class Allocator, class BoundsCheck>
+void Vector<T, Allocator, BoundsCheck>::load(std::istream &is)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Vector::load needs trivially copyable T");
+    snapshot::read_header(is, "VECT", sizeof(T), 0);
+    std::uint64_t size = 0;
+    snapshot::read(is, size);
+    snapshot::check_count(is, size, sizeof(T));
+    Vector tmp(alloc_);
+    tmp.reserve(size);
+    snapshot::read_bytes(is, tmp.data_, size * sizeof(T));
+    tmp.size_ = size;
+    *this = std::move(tmp);
+}
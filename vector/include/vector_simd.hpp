@@ -0,0 +1,574 @@
+#ifndef VECTOR_SIMD_H
+#define VECTOR_SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "vector.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define VECTOR_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define VECTOR_SIMD_X86 0
+#endif
+
+// Массовые операции над Vector арифметических типов: fill, find, count, sum,
+// minmax, transform_inplace. Для std::int32_t и float есть SSE2 и AVX2
+// версии, нужная выбирается при первом вызове по возможностям процессора.
+// Остальные типы (и не-x86 платформы) идут через скалярный цикл.
+//
+// Vector<float> v = ...;
+// float total = simd::sum(v);
+// std::size_t i = simd::find(v, 42.0f); // v.size(), если не найдено
+//
+// Для float sum складывает в другом порядке, чем скалярный цикл, поэтому
+// результат может отличаться в последних битах. NaN в minmax не учитываются
+// корректно. Целочисленная сумма считается по модулю 2^N, как в unsigned.
+namespace simd {
+
+enum class Level { Scalar, SSE2, AVX2 };
+
+namespace detail {
+
+inline Level detect_level() {
+#if VECTOR_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return Level::AVX2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return Level::SSE2;
+  }
+#endif
+  return Level::Scalar;
+}
+
+template <class T>
+inline constexpr bool has_kernels =
+    VECTOR_SIMD_X86 && (std::is_same_v<T, std::int32_t> || std::is_same_v<T, float>);
+
+// ---- скалярные версии (для всех арифметических T) ----
+
+template <class T> void fill_scalar(T *data, std::size_t n, T value) {
+  for (std::size_t i = 0; i < n; i++) {
+    data[i] = value;
+  }
+}
+
+template <class T> std::size_t find_scalar(const T *data, std::size_t n, T value) {
+  for (std::size_t i = 0; i < n; i++) {
+    if (data[i] == value) {
+      return i;
+    }
+  }
+  return n;
+}
+
+template <class T> std::size_t count_scalar(const T *data, std::size_t n, T value) {
+  std::size_t result = 0;
+  for (std::size_t i = 0; i < n; i++) {
+    result += data[i] == value;
+  }
+  return result;
+}
+
+template <class T> T sum_scalar(const T *data, std::size_t n) {
+  if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+    using U = std::make_unsigned_t<T>;
+    U result = 0;
+    for (std::size_t i = 0; i < n; i++) {
+      result += static_cast<U>(data[i]);
+    }
+    return static_cast<T>(result);
+  } else {
+    T result{};
+    for (std::size_t i = 0; i < n; i++) {
+      result += data[i];
+    }
+    return result;
+  }
+}
+
+// Сложение целых по модулю 2^N (без переполнения знакового типа)
+template <class T> T wrapping_add(T a, T b) {
+  using U = std::make_unsigned_t<T>;
+  return static_cast<T>(static_cast<U>(a) + static_cast<U>(b));
+}
+
+template <class T> std::pair<T, T> minmax_scalar(const T *data, std::size_t n) {
+  T lo = data[0], hi = data[0];
+  for (std::size_t i = 1; i < n; i++) {
+    lo = data[i] < lo ? data[i] : lo;
+    hi = hi < data[i] ? data[i] : hi;
+  }
+  return {lo, hi};
+}
+
+template <class T, class Op> void transform_scalar(T *data, std::size_t n, Op &op) {
+  for (std::size_t i = 0; i < n; i++) {
+    data[i] = op(data[i]);
+  }
+}
+
+#if VECTOR_SIMD_X86
+
+// Число единичных бит в 4-битной маске сравнения. __builtin_popcount без
+// -mpopcnt превращается в вызов библиотечной функции
+inline constexpr unsigned char mask_bits[16] = {0, 1, 1, 2, 1, 2, 2, 3,
+                                                1, 2, 2, 3, 2, 3, 3, 4};
+
+// GCC векторизует циклы только с -O3 или с этим атрибутом; clang
+// векторизует на -O2 и атрибут optimize не знает
+#if defined(__clang__)
+#define VECTOR_SIMD_VECTORIZE
+#else
+#define VECTOR_SIMD_VECTORIZE optimize("tree-vectorize")
+#endif
+
+// ---- SSE2 ----
+
+__attribute__((target("sse2"))) inline void fill_sse2(std::int32_t *data, std::size_t n,
+                                                      std::int32_t value) {
+  __m128i v = _mm_set1_epi32(value);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(data + i), v);
+  }
+  fill_scalar(data + i, n - i, value);
+}
+
+__attribute__((target("sse2"))) inline void fill_sse2(float *data, std::size_t n, float value) {
+  __m128 v = _mm_set1_ps(value);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(data + i, v);
+  }
+  fill_scalar(data + i, n - i, value);
+}
+
+__attribute__((target("sse2"))) inline int eq_mask_sse2(const std::int32_t *p, __m128i v) {
+  __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)), v);
+  return _mm_movemask_ps(_mm_castsi128_ps(eq));
+}
+
+__attribute__((target("sse2"))) inline int eq_mask_sse2(const float *p, __m128 v) {
+  return _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(p), v));
+}
+
+__attribute__((target("sse2"))) inline __m128i splat_sse2(std::int32_t value) {
+  return _mm_set1_epi32(value);
+}
+
+__attribute__((target("sse2"))) inline __m128 splat_sse2(float value) {
+  return _mm_set1_ps(value);
+}
+
+template <class T>
+__attribute__((target("sse2"))) std::size_t find_sse2(const T *data, std::size_t n, T value) {
+  auto v = splat_sse2(value);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    if (int mask = eq_mask_sse2(data + i, v)) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return i + find_scalar(data + i, n - i, value);
+}
+
+template <class T>
+__attribute__((target("sse2"))) std::size_t count_sse2(const T *data, std::size_t n, T value) {
+  auto v = splat_sse2(value);
+  std::size_t result = 0;
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    result += mask_bits[eq_mask_sse2(data + i, v)];
+  }
+  return result + count_scalar(data + i, n - i, value);
+}
+
+__attribute__((target("sse2"))) inline std::int32_t sum_sse2(const std::int32_t *data,
+                                                             std::size_t n) {
+  __m128i acc = _mm_setzero_si128();
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    acc = _mm_add_epi32(acc, _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i)));
+  }
+  alignas(16) std::int32_t lanes[4];
+  _mm_store_si128(reinterpret_cast<__m128i *>(lanes), acc);
+  return wrapping_add(sum_scalar(lanes, 4), sum_scalar(data + i, n - i));
+}
+
+__attribute__((target("sse2"))) inline float sum_sse2(const float *data, std::size_t n) {
+  __m128 acc = _mm_setzero_ps();
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    acc = _mm_add_ps(acc, _mm_loadu_ps(data + i));
+  }
+  alignas(16) float lanes[4];
+  _mm_store_ps(lanes, acc);
+  return sum_scalar(lanes, 4) + sum_scalar(data + i, n - i);
+}
+
+// В SSE2 нет _mm_min_epi32/_mm_max_epi32 (они из SSE4.1), поэтому через
+// сравнение и выбор по маске
+__attribute__((target("sse2"))) inline std::pair<std::int32_t, std::int32_t>
+minmax_sse2(const std::int32_t *data, std::size_t n) {
+  if (n < 4) {
+    return minmax_scalar(data, n);
+  }
+  __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+  __m128i hi = lo;
+  std::size_t i = 4;
+  for (; i + 4 <= n; i += 4) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    __m128i less = _mm_cmplt_epi32(x, lo);
+    lo = _mm_or_si128(_mm_and_si128(less, x), _mm_andnot_si128(less, lo));
+    __m128i greater = _mm_cmpgt_epi32(x, hi);
+    hi = _mm_or_si128(_mm_and_si128(greater, x), _mm_andnot_si128(greater, hi));
+  }
+  alignas(16) std::int32_t lanes_lo[4], lanes_hi[4];
+  _mm_store_si128(reinterpret_cast<__m128i *>(lanes_lo), lo);
+  _mm_store_si128(reinterpret_cast<__m128i *>(lanes_hi), hi);
+  std::pair<std::int32_t, std::int32_t> result{minmax_scalar(lanes_lo, 4).first,
+                                               minmax_scalar(lanes_hi, 4).second};
+  if (i < n) {
+    auto tail = minmax_scalar(data + i, n - i);
+    result.first = tail.first < result.first ? tail.first : result.first;
+    result.second = result.second < tail.second ? tail.second : result.second;
+  }
+  return result;
+}
+
+__attribute__((target("sse2"))) inline std::pair<float, float> minmax_sse2(const float *data,
+                                                                           std::size_t n) {
+  if (n < 4) {
+    return minmax_scalar(data, n);
+  }
+  __m128 lo = _mm_loadu_ps(data);
+  __m128 hi = lo;
+  std::size_t i = 4;
+  for (; i + 4 <= n; i += 4) {
+    __m128 x = _mm_loadu_ps(data + i);
+    lo = _mm_min_ps(lo, x);
+    hi = _mm_max_ps(hi, x);
+  }
+  alignas(16) float lanes_lo[4], lanes_hi[4];
+  _mm_store_ps(lanes_lo, lo);
+  _mm_store_ps(lanes_hi, hi);
+  std::pair<float, float> result{minmax_scalar(lanes_lo, 4).first,
+                                 minmax_scalar(lanes_hi, 4).second};
+  if (i < n) {
+    auto tail = minmax_scalar(data + i, n - i);
+    result.first = tail.first < result.first ? tail.first : result.first;
+    result.second = result.second < tail.second ? tail.second : result.second;
+  }
+  return result;
+}
+
+// transform_inplace принимает произвольную функцию, поэтому вместо ручных
+// интринсиков тот же цикл компилируется под SSE2/AVX2 и векторизуется
+// компилятором
+template <class T, class Op>
+__attribute__((target("sse2"), VECTOR_SIMD_VECTORIZE)) void
+transform_sse2(T *data, std::size_t n, Op &op) {
+  for (std::size_t i = 0; i < n; i++) {
+    data[i] = op(data[i]);
+  }
+}
+
+// ---- AVX2 ----
+
+__attribute__((target("avx2"))) inline void fill_avx2(std::int32_t *data, std::size_t n,
+                                                      std::int32_t value) {
+  __m256i v = _mm256_set1_epi32(value);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(data + i), v);
+  }
+  fill_scalar(data + i, n - i, value);
+}
+
+__attribute__((target("avx2"))) inline void fill_avx2(float *data, std::size_t n, float value) {
+  __m256 v = _mm256_set1_ps(value);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(data + i, v);
+  }
+  fill_scalar(data + i, n - i, value);
+}
+
+__attribute__((target("avx2"))) inline int eq_mask_avx2(const std::int32_t *p, __m256i v) {
+  __m256i eq =
+      _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)), v);
+  return _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+}
+
+__attribute__((target("avx2"))) inline int eq_mask_avx2(const float *p, __m256 v) {
+  return _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p), v, _CMP_EQ_OQ));
+}
+
+__attribute__((target("avx2"))) inline __m256i splat_avx2(std::int32_t value) {
+  return _mm256_set1_epi32(value);
+}
+
+__attribute__((target("avx2"))) inline __m256 splat_avx2(float value) {
+  return _mm256_set1_ps(value);
+}
+
+template <class T>
+__attribute__((target("avx2"))) std::size_t find_avx2(const T *data, std::size_t n, T value) {
+  auto v = splat_avx2(value);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    if (int mask = eq_mask_avx2(data + i, v)) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return i + find_scalar(data + i, n - i, value);
+}
+
+template <class T>
+__attribute__((target("avx2"))) std::size_t count_avx2(const T *data, std::size_t n, T value) {
+  auto v = splat_avx2(value);
+  std::size_t result = 0;
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    int mask = eq_mask_avx2(data + i, v);
+    result += mask_bits[mask & 15] + mask_bits[mask >> 4];
+  }
+  return result + count_scalar(data + i, n - i, value);
+}
+
+__attribute__((target("avx2"))) inline std::int32_t sum_avx2(const std::int32_t *data,
+                                                             std::size_t n) {
+  __m256i acc = _mm256_setzero_si256();
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    acc = _mm256_add_epi32(acc,
+                           _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)));
+  }
+  alignas(32) std::int32_t lanes[8];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+  return wrapping_add(sum_scalar(lanes, 8), sum_scalar(data + i, n - i));
+}
+
+__attribute__((target("avx2"))) inline float sum_avx2(const float *data, std::size_t n) {
+  __m256 acc = _mm256_setzero_ps();
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    acc = _mm256_add_ps(acc, _mm256_loadu_ps(data + i));
+  }
+  alignas(32) float lanes[8];
+  _mm256_store_ps(lanes, acc);
+  return sum_scalar(lanes, 8) + sum_scalar(data + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline std::pair<std::int32_t, std::int32_t>
+minmax_avx2(const std::int32_t *data, std::size_t n) {
+  if (n < 8) {
+    return minmax_scalar(data, n);
+  }
+  __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+  __m256i hi = lo;
+  std::size_t i = 8;
+  for (; i + 8 <= n; i += 8) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+    lo = _mm256_min_epi32(lo, x);
+    hi = _mm256_max_epi32(hi, x);
+  }
+  alignas(32) std::int32_t lanes_lo[8], lanes_hi[8];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes_lo), lo);
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes_hi), hi);
+  std::pair<std::int32_t, std::int32_t> result{minmax_scalar(lanes_lo, 8).first,
+                                               minmax_scalar(lanes_hi, 8).second};
+  if (i < n) {
+    auto tail = minmax_scalar(data + i, n - i);
+    result.first = tail.first < result.first ? tail.first : result.first;
+    result.second = result.second < tail.second ? tail.second : result.second;
+  }
+  return result;
+}
+
+__attribute__((target("avx2"))) inline std::pair<float, float> minmax_avx2(const float *data,
+                                                                           std::size_t n) {
+  if (n < 8) {
+    return minmax_scalar(data, n);
+  }
+  __m256 lo = _mm256_loadu_ps(data);
+  __m256 hi = lo;
+  std::size_t i = 8;
+  for (; i + 8 <= n; i += 8) {
+    __m256 x = _mm256_loadu_ps(data + i);
+    lo = _mm256_min_ps(lo, x);
+    hi = _mm256_max_ps(hi, x);
+  }
+  alignas(32) float lanes_lo[8], lanes_hi[8];
+  _mm256_store_ps(lanes_lo, lo);
+  _mm256_store_ps(lanes_hi, hi);
+  std::pair<float, float> result{minmax_scalar(lanes_lo, 8).first,
+                                 minmax_scalar(lanes_hi, 8).second};
+  if (i < n) {
+    auto tail = minmax_scalar(data + i, n - i);
+    result.first = tail.first < result.first ? tail.first : result.first;
+    result.second = result.second < tail.second ? tail.second : result.second;
+  }
+  return result;
+}
+
+template <class T, class Op>
+__attribute__((target("avx2"), VECTOR_SIMD_VECTORIZE)) void
+transform_avx2(T *data, std::size_t n, Op &op) {
+  for (std::size_t i = 0; i < n; i++) {
+    data[i] = op(data[i]);
+  }
+}
+
+#undef VECTOR_SIMD_VECTORIZE
+
+#endif // VECTOR_SIMD_X86
+
+// ---- выбор реализации по уровню ----
+// level передается явно, чтобы тесты и бенчмарки могли сравнить все версии
+
+template <class T> void fill(Level level, T *data, std::size_t n, T value) {
+#if VECTOR_SIMD_X86
+  if constexpr (has_kernels<T>) {
+    if (level == Level::AVX2) {
+      return fill_avx2(data, n, value);
+    }
+    if (level == Level::SSE2) {
+      return fill_sse2(data, n, value);
+    }
+  }
+#endif
+  fill_scalar(data, n, value);
+}
+
+template <class T> std::size_t find(Level level, const T *data, std::size_t n, T value) {
+#if VECTOR_SIMD_X86
+  if constexpr (has_kernels<T>) {
+    if (level == Level::AVX2) {
+      return find_avx2(data, n, value);
+    }
+    if (level == Level::SSE2) {
+      return find_sse2(data, n, value);
+    }
+  }
+#endif
+  return find_scalar(data, n, value);
+}
+
+template <class T> std::size_t count(Level level, const T *data, std::size_t n, T value) {
+#if VECTOR_SIMD_X86
+  if constexpr (has_kernels<T>) {
+    if (level == Level::AVX2) {
+      return count_avx2(data, n, value);
+    }
+    if (level == Level::SSE2) {
+      return count_sse2(data, n, value);
+    }
+  }
+#endif
+  return count_scalar(data, n, value);
+}
+
+template <class T> T sum(Level level, const T *data, std::size_t n) {
+#if VECTOR_SIMD_X86
+  if constexpr (has_kernels<T>) {
+    if (level == Level::AVX2) {
+      return sum_avx2(data, n);
+    }
+    if (level == Level::SSE2) {
+      return sum_sse2(data, n);
+    }
+  }
+#endif
+  return sum_scalar(data, n);
+}
+
+template <class T> std::pair<T, T> minmax(Level level, const T *data, std::size_t n) {
+  if (n == 0) {
+    throw std::out_of_range("error");
+  }
+#if VECTOR_SIMD_X86
+  if constexpr (has_kernels<T>) {
+    if (level == Level::AVX2) {
+      return minmax_avx2(data, n);
+    }
+    if (level == Level::SSE2) {
+      return minmax_sse2(data, n);
+    }
+  }
+#endif
+  return minmax_scalar(data, n);
+}
+
+template <class T, class Op> void transform_inplace(Level level, T *data, std::size_t n, Op &op) {
+#if VECTOR_SIMD_X86
+  if (level == Level::AVX2) {
+    return transform_avx2(data, n, op);
+  }
+  if (level == Level::SSE2) {
+    return transform_sse2(data, n, op);
+  }
+#endif
+  transform_scalar(data, n, op);
+}
+
+} // namespace detail
+
+// Уровень, выбранный для текущего процессора (определяется один раз)
+inline Level level() {
+  static const Level detected = detail::detect_level();
+  return detected;
+}
+
+// Заполняет вектор значением value
+template <class T, class Allocator, class BoundsCheck>
+void fill(Vector<T, Allocator, BoundsCheck> &v, T value) {
+  static_assert(std::is_arithmetic_v<T>, "simd kernels need arithmetic T");
+  detail::fill(level(), v.data(), v.size(), value);
+}
+
+// Возвращает индекс первого элемента равного value или v.size()
+template <class T, class Allocator, class BoundsCheck>
+std::size_t find(const Vector<T, Allocator, BoundsCheck> &v, T value) {
+  static_assert(std::is_arithmetic_v<T>, "simd kernels need arithmetic T");
+  return detail::find(level(), v.data(), v.size(), value);
+}
+
+// Возвращает количество элементов равных value
+template <class T, class Allocator, class BoundsCheck>
+std::size_t count(const Vector<T, Allocator, BoundsCheck> &v, T value) {
+  static_assert(std::is_arithmetic_v<T>, "simd kernels need arithmetic T");
+  return detail::count(level(), v.data(), v.size(), value);
+}
+
+// Возвращает сумму элементов
+template <class T, class Allocator, class BoundsCheck>
+T sum(const Vector<T, Allocator, BoundsCheck> &v) {
+  static_assert(std::is_arithmetic_v<T>, "simd kernels need arithmetic T");
+  return detail::sum(level(), v.data(), v.size());
+}
+
+// Возвращает {минимум, максимум}. Для пустого вектора бросает std::out_of_range
+template <class T, class Allocator, class BoundsCheck>
+std::pair<T, T> minmax(const Vector<T, Allocator, BoundsCheck> &v) {
+  static_assert(std::is_arithmetic_v<T>, "simd kernels need arithmetic T");
+  return detail::minmax(level(), v.data(), v.size());
+}
+
+// Заменяет каждый элемент x на op(x): simd::transform_inplace(v, [](float x) { return x * 2; });
+template <class T, class Allocator, class BoundsCheck, class Op>
+void transform_inplace(Vector<T, Allocator, BoundsCheck> &v, Op op) {
+  static_assert(std::is_arithmetic_v<T>, "simd kernels need arithmetic T");
+  detail::transform_inplace(level(), v.data(), v.size(), op);
+}
+
+} // namespace simd
+
+#endif
@@ -1 +1,11 @@
-int main() {}
+#include "vector.hpp"
+#include "small_vector.hpp"
+#include "mmap_vector.hpp"
+
+// Явная инстанциация проверяет, что все методы Vector, SmallVector и
+// MmapVector компилируются
+template class Vector<int>;
+template class SmallVector<int, 8>;
+template class MmapVector<int>;
+
+int main() {}
\ No newline at end of file
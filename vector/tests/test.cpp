@@ -0,0 +1,782 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <new>
+#include <numeric>
+#include <sstream>
+#include <ranges>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <string>
+
+#include "vector.hpp"
+#include "small_vector.hpp"
+#include "vector_simd.hpp"
+#include "mmap_vector.hpp"
+
+// Считает выделения памяти в куче
+static std::size_t allocations = 0;
+
+void *operator new(std::size_t size) {
+  ++allocations;
+  if (void *ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+// Считает живые объекты, чтобы проверить что каждый созданный элемент
+// ровно один раз уничтожается
+struct Counted {
+  static inline int alive = 0;
+  int value{};
+
+  Counted() { ++alive; }
+  Counted(int value) : value{value} { ++alive; }
+  Counted(const Counted &other) : value{other.value} { ++alive; }
+  Counted(Counted &&other) noexcept : value{other.value} { ++alive; }
+  Counted &operator=(const Counted &other) = default;
+  ~Counted() { --alive; }
+};
+
+void test_default_constructor() {
+  Vector<int> v;
+  assert(v.size() == 0);
+  assert(v.empty());
+  assert(v.capacity() == 0);
+}
+
+void test_size_constructor() {
+  Vector<int> v(5);
+  assert(v.size() == 5);
+  for (std::size_t i = 0; i < v.size(); i++) {
+    assert(v[i] == 0);
+  }
+}
+
+void test_push_back() {
+  Vector<int> v;
+  for (int i = 0; i < 100; i++) {
+    v.push_back(i);
+  }
+  assert(v.size() == 100);
+  for (int i = 0; i < 100; i++) {
+    assert(v[i] == i);
+  }
+}
+
+void test_push_back_self_reference() {
+  Vector<std::string> v;
+  v.push_back("first");
+  while (v.size() != v.capacity()) {
+    v.push_back("filler");
+  }
+  v.push_back(v[0]);
+  assert(v[v.size() - 1] == "first");
+}
+
+void test_emplace_back() {
+  Vector<std::string> v;
+  std::string &s = v.emplace_back(3, 'a');
+  assert(s == "aaa");
+  assert(v.size() == 1);
+}
+
+void test_pop_back() {
+  Vector<std::string> v;
+  v.push_back("one");
+  v.push_back("two");
+  assert(v.pop_back() == "two");
+  assert(v.size() == 1);
+}
+
+void test_reserve() {
+  Vector<int> v;
+  v.reserve(50);
+  assert(v.capacity() == 50);
+  assert(v.size() == 0);
+  const int *data = v.data();
+  for (int i = 0; i < 50; i++) {
+    v.push_back(i);
+  }
+  assert(v.data() == data);
+}
+
+void test_shrink_to_fit() {
+  Vector<int> v;
+  v.reserve(50);
+  v.push_back(1);
+  v.push_back(2);
+  v.shrink_to_fit();
+  assert(v.capacity() == 2);
+  assert(v[0] == 1 && v[1] == 2);
+}
+
+void test_resize() {
+  Vector<int> v;
+  v.push_back(1);
+  v.push_back(2);
+  v.push_back(3);
+  v.resize(5);
+  assert(v.size() == 5);
+  assert(v[2] == 3 && v[3] == 0 && v[4] == 0);
+  v.resize(1);
+  assert(v.size() == 1);
+  assert(v[0] == 1);
+  v.resize(3, 7);
+  assert(v[1] == 7 && v[2] == 7);
+}
+
+void test_copy_and_move() {
+  Vector<std::string> v;
+  v.push_back("a");
+  v.push_back("b");
+  Vector<std::string> copied{v};
+  assert(copied.size() == 2 && copied[1] == "b");
+  Vector<std::string> moved{std::move(copied)};
+  assert(moved.size() == 2 && moved[0] == "a");
+  assert(copied.size() == 0);
+}
+
+// polymorphic_allocator не переходит при присваивании: вектор остается со
+// своим ресурсом памяти, а при чужом ресурсе элементы копируются или
+// перемещаются к себе по одному
+void test_allocator_not_propagated() {
+  using Alloc = std::pmr::polymorphic_allocator<std::string>;
+  std::pmr::monotonic_buffer_resource first;
+  std::pmr::monotonic_buffer_resource second;
+  Vector<std::string, Alloc> source{Alloc{&first}};
+  source.push_back("a");
+  source.push_back("b");
+
+  Vector<std::string, Alloc> copied{Alloc{&second}};
+  copied = source;
+  assert(copied.get_allocator().resource() == &second);
+  assert(copied.size() == 2 && copied[1] == "b" && source.size() == 2);
+
+  Vector<std::string, Alloc> moved{Alloc{&second}};
+  const std::string *old_data = source.data();
+  moved = std::move(source);
+  assert(moved.get_allocator().resource() == &second);
+  assert(moved.size() == 2 && moved[0] == "a" && moved.data() != old_data);
+
+  // С тем же ресурсом память забирается целиком
+  Vector<std::string, Alloc> same{Alloc{&second}};
+  old_data = moved.data();
+  same = std::move(moved);
+  assert(same.data() == old_data && moved.empty());
+}
+
+void test_lifetime() {
+  {
+    Vector<Counted> v;
+    for (int i = 0; i < 33; i++) {
+      v.emplace_back(i);
+    }
+    assert(Counted::alive == 33);
+    v.pop_back();
+    assert(Counted::alive == 32);
+    v.resize(10);
+    assert(Counted::alive == 10);
+    v.shrink_to_fit();
+    assert(Counted::alive == 10);
+    v.clear();
+    assert(Counted::alive == 0);
+    v.resize(4);
+    assert(Counted::alive == 4);
+  }
+  assert(Counted::alive == 0);
+}
+
+void test_insert_erase() {
+  Vector<int> v;
+  v.push_back(1);
+  v.push_back(2);
+  v.push_back(3);
+  v.insert(1, 42);
+  assert(v.size() == 4 && v[1] == 42 && v[2] == 2);
+  assert(v.erase(1) == 42);
+  assert(v.size() == 3 && v[1] == 2);
+}
+
+void test_insert_count() {
+  Vector<int> v;
+  v.push_back(1);
+  v.push_back(2);
+  v.push_back(3);
+  v.insert(1, 2, 42);
+  assert(v.size() == 5);
+  assert(v[0] == 1 && v[1] == 42 && v[2] == 42 && v[3] == 2 && v[4] == 3);
+  v.reserve(20);
+  v.insert(5, 3, v[0]);
+  assert(v.size() == 8 && v[7] == 1);
+}
+
+void test_insert_range() {
+  Vector<std::string> v;
+  v.push_back("a");
+  v.push_back("d");
+  std::string middle[] = {"b", "c"};
+  v.insert(1, std::begin(middle), std::end(middle));
+  assert(v.size() == 4);
+  assert(v[0] == "a" && v[1] == "b" && v[2] == "c" && v[3] == "d");
+  v.reserve(10);
+  v.insert(0, std::begin(middle), std::end(middle));
+  assert(v.size() == 6 && v[0] == "b" && v[2] == "a" && v[5] == "d");
+}
+
+void test_insert_out_of_range() {
+  Vector<int> v;
+  bool exception_thrown{};
+  try {
+    v.insert(1, 42);
+  } catch (std::out_of_range) {
+    exception_thrown = true;
+  }
+  assert(exception_thrown);
+}
+
+void test_erase_range() {
+  Vector<std::string> v;
+  for (int i = 0; i < 6; i++) {
+    v.push_back(std::to_string(i));
+  }
+  v.erase(1, 4);
+  assert(v.size() == 3);
+  assert(v[0] == "0" && v[1] == "4" && v[2] == "5");
+  v.erase(0, 0);
+  assert(v.size() == 3);
+  v.erase(0, 3);
+  assert(v.empty());
+}
+
+void test_insert_erase_lifetime() {
+  {
+    Vector<Counted> v;
+    for (int i = 0; i < 5; i++) {
+      v.emplace_back(i);
+    }
+    v.insert(2, 10, Counted{7});
+    assert(Counted::alive == 15);
+    v.reserve(40);
+    v.insert(0, 3, Counted{1});
+    assert(Counted::alive == 18);
+    v.erase(1, 11);
+    assert(Counted::alive == 8);
+    v.erase(0);
+    assert(Counted::alive == 7);
+  }
+  assert(Counted::alive == 0);
+}
+
+static_assert(std::ranges::contiguous_range<Vector<int>>);
+static_assert(std::ranges::contiguous_range<const Vector<int>>);
+static_assert(std::ranges::sized_range<Vector<int>>);
+
+void test_iterators() {
+  Vector<int> v;
+  for (int i = 0; i < 5; i++) {
+    v.push_back(i);
+  }
+  int expected = 0;
+  for (int x : v) {
+    assert(x == expected++);
+  }
+  assert(v.end() - v.begin() == 5);
+  assert(*(v.begin() + 2) == 2);
+  assert(v.begin()[4] == 4);
+  assert(v.begin() < v.end());
+  assert(&*v.begin() == v.data());
+
+  for (auto &x : v) {
+    x *= 10;
+  }
+  assert(v[3] == 30);
+}
+
+void test_const_iterators() {
+  Vector<int> v;
+  v.push_back(1);
+  v.push_back(2);
+  const Vector<int> &ref = v;
+  Vector<int>::ConstIterator it = v.begin();
+  assert(it == ref.begin());
+  assert(v.cbegin() == v.begin());
+  assert(std::accumulate(ref.begin(), ref.end(), 0) == 3);
+}
+
+void test_reverse_iterators() {
+  Vector<int> v;
+  for (int i = 0; i < 4; i++) {
+    v.push_back(i);
+  }
+  int expected = 3;
+  for (auto it = v.rbegin(); it != v.rend(); ++it) {
+    assert(*it == expected--);
+  }
+  assert(*v.crbegin() == 3);
+}
+
+void test_std_algorithms() {
+  Vector<int> v;
+  for (int x : {5, 3, 9, 1, 7}) {
+    v.push_back(x);
+  }
+  std::sort(v.begin(), v.end());
+  assert(std::is_sorted(v.begin(), v.end()));
+  std::transform(v.begin(), v.end(), v.begin(), [](int x) { return x * 2; });
+  assert(v[0] == 2 && v[4] == 18);
+  std::ranges::reverse(v);
+  assert(v[0] == 18);
+  assert(std::ranges::data(v) == v.data());
+  assert(std::ranges::find(v, 6) == v.begin() + 3);
+}
+
+void test_operator_brackets_out_of_range() {
+  Vector<int> v(3);
+  bool exception_thrown{};
+  try {
+    v[3] = 1;
+  } catch (std::out_of_range) {
+    exception_thrown = true;
+  }
+  assert(exception_thrown);
+}
+
+void test_at() {
+  Vector<int, std::allocator<int>, bounds_check::Unchecked> v(3);
+  v[1] = 5;
+  assert(v.at(1) == 5);
+  bool exception_thrown{};
+  try {
+    v.at(3);
+  } catch (std::out_of_range) {
+    exception_thrown = true;
+  }
+  assert(exception_thrown);
+}
+
+void test_const_operator_brackets_returns_reference() {
+  Vector<std::string> v;
+  v.push_back("text");
+  const Vector<std::string> &ref = v;
+  static_assert(std::is_same_v<decltype(ref[0]), const std::string &>);
+  assert(&ref[0] == v.data());
+  assert(&ref.at(0) == v.data());
+}
+
+void test_small_vector_no_allocations_inline() {
+  std::size_t before = allocations;
+  {
+    SmallVector<int, 16> v;
+    for (int i = 0; i < 16; i++) {
+      v.push_back(i);
+    }
+    v.erase(0);
+    v.insert(3, 42);
+    assert(v.size() == 16);
+    assert(v[3] == 42 && v[4] == 4);
+    assert(v.is_inline());
+  }
+  assert(allocations == before);
+}
+
+void test_small_vector_spill() {
+  SmallVector<std::string, 4> v;
+  for (int i = 0; i < 4; i++) {
+    v.push_back(std::to_string(i));
+  }
+  assert(v.is_inline());
+  std::size_t before = allocations;
+  v.push_back(v[0]);
+  assert(allocations > before);
+  assert(!v.is_inline());
+  assert(v.size() == 5);
+  assert(v[0] == "0" && v[3] == "3" && v[4] == "0");
+}
+
+void test_small_vector_insert_erase() {
+  SmallVector<int, 4> v;
+  v.push_back(1);
+  v.push_back(2);
+  v.push_back(3);
+  v.insert(1, 42);
+  assert(v.size() == 4 && v[1] == 42 && v[3] == 3);
+  v.insert(0, 7);
+  assert(!v.is_inline());
+  assert(v[0] == 7 && v[2] == 42 && v[4] == 3);
+  assert(v.erase(2) == 42);
+  assert(v.size() == 4 && v[2] == 2);
+}
+
+void test_small_vector_insert_out_of_range() {
+  SmallVector<int, 4> empty;
+  bool exception_thrown{};
+  try {
+    empty.insert(3, 1);
+  } catch (const std::out_of_range &) {
+    exception_thrown = true;
+  }
+  assert(exception_thrown && empty.size() == 0);
+
+  // Полный встроенный буфер не переезжает в кучу из-за неудачной вставки
+  SmallVector<int, 4> full;
+  for (int i = 0; i < 4; i++) {
+    full.push_back(i);
+  }
+  exception_thrown = false;
+  try {
+    full.insert(5, 42);
+  } catch (const std::out_of_range &) {
+    exception_thrown = true;
+  }
+  assert(exception_thrown && full.is_inline() && full.size() == 4 && full[3] == 3);
+}
+
+void test_small_vector_copy_and_move() {
+  SmallVector<std::string, 2> small;
+  small.push_back("a");
+  SmallVector<std::string, 2> big;
+  for (int i = 0; i < 5; i++) {
+    big.push_back(std::to_string(i));
+  }
+
+  SmallVector<std::string, 2> copied{small};
+  assert(copied.is_inline() && copied[0] == "a");
+  copied = big;
+  assert(copied.size() == 5 && copied[4] == "4");
+
+  const std::string *heap_data = big.data();
+  SmallVector<std::string, 2> moved{std::move(big)};
+  assert(moved.data() == heap_data);
+  assert(big.size() == 0);
+
+  moved = std::move(small);
+  assert(moved.is_inline() && moved.size() == 1 && moved[0] == "a");
+}
+
+void test_small_vector_lifetime() {
+  {
+    SmallVector<Counted, 8> v;
+    for (int i = 0; i < 8; i++) {
+      v.emplace_back(i);
+    }
+    assert(Counted::alive == 8);
+    v.pop_back();
+    assert(Counted::alive == 7);
+    for (int i = 0; i < 10; i++) {
+      v.emplace_back(i);
+    }
+    assert(Counted::alive == 17);
+  }
+  assert(Counted::alive == 0);
+}
+
+// Каждое ядро на каждом поддерживаемом уровне сравнивается со
+// стандартным алгоритмом. Размеры подобраны так, чтобы проверить хвосты
+// короче одного SIMD-регистра
+template <class T>
+void check_simd_kernels() {
+  const simd::Level levels[] = {simd::Level::Scalar, simd::Level::SSE2, simd::Level::AVX2};
+  for (simd::Level level : levels) {
+    if (level > simd::level()) {
+      break;
+    }
+    for (std::size_t n : {0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 33, 100}) {
+      Vector<T> v(n);
+      for (std::size_t i = 0; i < n; i++) {
+        v[i] = static_cast<T>((i * 7) % 11) - static_cast<T>(5);
+      }
+      T *data = v.data();
+
+      for (T value : {static_cast<T>(-5), static_cast<T>(0), static_cast<T>(42)}) {
+        std::size_t expected_find = std::find(v.begin(), v.end(), value) - v.begin();
+        assert(simd::detail::find(level, data, n, value) == expected_find);
+        assert(simd::detail::count(level, data, n, value) ==
+               static_cast<std::size_t>(std::count(v.begin(), v.end(), value)));
+      }
+
+      assert(simd::detail::sum(level, data, n) == std::accumulate(v.begin(), v.end(), T{}));
+
+      if (n == 0) {
+        bool thrown = false;
+        try {
+          simd::detail::minmax(level, data, n);
+        } catch (const std::out_of_range &) {
+          thrown = true;
+        }
+        assert(thrown);
+      } else {
+        auto expected = std::minmax_element(v.begin(), v.end());
+        auto result = simd::detail::minmax(level, data, n);
+        assert(result.first == *expected.first && result.second == *expected.second);
+      }
+
+      auto op = [](T x) { return static_cast<T>(x * 2 + 1); };
+      Vector<T> expected_transform = v;
+      std::transform(expected_transform.begin(), expected_transform.end(),
+                     expected_transform.begin(), op);
+      simd::detail::transform_inplace(level, data, n, op);
+      assert(std::equal(v.begin(), v.end(), expected_transform.begin()));
+
+      simd::detail::fill(level, data, n, static_cast<T>(3));
+      assert(std::all_of(v.begin(), v.end(), [](T x) { return x == static_cast<T>(3); }));
+    }
+  }
+}
+
+void test_simd_kernels() {
+  check_simd_kernels<std::int32_t>();
+  check_simd_kernels<float>();
+  // Типы без отдельных ядер идут через скалярный цикл
+  check_simd_kernels<double>();
+  check_simd_kernels<std::int64_t>();
+}
+
+void test_simd_vector_api() {
+  Vector<std::int32_t> v(20);
+  simd::fill(v, 1);
+  v[13] = 5;
+  v[17] = -4;
+  assert(simd::find(v, 5) == 13);
+  assert(simd::find(v, 6) == v.size());
+  assert(simd::count(v, 1) == 18);
+  assert(simd::sum(v) == 18 + 5 - 4);
+  assert(simd::minmax(v) == std::make_pair(-4, 5));
+  simd::transform_inplace(v, [](std::int32_t x) { return -x; });
+  assert(simd::minmax(v) == std::make_pair(-5, 4));
+
+  // Целочисленная сумма переполняется по модулю 2^32
+  Vector<std::int32_t> big(9);
+  simd::fill(big, std::numeric_limits<std::int32_t>::max());
+  std::uint32_t expected = 0;
+  for (std::int32_t x : big) {
+    expected += static_cast<std::uint32_t>(x);
+  }
+  assert(simd::sum(big) == static_cast<std::int32_t>(expected));
+  // Переполнение при сложении векторной части с хвостом
+  Vector<std::int32_t> edge(9);
+  simd::fill(edge, 0);
+  edge[0] = std::numeric_limits<std::int32_t>::max();
+  edge[8] = 1;
+  assert(simd::sum(edge) == std::numeric_limits<std::int32_t>::min());
+}
+
+struct Record {
+  std::int64_t id;
+  double value;
+};
+
+std::string mmap_test_path() {
+  return (std::filesystem::temp_directory_path() / "mmap_vector_test.bin").string();
+}
+
+void test_mmap_vector_push_back_and_reopen() {
+  const std::string path = mmap_test_path();
+  {
+    MmapVector<Record> v(path);
+    assert(v.empty() && v.data() == nullptr);
+    for (int i = 0; i < 1000; i++) {
+      v.push_back({i, i * 0.5});
+    }
+    assert(v.size() == 1000 && v.capacity() >= 1000);
+    assert(v[999].id == 999 && v.at(10).value == 5.0);
+    v.emplace_back(Record{-1, -1.0});
+    assert(v.pop_back().id == -1);
+    v.flush();
+  }
+  // Файл обрезан до size() элементов
+  assert(std::filesystem::file_size(path) == 1000 * sizeof(Record));
+  {
+    MmapVector<Record> v(path, MmapVector<Record>::Mode::ReadWrite);
+    assert(v.size() == 1000 && v[500].id == 500);
+    v[500].value = 42.0;
+    v.insert(0, {7, 7.0});
+    assert(v.erase(1).id == 0);
+    v.resize(2000);
+    assert(v.size() == 2000 && v[1999].id == 0);
+    v.resize(1000);
+  }
+  {
+    const MmapVector<Record> v(path, MmapVector<Record>::Mode::ReadOnly);
+    assert(v.size() == 1000 && v[0].id == 7 && v[1].id == 1 && v[500].value == 42.0);
+    std::int64_t sum = 0;
+    for (const Record &r : v) {
+      sum += r.id;
+    }
+    assert(sum == 7 + 999 * 1000 / 2);
+  }
+  std::filesystem::remove(path);
+}
+
+void test_mmap_vector_read_only() {
+  const std::string path = mmap_test_path();
+  {
+    MmapVector<int> v(path);
+    v.resize(10, 3);
+  }
+  MmapVector<int> v(path, MmapVector<int>::Mode::ReadOnly);
+  assert(v.read_only() && v.size() == 10 && v[9] == 3);
+  v.advise(MmapVector<int>::Advice::Sequential);
+  bool thrown = false;
+  try {
+    v.push_back(1);
+  } catch (const std::logic_error &) {
+    thrown = true;
+  }
+  assert(thrown && v.size() == 10);
+
+  thrown = false;
+  try {
+    MmapVector<int> missing(path + ".missing", MmapVector<int>::Mode::ReadOnly);
+  } catch (const std::system_error &) {
+    thrown = true;
+  }
+  assert(thrown);
+  std::filesystem::remove(path);
+}
+
+void test_mmap_vector_move_and_shrink() {
+  const std::string path = mmap_test_path();
+  MmapVector<int> v(path);
+  for (int i = 0; i < 5000; i++) {
+    v.push_back(i);
+  }
+  MmapVector<int> moved{std::move(v)};
+  assert(v.size() == 0 && v.data() == nullptr);
+  assert(moved.size() == 5000 && moved[4999] == 4999);
+  moved.shrink_to_fit();
+  assert(moved.capacity() == 5000);
+  assert(std::filesystem::file_size(path) == 5000 * sizeof(int));
+  assert(std::accumulate(moved.begin(), moved.end(), 0LL) == 4999LL * 5000 / 2);
+  moved.clear();
+  moved.shrink_to_fit();
+  assert(moved.capacity() == 0 && moved.data() == nullptr);
+  std::filesystem::remove(path);
+}
+
+void test_save_load() {
+  Vector<std::int32_t> v;
+  for (std::int32_t i = 0; i < 1000; i++) {
+    v.push_back(i * 3);
+  }
+  std::stringstream stream;
+  v.save(stream);
+
+  Vector<std::int32_t> loaded(5);
+  loaded.load(stream);
+  assert(loaded.size() == 1000 && loaded.capacity() == 1000);
+  assert(std::equal(v.begin(), v.end(), loaded.begin()));
+
+  std::stringstream empty_stream;
+  Vector<std::int32_t>().save(empty_stream);
+  loaded.load(empty_stream);
+  assert(loaded.empty());
+}
+
+void test_load_rejects_bad_snapshot() {
+  Vector<std::int32_t> v(3);
+  std::stringstream stream;
+  v.save(stream);
+
+  // Другой тип элементов
+  Vector<std::int64_t> other(2);
+  bool thrown = false;
+  try {
+    other.load(stream);
+  } catch (const snapshot::Error &) {
+    thrown = true;
+  }
+  assert(thrown && other.size() == 2);
+
+  // Обрезанный поток
+  std::string bytes = stream.str();
+  std::stringstream truncated(bytes.substr(0, bytes.size() - 1));
+  Vector<std::int32_t> target(2);
+  thrown = false;
+  try {
+    target.load(truncated);
+  } catch (const snapshot::Error &) {
+    thrown = true;
+  }
+  assert(thrown && target.size() == 2);
+}
+
+void test_load_rejects_huge_size() {
+  Vector<std::int32_t> v(10);
+  std::stringstream stream;
+  v.save(stream);
+  std::string bytes = stream.str();
+  // Размер идет сразу после 16 байт заголовка
+  std::uint64_t size = std::uint64_t{1} << 60;
+  std::memcpy(&bytes[16], &size, sizeof(size));
+  std::stringstream corrupt(bytes);
+  Vector<std::int32_t> loaded(3);
+  bool exception_thrown{};
+  try {
+    loaded.load(corrupt);
+  } catch (const snapshot::Error &) {
+    exception_thrown = true;
+  }
+  assert(exception_thrown && loaded.size() == 3);
+}
+
+int main() {
+  test_default_constructor();
+  test_size_constructor();
+
+  test_push_back();
+  test_push_back_self_reference();
+  test_emplace_back();
+  test_pop_back();
+
+  test_reserve();
+  test_shrink_to_fit();
+  test_resize();
+
+  test_copy_and_move();
+  test_allocator_not_propagated();
+  test_lifetime();
+
+  test_insert_erase();
+  test_insert_count();
+  test_insert_range();
+  test_insert_out_of_range();
+  test_erase_range();
+  test_insert_erase_lifetime();
+
+  test_iterators();
+  test_const_iterators();
+  test_reverse_iterators();
+  test_std_algorithms();
+
+  test_operator_brackets_out_of_range();
+  test_at();
+  test_const_operator_brackets_returns_reference();
+
+  test_small_vector_no_allocations_inline();
+  test_small_vector_spill();
+  test_small_vector_insert_erase();
+  test_small_vector_insert_out_of_range();
+  test_small_vector_copy_and_move();
+  test_small_vector_lifetime();
+
+  test_simd_kernels();
+  test_simd_vector_api();
+
+  test_mmap_vector_push_back_and_reopen();
+  test_mmap_vector_read_only();
+  test_mmap_vector_move_and_shrink();
+
+  test_save_load();
+  test_load_rejects_bad_snapshot();
+  test_load_rejects_huge_size();
+}